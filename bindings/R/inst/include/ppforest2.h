@@ -11,6 +11,12 @@ using namespace ppforest2::pp;
 constexpr char const* CLASS_PPRF = "pprf";
 constexpr char const* CLASS_PPTR = "pptr";
 
+// Read-only models passed into exported functions. Converting from R
+// reuses the native model cached on the list when there is one, instead
+// of rebuilding it (see `native::lookup`).
+using TreeHandle   = std::shared_ptr<Tree const>;
+using ForestHandle = std::shared_ptr<Forest const>;
+
 // Index conversion helpers: C++ uses 0-based indices, R uses 1-based.
 inline Outcome to_r_index(Outcome i) {
   return i + 1;
@@ -46,12 +52,105 @@ namespace Rcpp {
   template<> Forest::Ptr as(SEXP);
 
   template<> Model::Ptr as(SEXP);
+  template<> TreeHandle as(SEXP);
+  template<> ForestHandle as(SEXP);
   template<> TrainingSpec::Ptr as(SEXP);
 }
 
 
 #include <Rcpp.h>
 
+// Native model handle kept in a model's `.cache` environment.
+//
+// Rebuilding a Forest from its R list walks every node of every tree, so
+// the C++ model a list was wrapped from is kept behind an external pointer
+// and reused by later calls, together with its compiled form
+// (`Model::compiled`), so repeated predict() calls flatten the trees only
+// once. The handle also records the list elements it describes
+// (`training_spec` and each tree's `root` / `sample_indices`).
+// R copies an element when it is modified, so a model edited from R no
+// longer matches its handle and is rebuilt. Fields the C++ side never
+// reads (e.g. `groups`) can change freely. After saveRDS/readRDS the
+// pointer is NULL, so the model is rebuilt once and cached again.
+namespace native {
+  constexpr char const* CACHE_KEY = "native_model";
+
+  inline SEXP element(Rcpp::List const& list, char const* name) {
+    return list.containsElementNamed(name) ? static_cast<SEXP>(list[name]) : R_NilValue;
+  }
+
+  // The list elements a model is rebuilt from, compared by identity.
+  inline Rcpp::List source_of(Rcpp::List const& model) {
+    std::vector<SEXP> parts;
+    parts.push_back(element(model, "training_spec"));
+
+    if (model.containsElementNamed("trees")) {
+      Rcpp::List const trees(element(model, "trees"));
+
+      for (R_xlen_t i = 0; i < trees.size(); ++i) {
+        Rcpp::List const tree(VECTOR_ELT(trees, i));
+        parts.push_back(element(tree, "root"));
+        parts.push_back(element(tree, "sample_indices"));
+      }
+    } else {
+      parts.push_back(element(model, "root"));
+    }
+
+    Rcpp::List source(parts.size());
+
+    for (std::size_t i = 0; i < parts.size(); ++i) {
+      SET_VECTOR_ELT(source, static_cast<R_xlen_t>(i), parts[i]);
+    }
+
+    return source;
+  }
+
+  inline bool same_source(Rcpp::List const& a, Rcpp::List const& b) {
+    if (a.size() != b.size()) {
+      return false;
+    }
+
+    for (R_xlen_t i = 0; i < a.size(); ++i) {
+      if (VECTOR_ELT(a, i) != VECTOR_ELT(b, i)) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  // The model's `.cache` environment, or NULL for models assembled by hand.
+  inline SEXP cache_of(Rcpp::List const& model) {
+    SEXP cache = element(model, ".cache");
+    return TYPEOF(cache) == ENVSXP ? cache : R_NilValue;
+  }
+
+  inline Model::Ptr lookup(Rcpp::List const& model) {
+    SEXP cache = cache_of(model);
+
+    if (Rf_isNull(cache)) {
+      return nullptr;
+    }
+
+    SEXP handle = Rf_findVarInFrame(cache, Rf_install(CACHE_KEY));
+
+    if (TYPEOF(handle) != EXTPTRSXP || R_ExternalPtrAddr(handle) == nullptr) {
+      return nullptr;
+    }
+
+    if (!same_source(Rcpp::List(R_ExternalPtrProtected(handle)), source_of(model))) {
+      return nullptr;
+    }
+
+    return *static_cast<Model::Ptr*>(R_ExternalPtrAddr(handle));
+  }
+
+  inline void store(SEXP cache, Rcpp::List const& model, Model::Ptr const& ptr) {
+    Rcpp::XPtr<Model::Ptr> handle(new Model::Ptr(ptr), true, R_NilValue, source_of(model));
+    Rf_defineVar(Rf_install(CACHE_KEY), handle, cache);
+  }
+}
+
 namespace Rcpp {
   inline SEXP wrap(TreeNode const& node) {
     struct NodeWrapper : public TreeNode::Visitor {
@@ -112,7 +211,7 @@ namespace Rcpp {
     Rcpp::List result = Rcpp::List::create(
         Rcpp::Named("training_spec")  = Rcpp::wrap(*tree.model->training_spec),
         Rcpp::Named("root")           = Rcpp::wrap(*tree.model->root),
-        Rcpp::Named("sample_indices") = Rcpp::wrap(tree.sample_indices)
+        Rcpp::Named("sample_indices") = Rcpp::wrap(tree.sample())
     );
     result.attr("class") = CLASS_PPTR;
     return result;
@@ -143,7 +242,16 @@ namespace Rcpp {
 
     WrapVisitor visitor;
     model->accept(visitor);
-    return visitor.result;
+
+    // Attach a cache that already holds this model, so the first call
+    // back into C++ does not have to rebuild it from the list.
+    Rcpp::List result(visitor.result);
+    Rcpp::RObject const cls = result.attr("class");
+    Rcpp::Environment cache = Rcpp::Environment::empty_env().new_child(true);
+    native::store(cache, result, model);
+    result[".cache"]     = cache;
+    result.attr("class") = cls;
+    return result;
   }
 
   inline SEXP wrap(Export<Model::Ptr> const& e) {
@@ -404,10 +512,43 @@ namespace Rcpp {
   }
 
   template<> inline Model::Ptr as(SEXP x) {
-    if (Rcpp::RObject(x).inherits(CLASS_PPRF)) {
-      return std::shared_ptr<Forest>(as<Forest::Ptr>(x).release());
+    Rcpp::List const rmodel(x);
+
+    if (Model::Ptr cached = native::lookup(rmodel)) {
+      return cached;
     }
-    return std::shared_ptr<Tree>(as<Tree::Ptr>(x).release());
+
+    Model::Ptr model = Rcpp::RObject(x).inherits(CLASS_PPRF)
+                           ? static_cast<Model::Ptr>(std::shared_ptr<Forest>(as<Forest::Ptr>(x).release()))
+                           : static_cast<Model::Ptr>(std::shared_ptr<Tree>(as<Tree::Ptr>(x).release()));
+
+    SEXP cache = native::cache_of(rmodel);
+
+    if (!Rf_isNull(cache)) {
+      native::store(cache, rmodel, model);
+    }
+
+    return model;
+  }
+
+  template<> inline ForestHandle as(SEXP x) {
+    auto forest = std::dynamic_pointer_cast<Forest const>(as<Model::Ptr>(x));
+
+    if (!forest) {
+      Rcpp::stop("expected a pprf model");
+    }
+
+    return forest;
+  }
+
+  template<> inline TreeHandle as(SEXP x) {
+    auto tree = std::dynamic_pointer_cast<Tree const>(as<Model::Ptr>(x));
+
+    if (!tree) {
+      Rcpp::stop("expected a pptr model");
+    }
+
+    return tree;
   }
 
   /**
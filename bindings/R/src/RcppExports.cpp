@@ -23,110 +23,110 @@ BEGIN_RCPP
 END_RCPP
 }
 // ppforest2_train
-Model::Ptr ppforest2_train(TrainingSpec::Ptr spec, FeatureMatrix x, OutcomeVector y);
+Model::Ptr ppforest2_train(TrainingSpec::Ptr spec, Eigen::Map<Eigen::MatrixXd> x, OutcomeVector y);
 RcppExport SEXP _ppforest2_ppforest2_train(SEXP specSEXP, SEXP xSEXP, SEXP ySEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< TrainingSpec::Ptr >::type spec(specSEXP);
-    Rcpp::traits::input_parameter< FeatureMatrix >::type x(xSEXP);
+    Rcpp::traits::input_parameter< Eigen::Map<Eigen::MatrixXd> >::type x(xSEXP);
     Rcpp::traits::input_parameter< OutcomeVector >::type y(ySEXP);
     rcpp_result_gen = Rcpp::wrap(ppforest2_train(spec, x, y));
     return rcpp_result_gen;
 END_RCPP
 }
 // ppforest2_train_regression
-Model::Ptr ppforest2_train_regression(TrainingSpec::Ptr spec, FeatureMatrix x, OutcomeVector y);
+Model::Ptr ppforest2_train_regression(TrainingSpec::Ptr spec, Eigen::Map<Eigen::MatrixXd> x, OutcomeVector y);
 RcppExport SEXP _ppforest2_ppforest2_train_regression(SEXP specSEXP, SEXP xSEXP, SEXP ySEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< TrainingSpec::Ptr >::type spec(specSEXP);
-    Rcpp::traits::input_parameter< FeatureMatrix >::type x(xSEXP);
+    Rcpp::traits::input_parameter< Eigen::Map<Eigen::MatrixXd> >::type x(xSEXP);
     Rcpp::traits::input_parameter< OutcomeVector >::type y(ySEXP);
     rcpp_result_gen = Rcpp::wrap(ppforest2_train_regression(spec, x, y));
     return rcpp_result_gen;
 END_RCPP
 }
 // ppforest2_predict_tree
-OutcomeVector ppforest2_predict_tree(Tree::Ptr const& tree, FeatureMatrix const& data);
+OutcomeVector ppforest2_predict_tree(TreeHandle const& tree, Eigen::Map<Eigen::MatrixXd> data);
 RcppExport SEXP _ppforest2_ppforest2_predict_tree(SEXP treeSEXP, SEXP dataSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
-    Rcpp::traits::input_parameter< Tree::Ptr const& >::type tree(treeSEXP);
-    Rcpp::traits::input_parameter< FeatureMatrix const& >::type data(dataSEXP);
+    Rcpp::traits::input_parameter< TreeHandle const& >::type tree(treeSEXP);
+    Rcpp::traits::input_parameter< Eigen::Map<Eigen::MatrixXd> >::type data(dataSEXP);
     rcpp_result_gen = Rcpp::wrap(ppforest2_predict_tree(tree, data));
     return rcpp_result_gen;
 END_RCPP
 }
 // ppforest2_predict_tree_forest
-OutcomeVector ppforest2_predict_tree_forest(Forest::Ptr const& forest, FeatureMatrix const& data);
+OutcomeVector ppforest2_predict_tree_forest(ForestHandle const& forest, Eigen::Map<Eigen::MatrixXd> data);
 RcppExport SEXP _ppforest2_ppforest2_predict_tree_forest(SEXP forestSEXP, SEXP dataSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
-    Rcpp::traits::input_parameter< Forest::Ptr const& >::type forest(forestSEXP);
-    Rcpp::traits::input_parameter< FeatureMatrix const& >::type data(dataSEXP);
+    Rcpp::traits::input_parameter< ForestHandle const& >::type forest(forestSEXP);
+    Rcpp::traits::input_parameter< Eigen::Map<Eigen::MatrixXd> >::type data(dataSEXP);
     rcpp_result_gen = Rcpp::wrap(ppforest2_predict_tree_forest(forest, data));
     return rcpp_result_gen;
 END_RCPP
 }
 // ppforest2_predict_tree_regression
-OutcomeVector ppforest2_predict_tree_regression(Tree::Ptr const& tree, FeatureMatrix const& data);
+OutcomeVector ppforest2_predict_tree_regression(TreeHandle const& tree, Eigen::Map<Eigen::MatrixXd> data);
 RcppExport SEXP _ppforest2_ppforest2_predict_tree_regression(SEXP treeSEXP, SEXP dataSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
-    Rcpp::traits::input_parameter< Tree::Ptr const& >::type tree(treeSEXP);
-    Rcpp::traits::input_parameter< FeatureMatrix const& >::type data(dataSEXP);
+    Rcpp::traits::input_parameter< TreeHandle const& >::type tree(treeSEXP);
+    Rcpp::traits::input_parameter< Eigen::Map<Eigen::MatrixXd> >::type data(dataSEXP);
     rcpp_result_gen = Rcpp::wrap(ppforest2_predict_tree_regression(tree, data));
     return rcpp_result_gen;
 END_RCPP
 }
 // ppforest2_predict_forest_regression
-OutcomeVector ppforest2_predict_forest_regression(Forest::Ptr const& forest, FeatureMatrix const& data);
+OutcomeVector ppforest2_predict_forest_regression(ForestHandle const& forest, Eigen::Map<Eigen::MatrixXd> data);
 RcppExport SEXP _ppforest2_ppforest2_predict_forest_regression(SEXP forestSEXP, SEXP dataSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
-    Rcpp::traits::input_parameter< Forest::Ptr const& >::type forest(forestSEXP);
-    Rcpp::traits::input_parameter< FeatureMatrix const& >::type data(dataSEXP);
+    Rcpp::traits::input_parameter< ForestHandle const& >::type forest(forestSEXP);
+    Rcpp::traits::input_parameter< Eigen::Map<Eigen::MatrixXd> >::type data(dataSEXP);
     rcpp_result_gen = Rcpp::wrap(ppforest2_predict_forest_regression(forest, data));
     return rcpp_result_gen;
 END_RCPP
 }
 // ppforest2_predict_tree_prob
-FeatureMatrix ppforest2_predict_tree_prob(Tree::Ptr const& tree, FeatureMatrix const& data);
+FeatureMatrix ppforest2_predict_tree_prob(TreeHandle const& tree, Eigen::Map<Eigen::MatrixXd> data);
 RcppExport SEXP _ppforest2_ppforest2_predict_tree_prob(SEXP treeSEXP, SEXP dataSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
-    Rcpp::traits::input_parameter< Tree::Ptr const& >::type tree(treeSEXP);
-    Rcpp::traits::input_parameter< FeatureMatrix const& >::type data(dataSEXP);
+    Rcpp::traits::input_parameter< TreeHandle const& >::type tree(treeSEXP);
+    Rcpp::traits::input_parameter< Eigen::Map<Eigen::MatrixXd> >::type data(dataSEXP);
     rcpp_result_gen = Rcpp::wrap(ppforest2_predict_tree_prob(tree, data));
     return rcpp_result_gen;
 END_RCPP
 }
 // ppforest2_predict_forest_prob
-FeatureMatrix ppforest2_predict_forest_prob(Forest::Ptr const& forest, FeatureMatrix const& data);
+FeatureMatrix ppforest2_predict_forest_prob(ForestHandle const& forest, Eigen::Map<Eigen::MatrixXd> data);
 RcppExport SEXP _ppforest2_ppforest2_predict_forest_prob(SEXP forestSEXP, SEXP dataSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
-    Rcpp::traits::input_parameter< Forest::Ptr const& >::type forest(forestSEXP);
-    Rcpp::traits::input_parameter< FeatureMatrix const& >::type data(dataSEXP);
+    Rcpp::traits::input_parameter< ForestHandle const& >::type forest(forestSEXP);
+    Rcpp::traits::input_parameter< Eigen::Map<Eigen::MatrixXd> >::type data(dataSEXP);
     rcpp_result_gen = Rcpp::wrap(ppforest2_predict_forest_prob(forest, data));
     return rcpp_result_gen;
 END_RCPP
 }
 // ppforest2_vi_projections_tree
-FeatureVector ppforest2_vi_projections_tree(Tree::Ptr const& tree, int n_vars, FeatureVector const& scale);
+FeatureVector ppforest2_vi_projections_tree(TreeHandle const& tree, int n_vars, FeatureVector const& scale);
 RcppExport SEXP _ppforest2_ppforest2_vi_projections_tree(SEXP treeSEXP, SEXP n_varsSEXP, SEXP scaleSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
-    Rcpp::traits::input_parameter< Tree::Ptr const& >::type tree(treeSEXP);
+    Rcpp::traits::input_parameter< TreeHandle const& >::type tree(treeSEXP);
     Rcpp::traits::input_parameter< int >::type n_vars(n_varsSEXP);
     Rcpp::traits::input_parameter< FeatureVector const& >::type scale(scaleSEXP);
     rcpp_result_gen = Rcpp::wrap(ppforest2_vi_projections_tree(tree, n_vars, scale));
@@ -134,12 +134,12 @@ BEGIN_RCPP
 END_RCPP
 }
 // ppforest2_vi_projections_forest
-FeatureVector ppforest2_vi_projections_forest(Forest::Ptr const& forest, int n_vars, FeatureVector const& scale);
+FeatureVector ppforest2_vi_projections_forest(ForestHandle const& forest, int n_vars, FeatureVector const& scale);
 RcppExport SEXP _ppforest2_ppforest2_vi_projections_forest(SEXP forestSEXP, SEXP n_varsSEXP, SEXP scaleSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
-    Rcpp::traits::input_parameter< Forest::Ptr const& >::type forest(forestSEXP);
+    Rcpp::traits::input_parameter< ForestHandle const& >::type forest(forestSEXP);
     Rcpp::traits::input_parameter< int >::type n_vars(n_varsSEXP);
     Rcpp::traits::input_parameter< FeatureVector const& >::type scale(scaleSEXP);
     rcpp_result_gen = Rcpp::wrap(ppforest2_vi_projections_forest(forest, n_vars, scale));
@@ -147,12 +147,12 @@ BEGIN_RCPP
 END_RCPP
 }
 // ppforest2_vi_weighted_forest
-FeatureVector ppforest2_vi_weighted_forest(Forest::Ptr const& forest, FeatureMatrix const& x, OutcomeVector y, FeatureVector const& scale);
+FeatureVector ppforest2_vi_weighted_forest(ForestHandle const& forest, FeatureMatrix const& x, OutcomeVector y, FeatureVector const& scale);
 RcppExport SEXP _ppforest2_ppforest2_vi_weighted_forest(SEXP forestSEXP, SEXP xSEXP, SEXP ySEXP, SEXP scaleSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
-    Rcpp::traits::input_parameter< Forest::Ptr const& >::type forest(forestSEXP);
+    Rcpp::traits::input_parameter< ForestHandle const& >::type forest(forestSEXP);
     Rcpp::traits::input_parameter< FeatureMatrix const& >::type x(xSEXP);
     Rcpp::traits::input_parameter< OutcomeVector >::type y(ySEXP);
     Rcpp::traits::input_parameter< FeatureVector const& >::type scale(scaleSEXP);
@@ -161,12 +161,12 @@ BEGIN_RCPP
 END_RCPP
 }
 // ppforest2_vi_permuted_forest
-FeatureVector ppforest2_vi_permuted_forest(Forest::Ptr const& forest, FeatureMatrix const& x, OutcomeVector y, int seed);
+FeatureVector ppforest2_vi_permuted_forest(ForestHandle const& forest, FeatureMatrix const& x, OutcomeVector y, int seed);
 RcppExport SEXP _ppforest2_ppforest2_vi_permuted_forest(SEXP forestSEXP, SEXP xSEXP, SEXP ySEXP, SEXP seedSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
-    Rcpp::traits::input_parameter< Forest::Ptr const& >::type forest(forestSEXP);
+    Rcpp::traits::input_parameter< ForestHandle const& >::type forest(forestSEXP);
     Rcpp::traits::input_parameter< FeatureMatrix const& >::type x(xSEXP);
     Rcpp::traits::input_parameter< OutcomeVector >::type y(ySEXP);
     Rcpp::traits::input_parameter< int >::type seed(seedSEXP);
@@ -175,12 +175,12 @@ BEGIN_RCPP
 END_RCPP
 }
 // ppforest2_oob_error_classification
-Rcpp::NumericVector ppforest2_oob_error_classification(Forest::Ptr const& forest, FeatureMatrix const& x, OutcomeVector y);
+Rcpp::NumericVector ppforest2_oob_error_classification(ForestHandle const& forest, FeatureMatrix const& x, OutcomeVector y);
 RcppExport SEXP _ppforest2_ppforest2_oob_error_classification(SEXP forestSEXP, SEXP xSEXP, SEXP ySEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
-    Rcpp::traits::input_parameter< Forest::Ptr const& >::type forest(forestSEXP);
+    Rcpp::traits::input_parameter< ForestHandle const& >::type forest(forestSEXP);
     Rcpp::traits::input_parameter< FeatureMatrix const& >::type x(xSEXP);
     Rcpp::traits::input_parameter< OutcomeVector >::type y(ySEXP);
     rcpp_result_gen = Rcpp::wrap(ppforest2_oob_error_classification(forest, x, y));
@@ -188,12 +188,12 @@ BEGIN_RCPP
 END_RCPP
 }
 // ppforest2_oob_error_regression
-Rcpp::NumericVector ppforest2_oob_error_regression(Forest::Ptr const& forest, FeatureMatrix const& x, OutcomeVector y);
+Rcpp::NumericVector ppforest2_oob_error_regression(ForestHandle const& forest, FeatureMatrix const& x, OutcomeVector y);
 RcppExport SEXP _ppforest2_ppforest2_oob_error_regression(SEXP forestSEXP, SEXP xSEXP, SEXP ySEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
-    Rcpp::traits::input_parameter< Forest::Ptr const& >::type forest(forestSEXP);
+    Rcpp::traits::input_parameter< ForestHandle const& >::type forest(forestSEXP);
     Rcpp::traits::input_parameter< FeatureMatrix const& >::type x(xSEXP);
     Rcpp::traits::input_parameter< OutcomeVector >::type y(ySEXP);
     rcpp_result_gen = Rcpp::wrap(ppforest2_oob_error_regression(forest, x, y));
@@ -201,36 +201,36 @@ BEGIN_RCPP
 END_RCPP
 }
 // ppforest2_oob_predict_classification
-OutcomeVector ppforest2_oob_predict_classification(Forest::Ptr const& forest, FeatureMatrix const& x);
+OutcomeVector ppforest2_oob_predict_classification(ForestHandle const& forest, FeatureMatrix const& x);
 RcppExport SEXP _ppforest2_ppforest2_oob_predict_classification(SEXP forestSEXP, SEXP xSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
-    Rcpp::traits::input_parameter< Forest::Ptr const& >::type forest(forestSEXP);
+    Rcpp::traits::input_parameter< ForestHandle const& >::type forest(forestSEXP);
     Rcpp::traits::input_parameter< FeatureMatrix const& >::type x(xSEXP);
     rcpp_result_gen = Rcpp::wrap(ppforest2_oob_predict_classification(forest, x));
     return rcpp_result_gen;
 END_RCPP
 }
 // ppforest2_oob_predict_regression
-OutcomeVector ppforest2_oob_predict_regression(Forest::Ptr const& forest, FeatureMatrix const& x);
+OutcomeVector ppforest2_oob_predict_regression(ForestHandle const& forest, FeatureMatrix const& x);
 RcppExport SEXP _ppforest2_ppforest2_oob_predict_regression(SEXP forestSEXP, SEXP xSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
-    Rcpp::traits::input_parameter< Forest::Ptr const& >::type forest(forestSEXP);
+    Rcpp::traits::input_parameter< ForestHandle const& >::type forest(forestSEXP);
     Rcpp::traits::input_parameter< FeatureMatrix const& >::type x(xSEXP);
     rcpp_result_gen = Rcpp::wrap(ppforest2_oob_predict_regression(forest, x));
     return rcpp_result_gen;
 END_RCPP
 }
 // ppforest2_tree_node_data
-Rcpp::List ppforest2_tree_node_data(Tree::Ptr const& tree, FeatureMatrix const& x, OutcomeVector y);
+Rcpp::List ppforest2_tree_node_data(TreeHandle const& tree, FeatureMatrix const& x, OutcomeVector y);
 RcppExport SEXP _ppforest2_ppforest2_tree_node_data(SEXP treeSEXP, SEXP xSEXP, SEXP ySEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
-    Rcpp::traits::input_parameter< Tree::Ptr const& >::type tree(treeSEXP);
+    Rcpp::traits::input_parameter< TreeHandle const& >::type tree(treeSEXP);
     Rcpp::traits::input_parameter< FeatureMatrix const& >::type x(xSEXP);
     Rcpp::traits::input_parameter< OutcomeVector >::type y(ySEXP);
     rcpp_result_gen = Rcpp::wrap(ppforest2_tree_node_data(tree, x, y));
@@ -238,12 +238,12 @@ BEGIN_RCPP
 END_RCPP
 }
 // ppforest2_boundary_segments
-Rcpp::DataFrame ppforest2_boundary_segments(Tree::Ptr const& tree, Rcpp::IntegerVector var_indices, Rcpp::NumericVector fixed_values, double x_min, double x_max, double y_min, double y_max);
+Rcpp::DataFrame ppforest2_boundary_segments(TreeHandle const& tree, Rcpp::IntegerVector var_indices, Rcpp::NumericVector fixed_values, double x_min, double x_max, double y_min, double y_max);
 RcppExport SEXP _ppforest2_ppforest2_boundary_segments(SEXP treeSEXP, SEXP var_indicesSEXP, SEXP fixed_valuesSEXP, SEXP x_minSEXP, SEXP x_maxSEXP, SEXP y_minSEXP, SEXP y_maxSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
-    Rcpp::traits::input_parameter< Tree::Ptr const& >::type tree(treeSEXP);
+    Rcpp::traits::input_parameter< TreeHandle const& >::type tree(treeSEXP);
     Rcpp::traits::input_parameter< Rcpp::IntegerVector >::type var_indices(var_indicesSEXP);
     Rcpp::traits::input_parameter< Rcpp::NumericVector >::type fixed_values(fixed_valuesSEXP);
     Rcpp::traits::input_parameter< double >::type x_min(x_minSEXP);
@@ -255,12 +255,12 @@ BEGIN_RCPP
 END_RCPP
 }
 // ppforest2_decision_regions
-Rcpp::List ppforest2_decision_regions(Tree::Ptr const& tree, Rcpp::IntegerVector var_indices, Rcpp::NumericVector fixed_values, double x_min, double x_max, double y_min, double y_max);
+Rcpp::List ppforest2_decision_regions(TreeHandle const& tree, Rcpp::IntegerVector var_indices, Rcpp::NumericVector fixed_values, double x_min, double x_max, double y_min, double y_max);
 RcppExport SEXP _ppforest2_ppforest2_decision_regions(SEXP treeSEXP, SEXP var_indicesSEXP, SEXP fixed_valuesSEXP, SEXP x_minSEXP, SEXP x_maxSEXP, SEXP y_minSEXP, SEXP y_maxSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
-    Rcpp::traits::input_parameter< Tree::Ptr const& >::type tree(treeSEXP);
+    Rcpp::traits::input_parameter< TreeHandle const& >::type tree(treeSEXP);
     Rcpp::traits::input_parameter< Rcpp::IntegerVector >::type var_indices(var_indicesSEXP);
     Rcpp::traits::input_parameter< Rcpp::NumericVector >::type fixed_values(fixed_valuesSEXP);
     Rcpp::traits::input_parameter< double >::type x_min(x_minSEXP);
@@ -272,12 +272,12 @@ BEGIN_RCPP
 END_RCPP
 }
 // ppforest2_tree_layout
-Rcpp::List ppforest2_tree_layout(Tree::Ptr const& tree);
+Rcpp::List ppforest2_tree_layout(TreeHandle const& tree);
 RcppExport SEXP _ppforest2_ppforest2_tree_layout(SEXP treeSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
-    Rcpp::traits::input_parameter< Tree::Ptr const& >::type tree(treeSEXP);
+    Rcpp::traits::input_parameter< TreeHandle const& >::type tree(treeSEXP);
     rcpp_result_gen = Rcpp::wrap(ppforest2_tree_layout(tree));
     return rcpp_result_gen;
 END_RCPP
@@ -26,77 +26,89 @@ bool ppforest2_has_openmp() {
 #endif
 }
 
+// Feature matrices arrive as maps over R's own double storage; the core
+// reads them through a `FeatureView`, converting to float bag by bag
+// (training) or block by block (prediction) instead of copying up front.
+namespace {
+  FeatureView view_of(Eigen::Map<Eigen::MatrixXd> const& x) {
+    return FeatureView(x.data(), x.rows(), x.cols());
+  }
+}
+
 // [[Rcpp::export]]
-Model::Ptr ppforest2_train(TrainingSpec::Ptr spec, FeatureMatrix x, OutcomeVector y) {
+Model::Ptr ppforest2_train(TrainingSpec::Ptr spec, Eigen::Map<Eigen::MatrixXd> x, OutcomeVector y) {
   to_cpp_indices(y);
 
   // y carries integer class labels as float; sort cast-to-int and then
-  // re-cast so `x` and `y` stay in lockstep through the sort.
+  // re-cast. `x` is not moved: the view presents its rows in the same order.
   GroupIdVector y_int = y.cast<GroupId>();
+  FeatureView x_view  = view_of(x);
 
   if (!GroupPartition::is_contiguous(y_int)) {
-    sort(x, y_int);
+    std::vector<int> order = sort_order(y_int);
+    y_int                  = y_int(order).eval();
+    x_view                 = x_view.reordered(std::move(order));
   }
 
   OutcomeVector y_out = y_int.cast<Outcome>();
-  return Model::train(*spec, x, y_out);
+  return Model::train(*spec, x_view, y_out);
 }
 
 // [[Rcpp::export]]
-Model::Ptr ppforest2_train_regression(TrainingSpec::Ptr spec, FeatureMatrix x, OutcomeVector y) {
+Model::Ptr ppforest2_train_regression(TrainingSpec::Ptr spec, Eigen::Map<Eigen::MatrixXd> x, OutcomeVector y) {
   // Data is expected to be pre-sorted by y on the R side. The initial
   // median-split GroupPartition is built by the grouping strategy.
-  return Model::train(*spec, x, y);
+  return Model::train(*spec, view_of(x), y);
 }
 
 // [[Rcpp::export]]
-OutcomeVector ppforest2_predict_tree(Tree::Ptr const& tree, FeatureMatrix const& data) {
-  OutcomeVector result = tree->predict(data);
+OutcomeVector ppforest2_predict_tree(TreeHandle const& tree, Eigen::Map<Eigen::MatrixXd> data) {
+  OutcomeVector result = tree->compiled()->predict(view_of(data), tree->resolve_threads());
   to_r_indices(result);
   return result;
 }
 
 // [[Rcpp::export]]
-OutcomeVector ppforest2_predict_tree_forest(Forest::Ptr const& forest, FeatureMatrix const& data) {
-  OutcomeVector result = forest->predict(data);
+OutcomeVector ppforest2_predict_tree_forest(ForestHandle const& forest, Eigen::Map<Eigen::MatrixXd> data) {
+  OutcomeVector result = forest->compiled()->predict(view_of(data), forest->resolve_threads());
   to_r_indices(result);
   return result;
 }
 
 // Regression prediction variants: return raw float predictions (no index shift).
 // [[Rcpp::export]]
-OutcomeVector ppforest2_predict_tree_regression(Tree::Ptr const& tree, FeatureMatrix const& data) {
-  return tree->predict(data);
+OutcomeVector ppforest2_predict_tree_regression(TreeHandle const& tree, Eigen::Map<Eigen::MatrixXd> data) {
+  return tree->compiled()->predict(view_of(data), tree->resolve_threads());
 }
 
 // [[Rcpp::export]]
-OutcomeVector ppforest2_predict_forest_regression(Forest::Ptr const& forest, FeatureMatrix const& data) {
-  return forest->predict(data);
+OutcomeVector ppforest2_predict_forest_regression(ForestHandle const& forest, Eigen::Map<Eigen::MatrixXd> data) {
+  return forest->compiled()->predict(view_of(data), forest->resolve_threads());
 }
 
 // [[Rcpp::export]]
-FeatureMatrix ppforest2_predict_tree_prob(Tree::Ptr const& tree, FeatureMatrix const& data) {
-  return tree->predict(data, Proportions{});
+FeatureMatrix ppforest2_predict_tree_prob(TreeHandle const& tree, Eigen::Map<Eigen::MatrixXd> data) {
+  return tree->compiled()->predict(view_of(data), Proportions{}, tree->resolve_threads());
 }
 
 // [[Rcpp::export]]
-FeatureMatrix ppforest2_predict_forest_prob(Forest::Ptr const& forest, FeatureMatrix const& data) {
-  return forest->predict(data, Proportions{});
+FeatureMatrix ppforest2_predict_forest_prob(ForestHandle const& forest, Eigen::Map<Eigen::MatrixXd> data) {
+  return forest->compiled()->predict(view_of(data), Proportions{}, forest->resolve_threads());
 }
 
 // [[Rcpp::export]]
-FeatureVector ppforest2_vi_projections_tree(Tree::Ptr const& tree, int n_vars, FeatureVector const& scale) {
+FeatureVector ppforest2_vi_projections_tree(TreeHandle const& tree, int n_vars, FeatureVector const& scale) {
   return tree->vi_projections(n_vars, &scale);
 }
 
 // [[Rcpp::export]]
-FeatureVector ppforest2_vi_projections_forest(Forest::Ptr const& forest, int n_vars, FeatureVector const& scale) {
+FeatureVector ppforest2_vi_projections_forest(ForestHandle const& forest, int n_vars, FeatureVector const& scale) {
   return forest->vi_projections(n_vars, &scale);
 }
 
 // [[Rcpp::export]]
 FeatureVector ppforest2_vi_weighted_forest(
-    Forest::Ptr const& forest, FeatureMatrix const& x, OutcomeVector y, FeatureVector const& scale
+    ForestHandle const& forest, FeatureMatrix const& x, OutcomeVector y, FeatureVector const& scale
 ) {
   bool const is_regression = forest->training_spec && forest->training_spec->mode == types::Mode::Regression;
 
@@ -109,7 +121,7 @@ FeatureVector ppforest2_vi_weighted_forest(
 
 // [[Rcpp::export]]
 FeatureVector
-ppforest2_vi_permuted_forest(Forest::Ptr const& forest, FeatureMatrix const& x, OutcomeVector y, int seed) {
+ppforest2_vi_permuted_forest(ForestHandle const& forest, FeatureMatrix const& x, OutcomeVector y, int seed) {
   bool const is_regression = forest->training_spec && forest->training_spec->mode == types::Mode::Regression;
 
   if (!is_regression) {
@@ -133,34 +145,35 @@ namespace {
 
 // [[Rcpp::export]]
 Rcpp::NumericVector
-ppforest2_oob_error_classification(Forest::Ptr const& forest, FeatureMatrix const& x, OutcomeVector y) {
+ppforest2_oob_error_classification(ForestHandle const& forest, FeatureMatrix const& x, OutcomeVector y) {
   auto const& cf = dynamic_cast<ClassificationForest const&>(*forest);
   to_cpp_indices(y);
   return to_r_scalar(cf.oob_error(x, y));
 }
 
 // [[Rcpp::export]]
-Rcpp::NumericVector ppforest2_oob_error_regression(Forest::Ptr const& forest, FeatureMatrix const& x, OutcomeVector y) {
+Rcpp::NumericVector
+ppforest2_oob_error_regression(ForestHandle const& forest, FeatureMatrix const& x, OutcomeVector y) {
   auto const& rf = dynamic_cast<RegressionForest const&>(*forest);
   return to_r_scalar(rf.oob_error(x, y));
 }
 
 // [[Rcpp::export]]
-OutcomeVector ppforest2_oob_predict_classification(Forest::Ptr const& forest, FeatureMatrix const& x) {
+OutcomeVector ppforest2_oob_predict_classification(ForestHandle const& forest, FeatureMatrix const& x) {
   OutcomeVector result = forest->oob_predict(x);
   to_r_indices(result); // sentinel -1 becomes 0 (handled in R)
   return result;
 }
 
 // [[Rcpp::export]]
-OutcomeVector ppforest2_oob_predict_regression(Forest::Ptr const& forest, FeatureMatrix const& x) {
+OutcomeVector ppforest2_oob_predict_regression(ForestHandle const& forest, FeatureMatrix const& x) {
   // No index shift for regression — returned values are raw float predictions.
   // "No OOB tree" observations are marked with NaN (filter via is.nan() in R).
   return forest->oob_predict(x);
 }
 
 // [[Rcpp::export]]
-Rcpp::List ppforest2_tree_node_data(Tree::Ptr const& tree, FeatureMatrix const& x, OutcomeVector y) {
+Rcpp::List ppforest2_tree_node_data(TreeHandle const& tree, FeatureMatrix const& x, OutcomeVector y) {
   to_cpp_indices(y);
   NodeDataVisitor visitor(x, y);
   tree->root->accept(visitor);
@@ -220,7 +233,7 @@ namespace {
 
 // [[Rcpp::export]]
 Rcpp::DataFrame ppforest2_boundary_segments(
-    Tree::Ptr const& tree,
+    TreeHandle const& tree,
     Rcpp::IntegerVector var_indices,
     Rcpp::NumericVector fixed_values,
     double x_min,
@@ -267,7 +280,7 @@ Rcpp::DataFrame ppforest2_boundary_segments(
 
 // [[Rcpp::export]]
 Rcpp::List ppforest2_decision_regions(
-    Tree::Ptr const& tree,
+    TreeHandle const& tree,
     Rcpp::IntegerVector var_indices,
     Rcpp::NumericVector fixed_values,
     double x_min,
@@ -311,7 +324,7 @@ Rcpp::List ppforest2_decision_regions(
 }
 
 // [[Rcpp::export]]
-Rcpp::List ppforest2_tree_layout(Tree::Ptr const& tree) {
+Rcpp::List ppforest2_tree_layout(TreeHandle const& tree) {
   LayoutParams params;
   TreeLayout layout = compute_tree_layout(*tree->root, params);
 
@@ -9,6 +9,7 @@
 #include "models/Forest.hpp"
 #include "models/ClassificationForest.hpp"
 #include "models/RegressionForest.hpp"
+#include "models/CompiledForest.hpp"
 #include "models/TrainingSpec.hpp"
 
 #include "models/strategies/pp/ProjectionPursuit.hpp"
@@ -10,6 +10,7 @@
 #include "cli/Train.hpp"
 #include "io/Color.hpp"
 #include "io/IO.hpp"
+#include "serialization/Binary.hpp"
 #include "utils/UserError.hpp"
 
 #include <fmt/format.h>
@@ -26,8 +27,8 @@ int main(int argc, char* argv[]) {
 
     ppforest2::io::style::init_color(params.no_color);
 
-    // Post-parse: ensure .json extension on output paths
-    if (!params.save_path.empty()) {
+    // Post-parse: ensure .json extension on output paths (binary models keep theirs)
+    if (!params.save_path.empty() && !ppforest2::serialization::binary::has_extension(params.save_path)) {
       params.save_path = ppforest2::io::json::ensure_extension(params.save_path);
     }
 
@@ -42,6 +42,9 @@ namespace ppforest2::cli {
     std::string model_path;
     std::string output_path;
 
+    /** @brief Rows per chunk for streaming `predict`; 0 reads the whole file at once. */
+    int chunk_size = 0;
+
     bool quiet          = false;
     bool no_save        = false;
     bool no_metrics     = false;
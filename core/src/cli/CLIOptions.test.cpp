@@ -259,6 +259,15 @@ TEST(ParseArgs, PredictNoProportionsDefault) {
   EXPECT_FALSE(opts.no_proportions);
 }
 
+/* --chunk-size is captured; 0 (the default) reads the whole file at once. */
+TEST(ParseArgs, PredictChunkSizeOption) {
+  auto opts = parse({"ppforest2", "predict", "-M", IRIS_PATH.c_str(), "-d", IRIS_PATH.c_str(), "--chunk-size", "500"});
+  EXPECT_EQ(opts.chunk_size, 500);
+
+  auto defaults = parse({"ppforest2", "predict", "-M", IRIS_PATH.c_str(), "-d", IRIS_PATH.c_str()});
+  EXPECT_EQ(defaults.chunk_size, 0);
+}
+
 /* Predict without -M (model path) must throw. */
 TEST(ParseArgs, PredictMissingModelExits) {
   EXPECT_THROW(parse({"ppforest2", "predict", "-d", IRIS_PATH.c_str()}), ppforest2::UserError);
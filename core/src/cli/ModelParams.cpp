@@ -244,6 +244,11 @@ namespace ppforest2::cli {
     if (config.contains("max_retries") && config["max_retries"].is_number_integer()) {
       check(config["max_retries"].get<int>() >= 0, "max_retries must be non-negative", errors);
     }
+
+    // Task cutoff
+    if (config.contains("task_cutoff") && config["task_cutoff"].is_number_integer()) {
+      check(config["task_cutoff"].get<int>() >= 0, "task_cutoff must be non-negative", errors);
+    }
   }
 
   ModelParams::ModelParams(nlohmann::json const& config) {
@@ -253,6 +258,10 @@ namespace ppforest2::cli {
     apply(config, "seed", seed);
     apply(config, "threads", threads);
     apply(config, "max_retries", max_retries);
+    apply(config, "task_cutoff", task_cutoff);
+    apply(config, "weighted_bootstrap", weighted_bootstrap);
+    apply(config, "compact_samples", compact_samples);
+    apply(config, "cache_scatter", cache_scatter);
     apply(config, "n_vars", n_vars);
 
     if (config.contains("p_vars")) {
@@ -21,6 +21,10 @@ namespace ppforest2::cli {
     std::optional<float> p_vars;
     std::optional<int> n_vars;
     int max_retries = 3;
+    int task_cutoff = 0;
+    bool weighted_bootstrap = false;
+    bool compact_samples = false;
+    bool cache_scatter = false;
     std::string p_vars_input;
 
     /** @brief Training mode ("classification" or "regression"). */
@@ -75,6 +79,18 @@ namespace ppforest2::cli {
       if (threads) {
         j["threads"] = *threads;
       }
+      if (task_cutoff > 0) {
+        j["task_cutoff"] = task_cutoff;
+      }
+      if (weighted_bootstrap) {
+        j["weighted_bootstrap"] = true;
+      }
+      if (compact_samples) {
+        j["compact_samples"] = true;
+      }
+      if (cache_scatter) {
+        j["cache_scatter"] = true;
+      }
       if (n_vars) {
         j["n_vars"] = *n_vars;
       }
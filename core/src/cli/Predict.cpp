@@ -8,8 +8,10 @@
 #include <CLI/CLI.hpp>
 #include <fmt/format.h>
 #include <fstream>
+#include <optional>
 #include <vector>
 
+#include "models/CompiledForest.hpp"
 #include "stats/DataPacket.hpp"
 #include "stats/ConfusionMatrix.hpp"
 #include "stats/RegressionMetrics.hpp"
@@ -17,6 +19,8 @@
 #include "io/Color.hpp"
 #include "io/Output.hpp"
 #include "io/IO.hpp"
+#include "io/TempFile.hpp"
+#include "serialization/Binary.hpp"
 #include "serialization/Json.hpp"
 #include "utils/UserError.hpp"
 
@@ -31,15 +35,17 @@ using json = nlohmann::json;
 namespace ppforest2::cli {
   void setup_predict(CLI::App& app, Params& params) {
     auto* sub = app.add_subcommand("predict", "Load a model and predict on new data");
-    sub->add_option("-M,--model", params.model_path, "Saved model JSON file");
+    sub->add_option("-M,--model", params.model_path, "Saved model file (JSON, or binary with a .ppf2 extension)");
     sub->add_option("-d,--data", params.data_path, "CSV data to predict on");
     sub->add_option("-o,--output", params.output_path, "Save prediction results to JSON file");
     sub->add_flag("--no-metrics", params.no_metrics, "Omit error rate and confusion matrix from output");
     sub->add_flag("--no-proportions", params.no_proportions, "Omit vote proportions from output");
+    sub->add_option("--chunk-size", params.chunk_size, "Stream the data in chunks of N rows, in input order");
 
     // CLI-exclusive constraints (predict doesn't use config files)
     sub->get_option("--model")->required()->check(CLI::ExistingFile);
     sub->get_option("--data")->required()->check(CLI::ExistingFile);
+    sub->get_option("--chunk-size")->check(CLI::NonNegativeNumber);
 
     sub->callback([&]() { params.subcommand = Subcommand::predict; });
   }
@@ -83,21 +89,57 @@ namespace ppforest2::cli {
       }
     };
 
+    json predictions_to_json(
+        OutcomeVector const& predictions, std::vector<std::string> const& group_names, bool is_regression
+    ) {
+      if (is_regression) {
+        return std::vector<Feature>(predictions.data(), predictions.data() + predictions.size());
+      }
+
+      GroupIdVector predictions_int = predictions.cast<GroupId>();
+
+      if (group_names.empty()) {
+        return std::vector<int>(predictions_int.data(), predictions_int.data() + predictions_int.size());
+      }
+
+      return serialization::to_labels(predictions_int, group_names);
+    }
+
+    /** @brief Prefer the CSV's label names, fall back to the saved model metadata. */
+    std::vector<std::string> resolve_group_names(
+        std::vector<std::string> const& csv_names, json const& model_data, bool is_regression
+    ) {
+      if (!is_regression && csv_names.empty() && model_data.contains("meta") && model_data["meta"].contains("groups")) {
+        return model_data["meta"]["groups"].get<std::vector<std::string>>();
+      }
+
+      return csv_names;
+    }
+
+    /** @brief Run a CSV read, reporting parse failures as user errors. */
+    template<typename Read> auto read_csv(Read&& read) {
+      try {
+        return read();
+      } catch (ppforest2::UserError const&) {
+        throw;
+      } catch (std::exception const& e) {
+        throw ppforest2::UserError(fmt::format("Error reading CSV file: {}", e.what()));
+      }
+    }
+
     json build_predict_result(
         OutcomeVector const& predictions,
         DataPacket const& data,
-        Model const& model,
+        std::optional<FeatureMatrix> const& proportions,
         std::vector<std::string> const& group_names,
         bool no_metrics,
         bool no_proportions,
         bool is_regression
     ) {
       json result;
+      result["predictions"] = predictions_to_json(predictions, group_names, is_regression);
 
       if (is_regression) {
-        std::vector<Feature> pred_vec(predictions.data(), predictions.data() + predictions.size());
-        result["predictions"] = pred_vec;
-
         if (data.y.size() > 0 && !no_metrics) {
           stats::RegressionMetrics metrics(predictions, data.y);
           result["regression_metrics"] = serialization::to_json(metrics);
@@ -108,13 +150,6 @@ namespace ppforest2::cli {
 
       GroupIdVector predictions_int = predictions.cast<GroupId>();
 
-      if (group_names.empty()) {
-        std::vector<int> pred_vec(predictions_int.data(), predictions_int.data() + predictions_int.size());
-        result["predictions"] = pred_vec;
-      } else {
-        result["predictions"] = serialization::to_labels(predictions_int, group_names);
-      }
-
       bool has_labels   = data.y.size() > 0;
       bool show_metrics = has_labels && !no_metrics;
 
@@ -126,16 +161,237 @@ namespace ppforest2::cli {
             group_names.empty() ? serialization::to_json(cm) : serialization::to_json(cm, group_names);
       }
 
-      if (!no_proportions) {
-        ProportionsVisitor visitor(data.x);
-        model.accept(visitor);
+      if (!no_proportions && proportions) {
+        result["proportions"] = proportions_to_json(*proportions);
+      }
+
+      return result;
+    }
+
+    void print_results(
+        io::Output& out,
+        json const& model_data,
+        std::optional<ConfusionMatrix> const& cm,
+        std::optional<RegressionMetrics> const& metrics,
+        std::vector<std::string> const& group_names
+    ) {
+      std::string model_type = model_data.value("model_type", "tree") == "forest" ? "Random Forest" : "Decision Tree";
+
+      out.println("{}", emphasis("Prediction results for " + model_type));
+      out.newline();
+
+      if (metrics) {
+        out.println("{} {}", emphasis("MSE:"), fmt::format("{:.6f}", metrics->mse));
+        io::print_regression_metrics(out, *metrics, "Regression Metrics");
+      } else if (cm) {
+        out.println("{} {}", emphasis("Error:"), fmt::format("{:.2f}%", cm->error() * 100));
+        print_confusion_matrix(out, *cm, "Confusion Matrix", group_names);
+      }
+    }
+
+    /**
+     * @brief Writes the `--output` JSON of a chunked prediction as it goes.
+     *
+     * Same keys and values as `build_predict_result`. Predictions are
+     * appended to the output file chunk by chunk; proportions go to a
+     * uniquely named temporary file (removed with the result) and are
+     * copied in after the last chunk, so memory stays bounded by the chunk
+     * size. Metrics come last, once the accumulators have seen every row.
+     */
+    class StreamingResult {
+    public:
+      StreamingResult(std::string const& path, bool with_proportions) {
+        file.open(path);
+        user_error(file.is_open(), fmt::format("Could not open file for writing: {}", path));
+        file << "{\n  \"predictions\": [";
+
+        if (with_proportions) {
+          sidecar_file.emplace(".tmp");
+          sidecar.open(sidecar_file->path());
+          user_error(sidecar.is_open(), "Could not create a temporary file for prediction proportions");
+        }
+      }
 
-        if (visitor.has_proportions) {
-          result["proportions"] = proportions_to_json(visitor.proportions);
+      void add_predictions(json const& values) {
+        for (auto const& value : values) {
+          file << (rows == 0 ? "\n    " : ",\n    ") << value.dump();
+          ++rows;
         }
       }
 
-      return result;
+      void add_proportions(FeatureMatrix const& proportions) {
+        for (Eigen::Index i = 0; i < proportions.rows(); ++i) {
+          std::vector<Feature> row(proportions.cols());
+
+          for (Eigen::Index j = 0; j < proportions.cols(); ++j) {
+            row[j] = proportions(i, j);
+          }
+
+          sidecar << (proportion_rows == 0 ? "\n    " : ",\n    ") << json(row).dump();
+          ++proportion_rows;
+        }
+      }
+
+      /** @brief Close the arrays, append @p metrics' keys and the closing brace. */
+      void finish(json const& metrics) {
+        file << (rows == 0 ? "]" : "\n  ]");
+
+        if (sidecar.is_open()) {
+          sidecar.close();
+          std::ifstream in(sidecar_file->path(), std::ios::binary);
+
+          file << ",\n  \"proportions\": [";
+
+          if (proportion_rows > 0) {
+            file << in.rdbuf() << "\n  ";
+          }
+
+          file << "]";
+        }
+
+        for (auto const& [key, value] : metrics.items()) {
+          // Nest the pretty-printed value one level deeper, as `dump(2)` would.
+          std::string nested = value.dump(2);
+
+          for (std::size_t pos = nested.find('\n'); pos != std::string::npos; pos = nested.find('\n', pos + 3)) {
+            nested.replace(pos, 1, "\n  ");
+          }
+
+          file << ",\n  " << json(key).dump() << ": " << nested;
+        }
+
+        file << "\n}";
+        file.close();
+        user_error(!file.fail(), "Could not write prediction results");
+      }
+
+    private:
+      std::ofstream file;
+      std::optional<io::TempFile> sidecar_file;
+      std::ofstream sidecar;
+      std::size_t rows            = 0;
+      std::size_t proportion_rows = 0;
+    };
+
+    /**
+     * @brief Label with the largest proportion in each row of @p proportions.
+     *
+     * Columns follow @p groups (ascending), and a strictly-greater scan
+     * gives ties to the smallest label, as `CompiledForest::predict` does.
+     */
+    OutcomeVector most_voted(FeatureMatrix const& proportions, std::vector<GroupId> const& groups) {
+      OutcomeVector labels(proportions.rows());
+
+      for (Eigen::Index i = 0; i < proportions.rows(); ++i) {
+        Eigen::Index best = 0;
+
+        for (Eigen::Index g = 1; g < proportions.cols(); ++g) {
+          if (proportions(i, g) > proportions(i, best)) {
+            best = g;
+          }
+        }
+
+        labels(i) = static_cast<Outcome>(groups[static_cast<std::size_t>(best)]);
+      }
+
+      return labels;
+    }
+
+    /**
+     * @brief `predict --chunk-size`: score the CSV one chunk at a time.
+     *
+     * Only one chunk of the data is in memory at any point. Predictions are
+     * written in input order (the whole-file path sorts rows by label) and
+     * metrics are accumulated online, so they match the whole-file results.
+     */
+    int predict_in_chunks(
+        Params const& params,
+        io::Output& out,
+        json const& model_data,
+        CompiledForest const& model,
+        int threads,
+        bool is_regression
+    ) {
+      io::csv::ChunkReader reader = read_csv([&] {
+        return io::csv::ChunkReader(params.data_path, is_regression ? Mode::Regression : Mode::Classification);
+      });
+
+      std::vector<std::string> group_names = resolve_group_names(reader.group_names(), model_data, is_regression);
+
+      bool const with_proportions = !is_regression && !params.no_proportions;
+      std::optional<StreamingResult> result;
+
+      if (!params.output_path.empty()) {
+        result.emplace(params.output_path, with_proportions);
+      }
+
+      ConfusionMatrixAccumulator confusion;
+      RegressionMetricsAccumulator regression;
+
+      DataPacket chunk;
+      int done = 0;
+
+      while (read_csv([&] { return reader.next(chunk, params.chunk_size); })) {
+        // When proportions are written the votes are counted once, and
+        // the labels are read off the proportions.
+        std::optional<FeatureMatrix> proportions;
+
+        if (result && with_proportions) {
+          proportions = model.predict(chunk.x, Proportions{}, threads);
+        }
+
+        OutcomeVector const predictions =
+            proportions ? most_voted(*proportions, model.groups) : model.predict(chunk.x, threads);
+
+        if (is_regression) {
+          regression.add(predictions, chunk.y);
+        } else {
+          confusion.add(predictions.cast<GroupId>(), chunk.y.cast<GroupId>());
+        }
+
+        if (result) {
+          result->add_predictions(predictions_to_json(predictions, group_names, is_regression));
+
+          if (proportions) {
+            result->add_proportions(*proportions);
+          }
+        }
+
+        done += static_cast<int>(chunk.x.rows());
+        out.progress(done, reader.rows());
+      }
+
+      std::optional<ConfusionMatrix> cm;
+      std::optional<RegressionMetrics> metrics;
+
+      if (!params.no_metrics) {
+        if (is_regression) {
+          metrics = regression.metrics();
+        } else {
+          cm = confusion.matrix();
+        }
+
+        print_results(out, model_data, cm, metrics, group_names);
+      }
+
+      if (result) {
+        json file_metrics = json::object();
+
+        if (metrics) {
+          file_metrics["regression_metrics"] = serialization::to_json(*metrics);
+        } else if (cm) {
+          file_metrics["error_rate"] = cm->error();
+          file_metrics["confusion_matrix"] =
+              group_names.empty() ? serialization::to_json(*cm) : serialization::to_json(*cm, group_names);
+        }
+
+        result->finish(file_metrics);
+        out.saved("Results", params.output_path);
+      } else if (!params.no_metrics) {
+        out.println("{}", muted("Tip: use --output <file> to save individual predictions"));
+      }
+
+      return 0;
     }
   }
 
@@ -147,56 +403,64 @@ namespace ppforest2::cli {
       io::check_file_not_exists(params.output_path);
     }
 
-    // Inspect the saved model's mode before reading data.
-    json model_data = io::json::read_file(params.model_path, user_error);
+    // Inspect the saved model's mode before reading data. A binary model
+    // carries the same export metadata next to its flat trees.
+    std::optional<serialization::binary::BinaryExport> binary_model;
+    json model_data;
+
+    if (serialization::binary::has_extension(params.model_path)) {
+      binary_model = io::binary::read_file(params.model_path, user_error);
+      model_data   = std::move(binary_model->meta);
+    } else {
+      model_data = io::json::read_file(params.model_path, user_error);
+    }
 
     bool const is_regression =
         model_data.contains("config") && model_data["config"].value("mode", "classification") == "regression";
 
-    DataPacket data = [&]() -> DataPacket {
-      try {
-        return is_regression ? io::csv::read_regression_sorted(params.data_path)
-                             : io::csv::read_sorted(params.data_path);
-      } catch (ppforest2::UserError const&) {
-        throw;
-      } catch (std::exception const& e) {
-        throw ppforest2::UserError(fmt::format("Error reading CSV file: {}", e.what()));
-      }
-    }();
+    Model::Ptr model;
+    int threads = 1;
 
-    auto model       = model_data.get<serialization::Export<Model::Ptr>>().model;
-    auto predictions = model->predict(data.x);
+    if (binary_model) {
+      // Same parallelism `Model::predict` would use: the spec's thread count.
+      threads = TrainingSpec::from_json(model_data.at("config"))->resolve_threads();
+    } else {
+      model   = model_data.get<serialization::Export<Model::Ptr>>().model;
+      threads = model->resolve_threads();
+    }
+
+    if (params.chunk_size > 0) {
+      // Compile once; every chunk reuses the flat trees.
+      CompiledForest const compiled = binary_model ? std::move(binary_model->model) : CompiledForest::compile(*model);
+      return predict_in_chunks(params, out, model_data, compiled, threads, is_regression);
+    }
+
+    DataPacket data = read_csv([&] {
+      return is_regression ? io::csv::read_regression_sorted(params.data_path) : io::csv::read_sorted(params.data_path);
+    });
+
+    OutcomeVector const predictions =
+        binary_model ? binary_model->model.predict(data.x, threads) : model->predict(data.x);
 
     // `y` holds integer class labels for classification and the continuous
     // response for regression; in both modes, empty means "no truth".
     bool has_labels   = data.y.size() > 0;
     bool show_metrics = has_labels && !params.no_metrics;
 
-    // Resolve group names: prefer CSV data, fall back to saved model metadata.
-    std::vector<std::string> group_names = data.group_names;
-
-    if (!is_regression && group_names.empty() && model_data.contains("meta") && model_data["meta"].contains("groups")) {
-      group_names = model_data["meta"]["groups"].get<std::vector<std::string>>();
-    }
+    std::vector<std::string> group_names = resolve_group_names(data.group_names, model_data, is_regression);
 
     // Terminal output
     if (show_metrics) {
-      std::string model_type = model_data.value("model_type", "tree") == "forest" ? "Random Forest" : "Decision Tree";
-
-      out.println("{}", emphasis("Prediction results for " + model_type));
-      out.newline();
+      std::optional<ConfusionMatrix> cm;
+      std::optional<RegressionMetrics> metrics;
 
       if (is_regression) {
-        stats::RegressionMetrics metrics(predictions, data.y);
-        out.println("{} {}", emphasis("MSE:"), fmt::format("{:.6f}", metrics.mse));
-        io::print_regression_metrics(out, metrics, "Regression Metrics");
+        metrics.emplace(predictions, data.y);
       } else {
-        GroupIdVector predictions_int = predictions.cast<GroupId>();
-        GroupIdVector y_int           = data.y.cast<GroupId>();
-        ConfusionMatrix cm(predictions_int, y_int);
-        out.println("{} {}", emphasis("Error:"), fmt::format("{:.2f}%", cm.error() * 100));
-        print_confusion_matrix(out, cm, "Confusion Matrix", group_names);
+        cm.emplace(predictions.cast<GroupId>(), data.y.cast<GroupId>());
       }
+
+      print_results(out, model_data, cm, metrics, group_names);
     }
 
     // Hint about --output when not used
@@ -206,8 +470,23 @@ namespace ppforest2::cli {
 
     // Save results to file if requested
     if (!params.output_path.empty()) {
+      std::optional<FeatureMatrix> proportions;
+
+      if (!is_regression && !params.no_proportions) {
+        if (binary_model) {
+          proportions = binary_model->model.predict(data.x, Proportions{}, threads);
+        } else {
+          ProportionsVisitor visitor(data.x);
+          model->accept(visitor);
+
+          if (visitor.has_proportions) {
+            proportions = std::move(visitor.proportions);
+          }
+        }
+      }
+
       json file_result = build_predict_result(
-          predictions, data, *model, group_names, params.no_metrics, params.no_proportions, is_regression
+          predictions, data, proportions, group_names, params.no_metrics, params.no_proportions, is_regression
       );
       io::json::write_file(file_result, params.output_path, user_error);
       out.saved("Results", params.output_path);
@@ -139,6 +139,42 @@ TEST_F(PredictTest, PredictNoProportionsFlag) {
   EXPECT_FALSE(j.contains("proportions"));
 }
 
+/* --chunk-size streams the data and writes the same results as a whole-file read. */
+TEST_F(PredictTest, PredictInChunksMatchesWholeFile) {
+  TempFile whole;
+  whole.clear();
+  auto expected_run = run_ppforest2("-q predict -M " + model_->path() + " -d " + IRIS_CSV + " -o " + whole.path());
+  ASSERT_EQ(expected_run.exit_code, 0);
+
+  TempFile chunked;
+  chunked.clear();
+  auto result = run_ppforest2(
+      "-q predict -M " + model_->path() + " -d " + IRIS_CSV + " --chunk-size 16 -o " + chunked.path()
+  );
+  ASSERT_EQ(result.exit_code, 0);
+
+  auto expected = json::parse(whole.read());
+  auto actual   = json::parse(chunked.read());
+  EXPECT_EQ(expected, actual);
+}
+
+/* Chunked prediction honours --no-proportions and --no-metrics. */
+TEST_F(PredictTest, PredictInChunksOmitsOptionalSections) {
+  TempFile output;
+  output.clear();
+  auto result = run_ppforest2(
+      "-q predict -M " + model_->path() + " -d " + IRIS_CSV + " --chunk-size 32 --no-proportions --no-metrics -o " +
+      output.path()
+  );
+  ASSERT_EQ(result.exit_code, 0);
+
+  auto j = json::parse(output.read());
+  EXPECT_EQ(j["predictions"].size(), 150u);
+  EXPECT_FALSE(j.contains("proportions"));
+  EXPECT_FALSE(j.contains("error_rate"));
+  EXPECT_FALSE(j.contains("confusion_matrix"));
+}
+
 // ---------------------------------------------------------------------------
 // Predict subcommand — standalone tests
 // ---------------------------------------------------------------------------
@@ -245,3 +281,34 @@ TEST(CLIPredict, PredictWithSingleTreeModel) {
   EXPECT_TRUE(j.contains("error_rate"));
   EXPECT_TRUE(j.contains("confusion_matrix"));
 }
+
+/* A binary (.ppf2) model predicts exactly like the JSON export of the same forest. */
+TEST(CLIPredict, PredictBinaryModelMatchesJson) {
+  TempFile json_model;
+  json_model.clear();
+  auto train_json = run_ppforest2("-q train -d " + IRIS_CSV + " -n 5 -r 0 -s " + json_model.path());
+  ASSERT_EQ(train_json.exit_code, 0);
+
+  TempFile binary_model(".ppf2");
+  binary_model.clear();
+  auto train_binary = run_ppforest2("-q train -d " + IRIS_CSV + " -n 5 -r 0 -s " + binary_model.path());
+  ASSERT_EQ(train_binary.exit_code, 0);
+
+  TempFile json_output;
+  json_output.clear();
+  auto predict_json =
+      run_ppforest2("-q predict -M " + json_model.path() + " -d " + IRIS_CSV + " -o " + json_output.path());
+  ASSERT_EQ(predict_json.exit_code, 0);
+
+  TempFile binary_output;
+  binary_output.clear();
+  auto predict_binary =
+      run_ppforest2("-q predict -M " + binary_model.path() + " -d " + IRIS_CSV + " -o " + binary_output.path());
+  ASSERT_EQ(predict_binary.exit_code, 0);
+
+  auto expected = json::parse(json_output.read());
+  auto actual   = json::parse(binary_output.read());
+  EXPECT_EQ(expected["predictions"], actual["predictions"]);
+  EXPECT_EQ(expected["proportions"], actual["proportions"]);
+  EXPECT_EQ(expected["error_rate"], actual["error_rate"]);
+}
@@ -6,6 +6,7 @@
 #include "io/Presentation.hpp"
 #include "io/Output.hpp"
 #include "io/IO.hpp"
+#include "serialization/Binary.hpp"
 #include "serialization/Json.hpp"
 #include "serialization/JsonOptional.hpp"
 #include "utils/UserError.hpp"
@@ -19,7 +20,7 @@ using json = nlohmann::json;
 namespace ppforest2::cli {
   void setup_summarize(CLI::App& app, Params& params) {
     auto* sub = app.add_subcommand("summarize", "Display a saved model summary");
-    sub->add_option("-M,--model", params.model_path, "Saved model JSON file");
+    sub->add_option("-M,--model", params.model_path, "Saved model file (JSON, or binary with a .ppf2 extension)");
     sub->add_option("-d,--data", params.data_path, "CSV training data (recomputes metrics if provided)");
 
     // CLI-exclusive constraints (summarize doesn't use config files)
@@ -32,7 +33,11 @@ namespace ppforest2::cli {
   int run_summarize(Params& params) {
     io::Output out(params.quiet);
 
-    json model_data = io::json::read_file(params.model_path, user_error);
+    bool const is_binary = serialization::binary::has_extension(params.model_path);
+
+    // A binary model stores the same export metadata, minus the node graph.
+    json model_data = is_binary ? io::binary::read_file(params.model_path, user_error).meta
+                                : io::json::read_file(params.model_path, user_error);
 
     // Recompute metrics if data is provided and metrics are absent
     // With the uniform `nullopt ↔ null` convention the keys are always
@@ -44,6 +49,8 @@ namespace ppforest2::cli {
                        serialization::has_value(model_data, "variable_importance");
 
     if (!params.data_path.empty() && !has_metrics) {
+      user_error(!is_binary, "Recomputing metrics needs the full model: summarize the JSON export instead.");
+
       try {
         auto data = io::csv::read_sorted(params.data_path);
 
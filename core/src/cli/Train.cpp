@@ -13,6 +13,8 @@
 #include "io/Output.hpp"
 #include "io/IO.hpp"
 #include "io/Timing.hpp"
+#include "models/Forest.hpp"
+#include "serialization/Binary.hpp"
 #include "serialization/Json.hpp"
 #include "utils/UserError.hpp"
 #include "utils/Types.hpp"
@@ -37,6 +39,26 @@ namespace ppforest2::cli {
     sub->add_option("--n-vars", model.n_vars, "Features per split (integer count)");
     sub->add_option("--p-vars", model.p_vars_input, "Features per split (proportion, e.g. 0.5 or 1/2, default: 0.5)");
     sub->add_option("--max-retries", model.max_retries, "Max retries for degenerate trees (default: 3)");
+    sub->add_option(
+        "--task-cutoff",
+        model.task_cutoff,
+        "Grow subtrees of nodes with at least this many rows as parallel tasks (default: 0, sequential)"
+    );
+    sub->add_flag(
+        "--weighted-bootstrap",
+        model.weighted_bootstrap,
+        "Train each bag on its distinct rows, weighted by how often they were drawn"
+    );
+    sub->add_flag(
+        "--compact-samples",
+        model.compact_samples,
+        "Save each tree's RNG stream instead of its bootstrap sample indices"
+    );
+    sub->add_flag(
+        "--cache-scatter",
+        model.cache_scatter,
+        "Compute label-grouped scatter from block moments cached once per tree"
+    );
 
     sub->add_option("--pp", model.pp_input, "PP strategy (e.g. pda, pda:lambda=0.5)");
     sub->add_option("--vars", model.vars_input, "Variable selection strategy (e.g. all, uniform:count=3)");
@@ -76,7 +98,7 @@ namespace ppforest2::cli {
     add_model_options(sub, params.model);
 
     // CLI-exclusive options
-    sub->add_option("-s,--save", params.save_path, "Save trained model to JSON file (default: model.json)");
+    sub->add_option("-s,--save", params.save_path, "Save model to JSON, or binary if .ppf2 (default: model.json)");
     sub->add_flag("--no-save", params.no_save, "Skip saving the model (for benchmarking)");
     sub->add_flag("--no-metrics", params.no_metrics, "Skip variable importance computation and output");
 
@@ -145,6 +167,10 @@ namespace ppforest2::cli {
         {"seed", *m.seed},
         {"threads", *m.threads},
         {"max_retries", m.max_retries},
+        {"task_cutoff", m.task_cutoff},
+        {"weighted_bootstrap", m.weighted_bootstrap},
+        {"compact_samples", m.compact_samples},
+        {"cache_scatter", m.cache_scatter},
     });
 
     auto [model, ms] = io::measure_time_ms([&] { return Model::train(*spec, x, y); });
@@ -186,6 +212,13 @@ namespace ppforest2::cli {
     // lockstep (per-observation pairings are preserved).
     auto train_result = train_model(data.x, data.y, params, rng);
 
+    // Scheduling telemetry varies run to run, so it is shown but never saved.
+    json schedule_json;
+
+    if (auto const* forest = dynamic_cast<Forest const*>(train_result.model.get())) {
+      schedule_json = forest->schedule.to_json();
+    }
+
     serialization::Export<Model::Ptr> model_export{
         std::move(train_result.model),
         data.group_names,
@@ -209,10 +242,18 @@ namespace ppforest2::cli {
 
     // Save model
     if (!params.save_path.empty()) {
-      io::json::write_file(model_json, params.save_path, user_error);
+      if (serialization::binary::has_extension(params.save_path)) {
+        io::binary::write_file(*model_export.model, model_json, params.save_path, user_error);
+      } else {
+        io::json::write_file(model_json, params.save_path, user_error);
+      }
       model_json["save_path"] = params.save_path;
     }
 
+    if (!schedule_json.is_null()) {
+      model_json["training_schedule"] = schedule_json;
+    }
+
     io::ConfigDisplayHints hints;
     hints.vars_percent    = params.model.size > 0 && params.model.p_vars ? *params.model.p_vars * 100 : -1;
     hints.default_vars    = default_vars;
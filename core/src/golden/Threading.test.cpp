@@ -3,14 +3,17 @@
  * @brief Tests that multi-threaded forest training produces identical results.
  *
  * Verifies that the combination of schedule(static) and per-iteration
- * RNG(seed, i) in Forest::train() makes results independent of thread count.
+ * RNG(seed, i) in Forest::train() makes results independent of thread count,
+ * and that parallel prediction (row blocks, OOB trees) does too.
  * Tests SKIP when OpenMP is not available.
  */
 #include <gtest/gtest.h>
 
+#include "models/CompiledForest.hpp"
 #include "models/Forest.hpp"
 #include "models/TrainingSpec.hpp"
 #include "io/IO.hpp"
+#include "stats/Simulation.hpp"
 
 using namespace ppforest2;
 using namespace ppforest2::stats;
@@ -61,3 +64,46 @@ TEST(Threading, ForestSameResultsAcrossRuns) {
   );
   ASSERT_EQ(*f1, *f2) << "Two runs with same seed and thread count should be identical";
 }
+
+TEST(Threading, PredictSameResultsSingleVsMulti) {
+#ifndef _OPENMP
+  GTEST_SKIP() << "OpenMP not available";
+#endif
+
+  RNG rng(0);
+  auto data = simulate(3 * static_cast<int>(CompiledTree::block_rows) + 11, 5, 3, rng);
+
+  auto forest = Forest::train(
+      TrainingSpec::builder(types::Mode::Classification).size(10).threads(1).vars(vars::uniform(2)).build(),
+      data.x,
+      data.y
+  );
+
+  CompiledForest const compiled = CompiledForest::compile(*forest);
+
+  ASSERT_EQ(compiled.predict(data.x, 1), compiled.predict(data.x, 4));
+  ASSERT_EQ(compiled.predict(data.x, Proportions{}, 1), compiled.predict(data.x, Proportions{}, 4));
+  ASSERT_EQ(compiled.trees[0].predict(data.x, 1), compiled.trees[0].predict(data.x, 4));
+}
+
+TEST(Threading, OobPredictSameResultsSingleVsMulti) {
+#ifndef _OPENMP
+  GTEST_SKIP() << "OpenMP not available";
+#endif
+
+  auto data = io::csv::read_sorted(DATA_DIR + "/classification/iris.csv");
+
+  auto f1 = Forest::train(
+      TrainingSpec::builder(types::Mode::Classification).size(10).threads(1).vars(vars::uniform(2)).build(),
+      data.x,
+      data.y
+  );
+  auto f4 = Forest::train(
+      TrainingSpec::builder(types::Mode::Classification).size(10).threads(4).vars(vars::uniform(2)).build(),
+      data.x,
+      data.y
+  );
+
+  ASSERT_EQ(f1->oob_predict(data.x), f4->oob_predict(data.x));
+  ASSERT_EQ(f1->predict(data.x), f4->predict(data.x));
+}
@@ -3,6 +3,7 @@
  * @brief File I/O utilities, JSON and CSV reading/writing.
  */
 #include "io/IO.hpp"
+#include "io/MappedFile.hpp"
 #include "stats/GroupPartition.hpp"
 #include "stats/Stats.hpp"
 #include "utils/UserError.hpp"
@@ -14,7 +15,9 @@
 #include <algorithm>
 #include <filesystem>
 #include <fstream>
+#include <memory>
 #include <numeric>
+#include <optional>
 #include <unordered_map>
 #include <vector>
 
@@ -64,6 +67,28 @@ namespace ppforest2::io::json {
   }
 }
 
+namespace ppforest2::io::binary {
+  void
+  write_file(Model const& model, nlohmann::json const& export_json, std::string const& path, ErrorHandler on_error) {
+    std::ofstream out(path, std::ios::binary);
+
+    on_error(out.is_open(), fmt::format("Could not open file for writing: {}", path));
+
+    serialization::binary::write(out, model, export_json);
+    out.close();
+  }
+
+  serialization::binary::BinaryExport read_file(std::string const& path, ErrorHandler on_error) {
+    try {
+      auto const file = std::make_shared<MappedFile const>(path);
+      return serialization::binary::decode(file, file->data(), file->size());
+    } catch (std::runtime_error const& e) {
+      on_error(false, fmt::format("Invalid binary model file {}: {}", path, e.what()));
+      throw; // unreachable — on_error always throws
+    }
+  }
+}
+
 namespace ppforest2::io::text {
   void write_file(std::string const& content, std::string const& path, ErrorHandler on_error) {
     std::ofstream out(path);
@@ -316,6 +341,152 @@ namespace ppforest2::io::csv {
     return stats::DataPacket(sorted_x, sorted_y, stats::DataPacket::NoGroups{}, feature_names);
   }
 
+  struct ChunkReader::State {
+    types::Mode mode;
+    std::string filename;
+    std::optional<::csv::CSVReader> reader;
+
+    std::vector<std::string> feature_names;
+    std::vector<std::string> group_names;
+    std::unordered_map<std::string, int> label_mapping;
+
+    int n_cols = 0;
+    int n_rows = 0;
+    int row    = 0;
+
+    std::vector<bool> is_categorical;
+    std::vector<CategoricalEncoder> encoders;
+
+    State(std::string const& filename, types::Mode mode)
+        : mode(mode)
+        , filename(filename) {
+      scan();
+      reader.emplace(filename);
+    }
+
+    /**
+     * @brief First pass: validate rows and infer the encoding `read()` uses.
+     *
+     * Only per-column flags and the distinct labels are kept, so memory
+     * does not grow with the number of rows.
+     */
+    void scan() {
+      ::csv::CSVReader scanner(filename);
+      ::csv::CSVRow values;
+      bool const regression = mode == types::Mode::Regression;
+
+      auto col_names = scanner.get_col_names();
+
+      if (!col_names.empty()) {
+        feature_names.assign(col_names.begin(), col_names.end() - 1);
+      }
+
+      while (scanner.read_row(values)) {
+        int const row_num = ++n_rows;
+
+        ppforest2::user_error(
+            values.size() >= 2,
+            fmt::format(
+                "Row {} has only {} column(s) — expected at least 2 (features + {})",
+                row_num,
+                values.size(),
+                regression ? "response" : "label"
+            )
+        );
+
+        if (n_cols == 0) {
+          n_cols = static_cast<int>(values.size());
+          is_categorical.assign(static_cast<std::size_t>(n_cols - 1), false);
+        }
+
+        ppforest2::user_error(
+            static_cast<int>(values.size()) == n_cols,
+            fmt::format("Row {} has {} column(s), expected {} (same as row 1)", row_num, values.size(), n_cols)
+        );
+
+        for (int j = 0; j < n_cols - 1; ++j) {
+          if (!is_categorical[static_cast<std::size_t>(j)] && !is_numeric(values[j].get<std::string>())) {
+            is_categorical[static_cast<std::size_t>(j)] = true;
+          }
+        }
+
+        std::string const label = values[n_cols - 1].get<std::string>();
+
+        if (regression) {
+          ppforest2::user_error(
+              is_numeric(label),
+              fmt::format("Row {} response value '{}' is not numeric (regression mode)", row_num, label)
+          );
+        } else if (label_mapping.try_emplace(label, static_cast<int>(group_names.size())).second) {
+          group_names.push_back(label);
+        }
+      }
+
+      ppforest2::user_error(n_rows > 0, "CSV file is empty or has no data rows");
+
+      encoders.resize(is_categorical.size());
+    }
+  };
+
+  ChunkReader::ChunkReader(std::string const& filename, types::Mode mode)
+      : state(std::make_unique<State>(filename, mode)) {}
+
+  ChunkReader::~ChunkReader() = default;
+
+  bool ChunkReader::next(stats::DataPacket& chunk, int max_rows) {
+    invariant(max_rows > 0, "ChunkReader::next: max_rows must be positive");
+
+    int const n_features = state->n_cols - 1;
+    int const remaining  = state->n_rows - state->row;
+    int const n          = std::min(max_rows, remaining);
+
+    if (n == 0) {
+      return false;
+    }
+
+    chunk.x.resize(n, n_features);
+    chunk.y.resize(n);
+
+    ::csv::CSVRow values;
+
+    for (int i = 0; i < n; ++i) {
+      invariant(state->reader->read_row(values), "ChunkReader::next: file changed since it was scanned");
+
+      for (int j = 0; j < n_features; ++j) {
+        std::string const val = values[j].get<std::string>();
+
+        if (state->is_categorical[static_cast<std::size_t>(j)]) {
+          chunk.x(i, j) = state->encoders[static_cast<std::size_t>(j)].encode(val);
+        } else {
+          chunk.x(i, j) = std::stof(val);
+        }
+      }
+
+      std::string const label = values[n_features].get<std::string>();
+
+      if (state->mode == types::Mode::Regression) {
+        chunk.y(i) = std::stof(label);
+      } else {
+        chunk.y(i) = static_cast<types::Outcome>(state->label_mapping.at(label));
+      }
+    }
+
+    state->row += n;
+    return true;
+  }
+
+  int ChunkReader::rows() const {
+    return state->n_rows;
+  }
+
+  std::vector<std::string> const& ChunkReader::group_names() const {
+    return state->group_names;
+  }
+
+  std::vector<std::string> const& ChunkReader::feature_names() const {
+    return state->feature_names;
+  }
+
   void write(stats::DataPacket const& data, std::string const& filename) {
     std::ofstream out(filename);
 
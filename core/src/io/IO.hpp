@@ -4,13 +4,17 @@
  */
 #pragma once
 
+#include "models/Model.hpp"
+#include "serialization/Binary.hpp"
 #include "stats/DataPacket.hpp"
 #include "utils/Types.hpp"
 
 #include "utils/Invariant.hpp"
 
 #include <nlohmann/json.hpp>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace ppforest2::io {
   /**
@@ -64,6 +68,33 @@ namespace ppforest2::io::json {
   void write_file(nlohmann::json const& data, std::string const& path, ErrorHandler on_error = invariant);
 }
 
+namespace ppforest2::io::binary {
+  using ErrorHandler = void (*)(bool, std::string const&);
+
+  /**
+   * @brief Write @p model in the binary model format (see `serialization::binary`).
+   * @param model        The trained tree or forest.
+   * @param export_json  Export metadata; its node graph is not stored.
+   * @param path         The output file path.
+   * @param on_error     Error handler for file failures.
+   */
+  void write_file(
+      Model const& model, nlohmann::json const& export_json, std::string const& path, ErrorHandler on_error = invariant
+  );
+
+  /**
+   * @brief Memory-map a binary model file and decode it.
+   *
+   * The returned trees read their arrays straight from the mapping, which
+   * stays open as long as the export or any copy of its `model` is alive;
+   * no JSON DOM of the trees is built.
+   *
+   * @param path     The input file path.
+   * @param on_error Error handler for open / format failures.
+   */
+  serialization::binary::BinaryExport read_file(std::string const& path, ErrorHandler on_error = invariant);
+}
+
 namespace ppforest2::io::text {
   using ErrorHandler = void (*)(bool, std::string const&);
 
@@ -119,6 +150,64 @@ namespace ppforest2::io::csv {
    */
   stats::DataPacket read_regression_sorted(std::string const& filename);
 
+  /**
+   * @brief Read a CSV file in fixed-size row chunks, in file order.
+   *
+   * For files too large to hold in memory. The constructor makes one
+   * streaming pass to validate the rows and find what `read()` would
+   * infer from the whole file — categorical feature columns and, for
+   * classification, the label codes in order of first appearance — without
+   * keeping any rows. `next()` then parses the file a second time, one
+   * chunk at a time, so every chunk is encoded exactly as the matching
+   * rows of `read()` (classification) or `read_regression_sorted()`
+   * (regression) would be, but rows are never reordered.
+   *
+   * @code
+   *   csv::ChunkReader reader("big.csv", types::Mode::Classification);
+   *   stats::DataPacket chunk;
+   *
+   *   while (reader.next(chunk, 10000)) {
+   *     auto preds = model.predict(chunk.x);
+   *   }
+   * @endcode
+   */
+  class ChunkReader {
+  public:
+    /**
+     * @param filename Path to the CSV file (last column is the response).
+     * @param mode     Classification reads string labels; regression a numeric response.
+     * @throws UserError If the file is empty or has malformed rows.
+     */
+    ChunkReader(std::string const& filename, types::Mode mode);
+    ~ChunkReader();
+
+    ChunkReader(ChunkReader const&)            = delete;
+    ChunkReader& operator=(ChunkReader const&) = delete;
+
+    /**
+     * @brief Read up to @p max_rows rows into `chunk.x` and `chunk.y`.
+     *
+     * The chunk's matrices are reused when already the right size. Other
+     * fields are left untouched; use `group_names()` / `feature_names()`.
+     *
+     * @return false once the file is exhausted (and no rows were read).
+     */
+    bool next(stats::DataPacket& chunk, int max_rows);
+
+    /** @brief Number of data rows in the file. */
+    int rows() const;
+
+    /** @brief Label names indexed by code (classification; empty for regression). */
+    std::vector<std::string> const& group_names() const;
+
+    /** @brief Feature column names from the header. */
+    std::vector<std::string> const& feature_names() const;
+
+  private:
+    struct State;
+    std::unique_ptr<State> state;
+  };
+
   /**
    * @brief Write a DataPacket to a CSV file (features followed by label, no header).
    * @param data The DataPacket to write.
@@ -121,6 +121,72 @@ TEST(CSVReadTest, CrabsDatasetWithCategoricalSex) {
   }
 }
 
+// ---------------------------------------------------------------------------
+// Chunked reading — io::csv::ChunkReader
+// ---------------------------------------------------------------------------
+
+/* Chunks concatenate to exactly what read() returns, categorical columns included. */
+TEST(CSVChunkReaderTest, MatchesFullRead) {
+  std::string const path = PPFOREST2_DATA_DIR "/classification/crabs.csv";
+  auto const full        = io::csv::read(path);
+
+  io::csv::ChunkReader reader(path, types::Mode::Classification);
+  stats::DataPacket chunk;
+  int row    = 0;
+  int chunks = 0;
+
+  while (reader.next(chunk, 7)) {
+    ASSERT_LE(chunk.x.rows(), 7);
+    ASSERT_EQ(full.x.middleRows(row, chunk.x.rows()), chunk.x);
+    ASSERT_EQ(full.y.segment(row, chunk.y.size()), chunk.y);
+    row += static_cast<int>(chunk.x.rows());
+    ++chunks;
+  }
+
+  EXPECT_EQ(row, 200);
+  EXPECT_EQ(reader.rows(), 200);
+  EXPECT_EQ(chunks, 29);
+  EXPECT_EQ(reader.group_names(), full.group_names);
+  EXPECT_EQ(reader.feature_names(), full.feature_names);
+}
+
+/* Regression chunks keep the file order (no sorting by response). */
+TEST(CSVChunkReaderTest, RegressionKeepsFileOrder) {
+  io::TempFile tmp(".csv");
+  write_csv(tmp.path(), "a,b,y\n1.0,2.0,3.5\n3.0,4.0,-1.0\n5.0,6.0,2.0\n");
+
+  io::csv::ChunkReader reader(tmp.path(), types::Mode::Regression);
+  stats::DataPacket chunk;
+
+  ASSERT_TRUE(reader.next(chunk, 2));
+  EXPECT_EQ(chunk.x.rows(), 2);
+  EXPECT_FLOAT_EQ(chunk.y(0), 3.5F);
+  EXPECT_FLOAT_EQ(chunk.y(1), -1.0F);
+
+  ASSERT_TRUE(reader.next(chunk, 2));
+  EXPECT_EQ(chunk.x.rows(), 1);
+  EXPECT_FLOAT_EQ(chunk.x(0, 1), 6.0F);
+  EXPECT_FLOAT_EQ(chunk.y(0), 2.0F);
+
+  EXPECT_FALSE(reader.next(chunk, 2));
+  EXPECT_TRUE(reader.group_names().empty());
+}
+
+/* Malformed files are rejected up front, before any chunk is read. */
+TEST(CSVChunkReaderTest, RejectsMalformedFiles) {
+  io::TempFile empty(".csv");
+  write_csv(empty.path(), "a,label\n");
+  EXPECT_THROW(io::csv::ChunkReader(empty.path(), types::Mode::Classification), UserError);
+
+  io::TempFile ragged(".csv");
+  write_csv(ragged.path(), "a,b,label\n1.0,2.0,x\n3.0,y\n");
+  EXPECT_THROW(io::csv::ChunkReader(ragged.path(), types::Mode::Classification), UserError);
+
+  io::TempFile labels(".csv");
+  write_csv(labels.path(), "a,y\n1.0,2.0\n3.0,high\n");
+  EXPECT_THROW(io::csv::ChunkReader(labels.path(), types::Mode::Regression), UserError);
+}
+
 // ---------------------------------------------------------------------------
 // File helpers — io::json::ensure_extension, check_*_not_exists
 // ---------------------------------------------------------------------------
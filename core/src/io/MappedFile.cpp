@@ -0,0 +1,80 @@
+/**
+ * @file MappedFile.cpp
+ * @brief Read-only memory mapping of a whole file.
+ */
+#include "io/MappedFile.hpp"
+
+#include <fmt/format.h>
+
+#include <fstream>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ppforest2::io {
+  MappedFile::MappedFile(std::string const& path) {
+    // clang-format off
+    #ifdef _WIN32
+    std::ifstream in(path, std::ios::binary);
+
+    if (!in.is_open()) {
+      throw std::runtime_error(fmt::format("Could not open file: {}", path));
+    }
+
+    in.seekg(0, std::ios::end);
+    buffer.resize(static_cast<std::size_t>(in.tellg()));
+    in.seekg(0, std::ios::beg);
+    in.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+
+    bytes  = buffer.data();
+    length = buffer.size();
+    #else
+    int const fd = ::open(path.c_str(), O_RDONLY);
+
+    if (fd < 0) {
+      throw std::runtime_error(fmt::format("Could not open file: {}", path));
+    }
+
+    struct stat info {};
+
+    if (::fstat(fd, &info) != 0) {
+      ::close(fd);
+      throw std::runtime_error(fmt::format("Could not stat file: {}", path));
+    }
+
+    length = static_cast<std::size_t>(info.st_size);
+
+    // mmap rejects zero-length mappings; an empty file is simply no bytes.
+    if (length > 0) {
+      void* const address = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+
+      if (address == MAP_FAILED) {
+        ::close(fd);
+        throw std::runtime_error(fmt::format("Could not map file: {}", path));
+      }
+
+      bytes  = static_cast<std::byte const*>(address);
+      mapped = true;
+    }
+
+    // The mapping keeps its own reference to the file.
+    ::close(fd);
+    #endif
+    // clang-format on
+  }
+
+  MappedFile::~MappedFile() {
+    // clang-format off
+    #ifndef _WIN32
+    if (mapped) {
+      ::munmap(const_cast<std::byte*>(bytes), length);
+    }
+    #endif
+    // clang-format on
+  }
+}
@@ -0,0 +1,43 @@
+/**
+ * @file MappedFile.hpp
+ * @brief Read-only memory mapping of a whole file.
+ */
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace ppforest2::io {
+  /**
+   * @brief RAII read-only view of a file's bytes.
+   *
+   * Maps the file with `mmap` on POSIX systems, so pages are faulted in on
+   * demand straight from the page cache and nothing is copied up front.
+   * On Windows the file is read into an owned buffer instead. Either way
+   * `data()` / `size()` stay valid until the object is destroyed.
+   *
+   * @code
+   *   auto const file = std::make_shared<io::MappedFile const>("model.ppf2");
+   *   auto model      = serialization::binary::decode(file, file->data(), file->size());
+   * @endcode
+   */
+  class MappedFile {
+  public:
+    /** @brief Map @p path. Throws `std::runtime_error` if it cannot be opened. */
+    explicit MappedFile(std::string const& path);
+    ~MappedFile();
+
+    MappedFile(MappedFile const&)            = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+
+    std::byte const* data() const { return bytes; }
+    std::size_t size() const { return length; }
+
+  private:
+    std::byte const* bytes = nullptr;
+    std::size_t length     = 0;
+    bool mapped            = false;
+    std::vector<std::byte> buffer;
+  };
+}
@@ -465,6 +465,47 @@ namespace ppforest2::io {
     out.newline();
   }
 
+  void print_thread_load(Output& out, nlohmann::json const& schedule) {
+    using namespace style;
+    using namespace layout;
+
+    std::vector<Column> const columns = {
+        {"Thread", 8, Align::left},
+        {"Busy (ms)", 12, Align::right},
+        {"Idle (ms)", 12, Align::right},
+        {"Trees", 8, Align::right},
+    };
+
+    out.println("{}", emphasis("Thread load"));
+    out.newline();
+
+    out.println("{}", format_row(columns, header_labels(columns)));
+    out.println("{}", muted(format_separator(columns)));
+
+    auto const& threads = schedule["threads"];
+
+    for (std::size_t t = 0; t < threads.size(); ++t) {
+      out.println(
+          "{}",
+          format_row(
+              columns,
+              {std::to_string(t),
+               fmt::format("{:.1f}", threads[t]["busy_ms"].get<double>()),
+               fmt::format("{:.1f}", threads[t]["idle_ms"].get<double>()),
+               std::to_string(threads[t]["units"].get<int>())}
+          )
+      );
+    }
+
+    out.newline();
+    out.println(
+        "Wall time {:.1f}ms, {} degenerate tree retries",
+        schedule["wall_ms"].get<double>(),
+        schedule["retries"].get<int>()
+    );
+    out.newline();
+  }
+
   void print_summary(Output& out, nlohmann::json const& model_data, ConfigDisplayHints const& hints) {
     using namespace style;
 
@@ -504,6 +545,10 @@ namespace ppforest2::io {
       out.newline();
     }
 
+    if (model_data.contains("training_schedule") && model_data["training_schedule"]["threads"].size() > 1) {
+      print_thread_load(out, model_data["training_schedule"]);
+    }
+
     bool const is_degenerate = model_data.contains("model") && model_data["model"].value("degenerate", false);
 
     if (is_degenerate) {
@@ -100,6 +100,14 @@ namespace ppforest2::io {
    */
   void print_data_summary(Output& out, nlohmann::json const& meta);
 
+  /**
+   * @brief Print per-thread busy/idle times of a forest's training run.
+   *
+   * @param out      Output context.
+   * @param schedule The `ScheduleReport` JSON (wall_ms, retries, threads).
+   */
+  void print_thread_load(Output& out, nlohmann::json const& schedule);
+
   /**
    * @brief Display a full model summary from its JSON representation.
    *
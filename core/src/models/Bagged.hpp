@@ -1,11 +1,13 @@
 #pragma once
 
+#include "models/Bootstrap.hpp"
 #include "utils/Types.hpp"
 
 #include <Eigen/Dense>
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <memory>
-#include <set>
 #include <vector>
 
 namespace ppforest2 {
@@ -33,13 +35,57 @@ namespace ppforest2 {
 
     /** @brief The bootstrap-trained model. */
     std::unique_ptr<M> model;
-    /** @brief Row indices (into the original training set) used to train `model`. */
+    /**
+     * @brief Row indices (into the original training set) used to train `model`.
+     *
+     * Empty when the bag only keeps its stream (see `bootstrap`); use
+     * `sample()` to read the indices either way.
+     */
     std::vector<int> sample_indices;
 
+    /**
+     * @brief Draws the sample again from `stream` instead of storing it.
+     *
+     * Shared by every tree of a forest. Null when `sample_indices` is kept.
+     */
+    Bootstrap::Ptr bootstrap;
+    /** @brief RNG stream the bag was trained from; meaningful only with `bootstrap`. */
+    std::uint64_t stream = 0;
+
     Bagged(std::unique_ptr<M> model, std::vector<int> sample_indices)
         : model(std::move(model))
         , sample_indices(std::move(sample_indices)) {}
 
+    Bagged(std::unique_ptr<M> model, Bootstrap::Ptr bootstrap, std::uint64_t stream)
+        : model(std::move(model))
+        , bootstrap(std::move(bootstrap))
+        , stream(stream) {}
+
+    /** @brief Row indices the model was trained on, drawn again when not stored. */
+    std::vector<int> sample() const { return bootstrap ? bootstrap->draw(stream) : sample_indices; }
+
+    /**
+     * @brief The bag's rows as a bitmap over `[0, n_total)`.
+     *
+     * Built on first use and kept, so repeated OOB queries pay for the
+     * sample once. Safe to call concurrently; racing callers may each
+     * build the bitmap, and one of them is kept.
+     *
+     * The kept bitmap is keyed on @p n_total alone: a bag's sample is
+     * fixed once it is built, so `sample_indices`, `bootstrap` and
+     * `stream` must not be reassigned after the first call.
+     */
+    InBag::Ptr in_bag(int n_total) const {
+      InBag::Ptr cached = std::atomic_load(&in_bag_cache);
+
+      if (!cached || cached->rows != n_total) {
+        cached = std::make_shared<InBag const>(sample(), n_total);
+        std::atomic_store(&in_bag_cache, cached);
+      }
+
+      return cached;
+    }
+
     /** @brief Delegate single-row prediction to the wrapped model. */
     types::Outcome predict(types::FeatureVector const& x) const { return this->model->predict(x); }
 
@@ -49,22 +95,12 @@ namespace ppforest2 {
     /**
      * @brief Row indices of training observations *not* in the bootstrap sample.
      *
-     * Builds a set-based complement against `sample_indices` and returns
-     * the sorted out-of-bag row indices in `[0, n_total)`.
+     * Reads the complement off the `in_bag` bitmap and returns the sorted
+     * out-of-bag row indices in `[0, n_total)`.
      *
      * @param n_total  Total number of training observations.
      */
-    std::vector<int> oob_indices(int n_total) const {
-      std::set<int> const in_bag(sample_indices.begin(), sample_indices.end());
-      std::vector<int> oob;
-      oob.reserve(static_cast<std::size_t>(std::max(0, n_total - static_cast<int>(in_bag.size()))));
-      for (int i = 0; i < n_total; ++i) {
-        if (in_bag.find(i) == in_bag.end()) {
-          oob.push_back(i);
-        }
-      }
-      return oob;
-    }
+    std::vector<int> oob_indices(int n_total) const { return in_bag(n_total)->out_of_bag(); }
 
     /**
      * @brief Predict a subset of rows (typically OOB indices).
@@ -85,9 +121,10 @@ namespace ppforest2 {
     /**
      * @brief Structural equality on the wrapped model only.
      *
-     * `sample_indices` is **deliberately excluded** from the comparison.
-     * It records which rows were used to train this bag — bookkeeping for
-     * OOB computation, not an identity property of the model. Two bags
+     * `sample_indices` (like `bootstrap` / `stream`) is **deliberately
+     * excluded** from the comparison. It records which rows were used to
+     * train this bag — bookkeeping for OOB computation, not an identity
+     * property of the model. Two bags
      * that would produce the same predictions on every input are equal
      * here, even if they were trained on different bootstrap samples.
      *
@@ -96,5 +133,38 @@ namespace ppforest2 {
      */
     bool operator==(Bagged const& other) const { return *model == *other.model; }
     bool operator!=(Bagged const& other) const { return !(*this == other); }
+
+  private:
+    mutable InBag::Ptr in_bag_cache;
+  };
+
+  /** @brief The distinct rows of a bootstrap sample and how often each was drawn. */
+  struct Draws {
+    std::vector<int> rows;
+    types::WeightVector counts;
   };
+
+  /**
+   * @brief Collapse a sorted bootstrap sample into its distinct rows.
+   *
+   * `rows` keeps the sample's order; `counts(i)` is the number of times
+   * `rows[i]` appears in @p sorted_sample.
+   */
+  inline Draws count_draws(std::vector<int> const& sorted_sample) {
+    Draws draws;
+    std::vector<int> counts;
+
+    for (int const row : sorted_sample) {
+      if (!draws.rows.empty() && draws.rows.back() == row) {
+        counts.back() += 1;
+      } else {
+        draws.rows.push_back(row);
+        counts.push_back(1);
+      }
+    }
+
+    draws.counts = Eigen::Map<types::WeightVector const>(counts.data(), static_cast<Eigen::Index>(counts.size()));
+
+    return draws;
+  }
 }
@@ -0,0 +1,85 @@
+#include "models/Bootstrap.hpp"
+
+#include "stats/Uniform.hpp"
+#include "utils/Invariant.hpp"
+#include "utils/JsonReader.hpp"
+
+#include <algorithm>
+
+namespace ppforest2 {
+  std::vector<int> Bootstrap::draw(stats::RNG& rng) const {
+    std::vector<int> indices;
+    indices.reserve(static_cast<std::size_t>(rows()));
+
+    for (Stratum const& stratum : strata) {
+      stats::Uniform const unif(stratum.start, stratum.start + stratum.size - 1);
+
+      for (int j = 0; j < stratum.size; ++j) {
+        indices.push_back(unif(rng));
+      }
+    }
+
+    std::sort(indices.begin(), indices.end());
+    return indices;
+  }
+
+  std::vector<int> Bootstrap::draw(std::uint64_t stream) const {
+    stats::RNG rng(static_cast<std::uint64_t>(seed), stream);
+    return draw(rng);
+  }
+
+  int Bootstrap::rows() const {
+    int total = 0;
+
+    for (Stratum const& stratum : strata) {
+      total += stratum.size;
+    }
+
+    return total;
+  }
+
+  nlohmann::json Bootstrap::to_json() const {
+    nlohmann::json j_strata = nlohmann::json::array();
+
+    for (Stratum const& stratum : strata) {
+      j_strata.push_back({stratum.start, stratum.size});
+    }
+
+    return {{"seed", seed}, {"strata", j_strata}};
+  }
+
+  Bootstrap::Ptr Bootstrap::from_json(nlohmann::json const& j) {
+    JsonReader const reader{j, "bootstrap"};
+    reader.only_keys({"seed", "strata"});
+
+    auto bootstrap  = std::make_shared<Bootstrap>();
+    bootstrap->seed = j.at("seed").get<int>();
+
+    for (auto const& stratum : j.at("strata")) {
+      bootstrap->strata.push_back({stratum.at(0).get<int>(), stratum.at(1).get<int>()});
+    }
+
+    return bootstrap;
+  }
+
+  InBag::InBag(std::vector<int> const& sample, int rows)
+      : rows(rows)
+      , words(static_cast<std::size_t>((rows + 63) / 64), 0) {
+    for (int const row : sample) {
+      invariant(row >= 0 && row < rows, "InBag: sample row outside the training rows");
+      words[static_cast<std::size_t>(row) >> 6] |= std::uint64_t{1} << (row & 63);
+    }
+  }
+
+  std::vector<int> InBag::out_of_bag() const {
+    std::vector<int> oob;
+
+    for (int i = 0; i < rows; ++i) {
+      if (!contains(i)) {
+        oob.push_back(i);
+      }
+    }
+
+    return oob;
+  }
+}
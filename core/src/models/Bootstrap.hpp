@@ -0,0 +1,71 @@
+#pragma once
+
+#include "stats/Stats.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace ppforest2 {
+  /**
+   * @brief How a forest draws its bootstrap samples.
+   *
+   * Rows are split into strata (one per class for classification, a
+   * single one for regression), and a sample draws `size` rows uniformly
+   * with replacement from each stratum, in order. A bag's sample is the
+   * first thing drawn from its RNG stream, so the seed, the strata and the
+   * bag's stream id are enough to draw it again: a forest can keep one
+   * `Bootstrap` and a stream per tree instead of every tree's indices.
+   */
+  struct Bootstrap {
+    using Ptr = std::shared_ptr<Bootstrap const>;
+
+    /** @brief The rows `[start, start + size)`, drawn `size` times. */
+    struct Stratum {
+      int start;
+      int size;
+
+      bool operator==(Stratum const& other) const { return start == other.start && size == other.size; }
+    };
+
+    int seed = 0;
+    std::vector<Stratum> strata;
+
+    /** @brief Draw a sample from @p rng, sorted ascending. */
+    std::vector<int> draw(stats::RNG& rng) const;
+
+    /** @brief Draw the sample of the bag trained from stream @p stream of `seed` again. */
+    std::vector<int> draw(std::uint64_t stream) const;
+
+    /** @brief Rows covered by the strata. */
+    int rows() const;
+
+    nlohmann::json to_json() const;
+    static Ptr from_json(nlohmann::json const& j);
+
+    bool operator==(Bootstrap const& other) const { return seed == other.seed && strata == other.strata; }
+  };
+
+  /**
+   * @brief The rows of a bootstrap sample, as one bit per training row.
+   *
+   * Membership tests are a shift and a mask; a bag keeps its bitmap once
+   * built, so repeated out-of-bag queries neither rebuild a set from the
+   * sample nor draw it again.
+   */
+  struct InBag {
+    using Ptr = std::shared_ptr<InBag const>;
+
+    /** @brief Rows `[0, rows)` the bitmap covers; every sampled row must lie in it. */
+    int rows;
+    std::vector<std::uint64_t> words;
+
+    InBag(std::vector<int> const& sample, int rows);
+
+    bool contains(int row) const { return (words[static_cast<std::size_t>(row) >> 6] >> (row & 63)) & 1U; }
+
+    /** @brief Rows of `[0, rows)` not in the sample, ascending. */
+    std::vector<int> out_of_bag() const;
+  };
+}
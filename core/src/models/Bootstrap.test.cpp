@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include "models/Bagged.hpp"
+#include "models/Bootstrap.hpp"
+#include "models/ClassificationForest.hpp"
+#include "models/RegressionForest.hpp"
+#include "models/TrainingSpec.hpp"
+#include "models/strategies/grouping/ByCutpoint.hpp"
+#include "models/strategies/leaf/MeanResponse.hpp"
+#include "models/strategies/stop/MinSize.hpp"
+#include "stats/Simulation.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace ppforest2;
+using namespace ppforest2::stats;
+using namespace ppforest2::types;
+
+TEST(Bootstrap, DrawsEachStratumInOrder) {
+  Bootstrap bootstrap;
+  bootstrap.seed   = 3;
+  bootstrap.strata = {{0, 4}, {4, 6}};
+
+  std::vector<int> const sample = bootstrap.draw(std::uint64_t{5});
+
+  ASSERT_EQ(10u, sample.size());
+  ASSERT_TRUE(std::is_sorted(sample.begin(), sample.end()));
+  EXPECT_EQ(4, std::count_if(sample.begin(), sample.end(), [](int i) { return i < 4; }));
+  EXPECT_EQ(sample, bootstrap.draw(std::uint64_t{5}));
+}
+
+TEST(Bootstrap, JsonRoundTrip) {
+  Bootstrap bootstrap;
+  bootstrap.seed   = 11;
+  bootstrap.strata = {{0, 3}, {3, 5}};
+
+  EXPECT_EQ(bootstrap, *Bootstrap::from_json(bootstrap.to_json()));
+}
+
+TEST(Bootstrap, InBagComplementsTheSample) {
+  InBag const in_bag({0, 0, 2, 65}, 67);
+
+  EXPECT_TRUE(in_bag.contains(0));
+  EXPECT_FALSE(in_bag.contains(1));
+  EXPECT_TRUE(in_bag.contains(65));
+
+  std::vector<int> const oob = in_bag.out_of_bag();
+  EXPECT_EQ(64u, oob.size());
+  EXPECT_EQ(1, oob.front());
+  EXPECT_EQ(66, oob.back());
+}
+
+TEST(Bootstrap, InBagRejectsRowsOutsideTheTrainingRows) {
+  EXPECT_THROW(InBag({0, 70}, 67), std::runtime_error);
+  EXPECT_THROW(InBag({-1}, 67), std::runtime_error);
+}
+
+TEST(Bootstrap, CompactForestsRegenerateTheirSamples) {
+  RNG rng(0);
+  auto data = simulate(90, 4, 3, rng);
+
+  auto const spec = [](bool compact) {
+    return TrainingSpec::builder(Mode::Classification).size(8).seed(4).threads(2).compact_samples(compact).build();
+  };
+
+  auto const stored  = Forest::train(spec(false), data.x, data.y);
+  auto const compact = Forest::train(spec(true), data.x, data.y);
+
+  ASSERT_EQ(*stored, *compact);
+
+  for (std::size_t k = 0; k < stored->trees.size(); ++k) {
+    EXPECT_TRUE(compact->trees[k]->sample_indices.empty());
+    EXPECT_EQ(stored->trees[k]->sample_indices, compact->trees[k]->sample());
+    EXPECT_EQ(stored->trees[k]->oob_indices(90), compact->trees[k]->oob_indices(90));
+  }
+
+  EXPECT_EQ(stored->oob_predict(data.x), compact->oob_predict(data.x));
+  EXPECT_EQ(stored->vi_permuted(data.x, data.y, 1), compact->vi_permuted(data.x, data.y, 1));
+}
+
+TEST(Bootstrap, CompactRegressionForestRegeneratesItsSamples) {
+  RNG rng(1);
+  auto data = simulate_regression(60, 3, rng);
+
+  auto const spec = [](bool compact) {
+    return TrainingSpec::builder(Mode::Regression)
+        .grouping(grouping::by_cutpoint())
+        .leaf(leaf::mean_response())
+        .stop(stop::min_size(5))
+        .size(5)
+        .seed(2)
+        .threads(1)
+        .compact_samples(compact)
+        .build();
+  };
+
+  auto const stored  = Forest::train(spec(false), data.x, data.y);
+  auto const compact = Forest::train(spec(true), data.x, data.y);
+
+  for (std::size_t k = 0; k < stored->trees.size(); ++k) {
+    EXPECT_EQ(stored->trees[k]->sample_indices, compact->trees[k]->sample());
+  }
+
+  // Rows no tree left out are NaN in both.
+  OutcomeVector const stored_oob  = stored->oob_predict(data.x);
+  OutcomeVector const compact_oob = compact->oob_predict(data.x);
+  for (int i = 0; i < stored_oob.size(); ++i) {
+    if (std::isnan(stored_oob(i))) {
+      EXPECT_TRUE(std::isnan(compact_oob(i)));
+    } else {
+      EXPECT_EQ(stored_oob(i), compact_oob(i));
+    }
+  }
+}
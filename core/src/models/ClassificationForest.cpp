@@ -2,6 +2,10 @@
 
 #include "models/Bagged.hpp"
 #include "models/ClassificationTree.hpp"
+#include "models/CompiledForest.hpp"
+#include "models/ForestSchedule.hpp"
+#include "models/TreeBranch.hpp"
+#include "models/TreeLeaf.hpp"
 #include "models/VIVisitor.hpp"
 #include "stats/Stats.hpp"
 #include "stats/Uniform.hpp"
@@ -10,7 +14,6 @@
 
 #include <Eigen/Dense>
 #include <algorithm>
-#include <map>
 #include <set>
 
 #ifdef _OPENMP
@@ -22,29 +25,36 @@ using namespace ppforest2::types;
 
 namespace ppforest2 {
   namespace {
+    /** @brief Collects every leaf value of a tree into a label set. */
+    struct LeafLabels : public TreeNode::Visitor {
+      std::set<GroupId>& labels;
+
+      explicit LeafLabels(std::set<GroupId>& labels)
+          : labels(labels) {}
+
+      void visit(TreeBranch const& node) override {
+        node.lower->accept(*this);
+        node.upper->accept(*this);
+      }
+
+      void visit(TreeLeaf const& node) override { labels.insert(static_cast<GroupId>(node.value)); }
+    };
+
     /**
-     * @brief Stratified per-group sample: draw `group_size(g)` indices
-     *        uniformly from each group `g` in the training data.
+     * @brief Stratified per-group sampling: each bag draws `group_size(g)`
+     *        indices uniformly from each group `g` in the training data.
      *
      * Preserves the class balance across bootstrap replicates.
      */
-    std::vector<int> stratified_sample(FeatureMatrix const& /*x*/, GroupPartition const& y_part, RNG& rng) {
-      std::vector<int> indices;
+    Bootstrap::Ptr stratified_bootstrap(GroupPartition const& y_part, int seed) {
+      auto bootstrap  = std::make_shared<Bootstrap>();
+      bootstrap->seed = seed;
 
       for (auto const& group : y_part.groups) {
-        int const group_size = y_part.group_size(group);
-        int const min_index  = y_part.group_start(group);
-        int const max_index  = y_part.group_end(group);
-
-        Uniform const unif(min_index, max_index);
-
-        for (int j = 0; j < group_size; ++j) {
-          indices.push_back(unif(rng));
-        }
+        bootstrap->strata.push_back({y_part.group_start(group), y_part.group_size(group)});
       }
 
-      std::sort(indices.begin(), indices.end());
-      return indices;
+      return bootstrap;
     }
 
     /**
@@ -59,10 +69,12 @@ namespace ppforest2 {
      */
     BaggedTree::Ptr train_classification_bag(
         TrainingSpec::Ptr const& training_spec,
-        FeatureMatrix const& x,
+        FeatureView const& x,
         OutcomeVector const& y,
         GroupPartition const& y_part,
-        RNG& rng
+        Bootstrap::Ptr const& bootstrap,
+        RNG& rng,
+        std::uint64_t stream
     ) {
       // Reusing the parent's `y_part` over the resampled `sampled_x`
       // only works if the spec's first block starts at row 0 and the
@@ -74,11 +86,48 @@ namespace ppforest2 {
         invariant(y_part.group_start(first) == 0, "classification bag: y_part must start at row 0");
       }
 
-      std::vector<int> sample_indices = stratified_sample(x, y_part, rng);
-      FeatureMatrix sampled_x         = x(sample_indices, Eigen::all);
-      OutcomeVector sampled_y         = y(sample_indices);
+      std::vector<int> sample_indices = bootstrap->draw(rng);
+
+      // Each tree's nodes go to an arena of its own (see `Tree::build_root`):
+      // laid out together and released in one shot with the tree, without
+      // touching the shared heap.
+      ClassificationTree::Ptr tree;
+
+      if (training_spec->weighted_bootstrap) {
+        // The sample is sorted and the label blocks are contiguous, so
+        // the distinct drawn rows still form one block per label, and
+        // their partition is rebuilt from the labels.
+        Draws draws                       = count_draws(sample_indices);
+        OutcomeVector sampled_y           = y(draws.rows);
+        GroupPartition const sampled_part = training_spec->init_groups(sampled_y, draws.counts);
+
+        if (FeatureMatrix const* const matrix = x.matrix()) {
+          // No rows are copied: the tree reads the distinct drawn rows of
+          // the caller's matrix through `draws.rows`, and each node gathers
+          // only its own.
+          tree = ClassificationTree::train(
+              *training_spec, *matrix, sampled_y, sampled_part, rng, &draws.counts, draws.rows
+          );
+        } else {
+          // Other views gather only the distinct drawn rows, converting
+          // from the view's precision as they copy.
+          FeatureMatrix distinct_x = x.gather(draws.rows);
+          tree = ClassificationTree::train(*training_spec, distinct_x, sampled_y, sampled_part, rng, &draws.counts);
+        }
+      } else {
+        // The bag is the only full-width copy of the rows a tree sees;
+        // `gather` converts them from the caller's precision as it copies.
+        FeatureMatrix sampled_x = x.gather(sample_indices);
+        OutcomeVector sampled_y = y(sample_indices);
+
+        tree = ClassificationTree::train(*training_spec, sampled_x, sampled_y, y_part, rng);
+      }
 
-      ClassificationTree::Ptr tree = ClassificationTree::train(*training_spec, sampled_x, sampled_y, y_part, rng);
+      // The sample is the first draw from the bag's stream, so a compact
+      // bag keeps the stream and draws the sample again when asked.
+      if (training_spec->compact_samples) {
+        return std::make_unique<BaggedTree>(std::move(tree), bootstrap, stream);
+      }
 
       return std::make_unique<BaggedTree>(std::move(tree), std::move(sample_indices));
     }
@@ -97,7 +146,7 @@ namespace ppforest2 {
   }
 
   ClassificationForest::Ptr
-  ClassificationForest::train(TrainingSpec const& training_spec, FeatureMatrix const& x, OutcomeVector const& y) {
+  ClassificationForest::train(TrainingSpec const& training_spec, FeatureView const& x, OutcomeVector const& y) {
     invariant(training_spec.mode == Mode::Classification, "ClassificationForest::train requires mode = Classification");
 
     int const size        = training_spec.size;
@@ -112,43 +161,28 @@ namespace ppforest2 {
     #endif
     // clang-format on
 
-    GroupPartition y_part  = training_spec.init_groups(y);
-    TrainingSpec::Ptr spec = TrainingSpec::make(training_spec);
-
-    std::vector<BaggedTree::Ptr> boots(size);
-    std::vector<std::exception_ptr> errors(size);
-
-    // clang-format off
-    #pragma omp parallel for schedule(static)
-    // clang-format on
-    for (int i = 0; i < size; ++i) {
-      for (int attempt = 0; attempt <= max_retries; ++attempt) {
-        try {
-          // See the matching comment in RegressionForest::train: this stream
-          // formula is load-bearing for golden-file reproducibility; don't
-          // change the stride without regenerating every classification
-          // golden and updating both forests in lockstep.
-          uint64_t stream = static_cast<uint64_t>(i) + static_cast<uint64_t>(attempt) * static_cast<uint64_t>(size);
-          RNG rng(static_cast<uint64_t>(seed), stream);
-          boots[i] = train_classification_bag(spec, x, y, y_part, rng);
-
-          if (!boots[i]->degenerate()) {
-            break;
-          }
-        } catch (...) {
-          errors[i] = std::current_exception();
-          break;
-        }
-      }
-    }
+    GroupPartition y_part          = training_spec.init_groups(y);
+    TrainingSpec::Ptr spec         = TrainingSpec::make(training_spec);
+    Bootstrap::Ptr const bootstrap = stratified_bootstrap(y_part, seed);
+
+    ScheduleReport schedule;
+
+    std::vector<BaggedTree::Ptr> boots = train_bags(
+        size,
+        seed,
+        max_retries,
+        training_spec.resolve_threads(),
+        [&](RNG& rng, std::uint64_t stream) {
+          return train_classification_bag(spec, x, y, y_part, bootstrap, rng, stream);
+        },
+        &schedule
+    );
 
     auto forest = std::make_unique<ClassificationForest>(spec);
 
-    for (int i = 0; i < size; ++i) {
-      if (errors[i]) {
-        std::rethrow_exception(errors[i]);
-      }
+    forest->schedule = std::move(schedule);
 
+    for (int i = 0; i < size; ++i) {
       if (boots[i]->degenerate()) {
         forest->degenerate = true;
       }
@@ -159,65 +193,60 @@ namespace ppforest2 {
     return forest;
   }
 
-  Outcome ClassificationForest::predict(FeatureVector const& data) const {
-    // Match RegressionForest::predict(FeatureVector) — an empty forest has
-    // no basis for prediction, and the pre-guard code silently returned
-    // `Outcome(0)` regardless of the input.
-    invariant(!trees.empty(), "Forest has no trees.");
-
-    std::map<GroupId, int> votes_per_group;
+  int ClassificationForest::group_column(GroupId label) const {
+    auto const it = std::lower_bound(groups.begin(), groups.end(), label);
+    return it != groups.end() && *it == label ? static_cast<int>(it - groups.begin()) : -1;
+  }
 
-    for (auto const& tree : trees) {
-      GroupId prediction = static_cast<GroupId>(tree->predict(data));
-      votes_per_group[prediction] += 1;
+  void ClassificationForest::on_tree_added(BaggedTree const& tree) {
+    if (!tree.model || !tree.model->root) {
+      return;
     }
 
-    GroupId best   = 0;
-    int best_count = 0;
+    // Root groups give the training partition's labels (so proportions
+    // keep a column for a group no tree ends up predicting); leaf values
+    // cover hand-built or deserialized trees whose branches carry no
+    // group set. Together they guarantee every vote has a column.
+    std::set<GroupId> labels = tree.model->root->node_groups();
+    LeafLabels collector(labels);
+    tree.model->root->accept(collector);
+
+    for (GroupId const label : labels) {
+      auto const it = std::lower_bound(groups.begin(), groups.end(), label);
 
-    for (auto const& [key, votes] : votes_per_group) {
-      if (votes > best_count) {
-        best       = key;
-        best_count = votes;
+      if (it == groups.end() || *it != label) {
+        groups.insert(it, label);
       }
     }
-
-    return static_cast<Outcome>(best);
   }
 
-  FeatureMatrix ClassificationForest::predict(FeatureMatrix const& data, Proportions) const {
+  Outcome ClassificationForest::predict(FeatureVector const& data) const {
+    // Match RegressionForest::predict(FeatureVector) — an empty forest has
+    // no basis for prediction, and the pre-guard code silently returned
+    // `Outcome(0)` regardless of the input.
     invariant(!trees.empty(), "Forest has no trees.");
 
-    std::set<GroupId> group_set = trees[0]->model->root->node_groups();
-    std::vector<GroupId> groups(group_set.begin(), group_set.end());
-    int const G = static_cast<int>(groups.size());
+    std::vector<int> votes(groups.size(), 0);
 
-    std::map<GroupId, int> group_to_col;
-    for (int g = 0; g < G; ++g) {
-      group_to_col[groups[static_cast<std::size_t>(g)]] = g;
+    for (auto const& tree : trees) {
+      votes[static_cast<std::size_t>(group_column(static_cast<GroupId>(tree->predict(data))))] += 1;
     }
 
-    int const n               = static_cast<int>(data.rows());
-    FeatureMatrix proportions = FeatureMatrix::Zero(n, G);
-
-    for (int i = 0; i < n; ++i) {
-      for (auto const& tree : trees) {
-        GroupId pred = static_cast<GroupId>(tree->predict(static_cast<FeatureVector>(data.row(i))));
-        auto it      = group_to_col.find(pred);
-
-        if (it != group_to_col.end()) {
-          proportions(i, it->second) += 1;
-        }
-      }
-
-      Feature total = proportions.row(i).sum();
+    // Columns ascend by label and only a strictly larger count replaces
+    // the leader, so ties go to the smallest label.
+    int best = 0;
 
-      if (total > 0) {
-        proportions.row(i) /= total;
+    for (int g = 1; g < static_cast<int>(votes.size()); ++g) {
+      if (votes[static_cast<std::size_t>(g)] > votes[static_cast<std::size_t>(best)]) {
+        best = g;
       }
     }
 
-    return proportions;
+    return static_cast<Outcome>(groups[static_cast<std::size_t>(best)]);
+  }
+
+  FeatureMatrix ClassificationForest::predict(FeatureMatrix const& data, Proportions) const {
+    return compiled()->predict(data, Proportions{}, resolve_threads());
   }
 
   OutcomeVector ClassificationForest::oob_predict(FeatureMatrix const& x) const {
@@ -231,44 +260,37 @@ namespace ppforest2 {
     // answer, but "OOB stats over zero trees" is well-defined (the
     // empty average). Mirrors `RegressionForest::oob_predict`.
     int const n_total = static_cast<int>(x.rows());
-    int const B       = static_cast<int>(trees.size());
 
-    // Majority vote of OOB predictions per observation.
-    std::vector<std::map<GroupId, int>> votes(static_cast<std::size_t>(n_total));
+    int const G       = static_cast<int>(groups.size());
 
-    for (int k = 0; k < B; ++k) {
-      BaggedTree const& tree   = *trees[k];
-      std::vector<int> oob_idx = tree.oob_indices(n_total);
-      OutcomeVector preds      = tree.predict_oob(x, oob_idx);
+    // Majority vote of OOB predictions per observation, one dense row of
+    // counters per observation (columns as in `groups`).
+    Matrix<int> votes = Matrix<int>::Zero(n_total, G);
 
+    for_each_oob_prediction(x, [&](int, std::vector<int> const& oob_idx, OutcomeVector const& preds) {
       for (int j = 0; j < static_cast<int>(oob_idx.size()); ++j) {
-        int i = oob_idx[static_cast<std::size_t>(j)];
-        votes[static_cast<std::size_t>(i)][static_cast<GroupId>(preds(j))] += 1;
+        votes(oob_idx[static_cast<std::size_t>(j)], group_column(static_cast<GroupId>(preds(j)))) += 1;
       }
-    }
+    });
 
     // Sentinel -1 for observations with no OOB tree.
     OutcomeVector out(n_total);
     out.fill(-1);
 
     for (int i = 0; i < n_total; ++i) {
-      auto const& obs_votes = votes[static_cast<std::size_t>(i)];
-
-      if (obs_votes.empty()) {
-        continue;
-      }
-
-      GroupId best   = 0;
+      int best       = -1;
       int best_count = 0;
 
-      for (auto const& [cls, cnt] : obs_votes) {
-        if (cnt > best_count) {
-          best       = cls;
-          best_count = cnt;
+      for (int g = 0; g < G; ++g) {
+        if (votes(i, g) > best_count) {
+          best       = g;
+          best_count = votes(i, g);
         }
       }
 
-      out(i) = static_cast<Outcome>(best);
+      if (best >= 0) {
+        out(i) = static_cast<Outcome>(groups[static_cast<std::size_t>(best)]);
+      }
     }
 
     return out;
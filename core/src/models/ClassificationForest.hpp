@@ -3,6 +3,7 @@
 #include "models/Forest.hpp"
 
 #include <optional>
+#include <vector>
 
 namespace ppforest2 {
   /**
@@ -16,13 +17,29 @@ namespace ppforest2 {
   struct ClassificationForest : public Forest {
     using Ptr = std::unique_ptr<ClassificationForest>;
 
+    /**
+     * @brief Sorted class labels predicted by any tree of the forest.
+     *
+     * Fixes the label-to-column mapping used by every aggregation path:
+     * vote column `g` counts votes for `groups[g]`, both in the dense
+     * per-row counters of `predict` / `oob_predict` and in the columns of
+     * `predict(data, Proportions)`. Maintained by `add_tree` as the union
+     * of each tree's root groups and leaf values, so every vote a tree can
+     * cast has a column; for a trained forest it is the group set of the
+     * training partition.
+     */
+    std::vector<types::GroupId> groups;
+
+    /** @brief Column of @p label in `groups`, or `-1` if no tree predicts it. */
+    int group_column(types::GroupId label) const;
+
     ClassificationForest();
     explicit ClassificationForest(TrainingSpec::Ptr training_spec);
 
     // Bring the Forest::predict(FeatureMatrix) overload into scope.
     using Forest::predict;
 
-    static Ptr train(TrainingSpec const& training_spec, types::FeatureMatrix const& x, types::OutcomeVector const& y);
+    static Ptr train(TrainingSpec const& training_spec, types::FeatureView const& x, types::OutcomeVector const& y);
 
     types::Outcome predict(types::FeatureVector const& data) const override;
     types::FeatureMatrix predict(types::FeatureMatrix const& data, Proportions) const override;
@@ -61,5 +78,8 @@ namespace ppforest2 {
     ) const override;
 
     void accept(Model::Visitor& visitor) const override;
+
+  protected:
+    void on_tree_added(BaggedTree const& tree) override;
   };
 }
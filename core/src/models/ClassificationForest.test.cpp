@@ -629,6 +629,23 @@ TEST(ForestSimulation, HighDimensionality) {
   ASSERT_LT(err, 0.20) << "Forest should handle high-dimensional data (p=50)";
 }
 
+TEST(ForestSimulation, ScatterCacheGrowsTheSameTrees) {
+  RNG rng(8);
+  auto data = simulate(400, 6, 4, rng);
+
+  auto const spec_for = [](bool cache) {
+    return TrainingSpec::builder(types::Mode::Classification).size(10).seed(3).threads(2).cache_scatter(cache).build();
+  };
+
+  auto const rows   = Forest::train(spec_for(false), data.x, data.y);
+  auto const cached = Forest::train(spec_for(true), data.x, data.y);
+
+  // Cached and row-wise scatter agree up to rounding, which leaves every
+  // split and leaf of these well-conditioned trees in place.
+  ASSERT_EQ(*rows, *cached);
+  ASSERT_EQ(rows->predict(data.x), cached->predict(data.x));
+}
+
 TEST(ForestSimulation, Deterministic) {
   RNG rng(0);
   auto data = simulate(90, 4, 3, rng);
@@ -649,6 +666,53 @@ TEST(ForestSimulation, Deterministic) {
   ASSERT_EQ(f1, f2) << "Same seed should produce identical forests";
 }
 
+TEST(ForestSimulation, WeightedBootstrapMatchesExpandedBags) {
+  RNG rng(0);
+  auto data = simulate(90, 4, 3, rng);
+
+  auto const spec = [](bool weighted) {
+    return TrainingSpec::builder(types::Mode::Classification)
+        .size(10)
+        .threads(1)
+        .vars(vars::uniform(2))
+        .weighted_bootstrap(weighted)
+        .build();
+  };
+
+  auto const expanded = Forest::train(spec(false), data.x, data.y);
+  auto const weighted = Forest::train(spec(true), data.x, data.y);
+
+  // Same draws, so each bag sees the same rows, once each instead of with
+  // duplicates; the trees agree up to rounding.
+  ASSERT_EQ(*expanded, *weighted);
+
+  for (std::size_t k = 0; k < expanded->trees.size(); ++k) {
+    ASSERT_EQ(expanded->trees[k]->sample_indices, weighted->trees[k]->sample_indices);
+  }
+
+  auto const& expanded_forest = dynamic_cast<ClassificationForest const&>(*expanded);
+  auto const& weighted_forest = dynamic_cast<ClassificationForest const&>(*weighted);
+  EXPECT_EQ(expanded_forest.predict(data.x), weighted_forest.predict(data.x));
+}
+
+TEST(ForestSimulation, WeightedBootstrapReadsCallerRows) {
+  RNG rng(1);
+  auto data                    = simulate(90, 4, 3, rng);
+  FeatureMatrix const original = data.x;
+
+  auto const spec =
+      TrainingSpec::builder(types::Mode::Classification).size(6).threads(2).weighted_bootstrap(true).build();
+
+  // Trees read the caller's matrix in place; over a double view each bag
+  // gathers its distinct drawn rows and trains the same forest.
+  Eigen::MatrixXd const x_double = data.x.cast<double>();
+  auto const from_matrix         = Forest::train(spec, data.x, data.y);
+  auto const from_doubles = Forest::train(spec, FeatureView(x_double.data(), x_double.rows(), x_double.cols()), data.y);
+
+  EXPECT_EQ(original, data.x);
+  EXPECT_EQ(from_matrix->predict(data.x), from_doubles->predict(data.x));
+}
+
 TEST(ForestSimulation, PDAOnOverlappingData) {
   RNG rng(0);
   SimulationParams params;
@@ -784,6 +848,40 @@ TEST(Forest, PredictBatch) {
   ASSERT_EQ(expected, result);
 }
 
+TEST(Forest, GroupsCoverEveryLeafLabel) {
+  ClassificationForest const forest = build_three_group_forest();
+
+  ASSERT_EQ((std::vector<GroupId>{0, 1, 2}), forest.groups);
+  ASSERT_EQ(0, forest.group_column(0));
+  ASSERT_EQ(2, forest.group_column(2));
+  ASSERT_EQ(-1, forest.group_column(7));
+}
+
+TEST(Forest, GroupsFromTrainingPartition) {
+  RNG rng(0);
+  auto data = simulate(90, 4, 3, rng);
+
+  auto forest_ptr = Forest::train(
+      TrainingSpec::builder(types::Mode::Classification).size(5).seed(0).vars(vars::uniform(2)).build(), data.x, data.y
+  );
+  auto const& forest = dynamic_cast<ClassificationForest const&>(*forest_ptr);
+
+  ASSERT_EQ((std::vector<GroupId>{0, 1, 2}), forest.groups);
+}
+
+TEST(Forest, VoteTieGoesToSmallestLabel) {
+  ClassificationForest forest;
+
+  for (GroupId label : {2, 1}) {
+    forest.add_tree(std::make_unique<BaggedTree>(
+        std::make_unique<ClassificationTree>(TreeLeaf::make(label), test::classification_spec()), std::vector<int>{}
+    ));
+  }
+
+  ASSERT_EQ(1, forest.predict(VEC(Feature, 0, 0)));
+  ASSERT_EQ(VEC(Outcome, 1), forest.predict(MAT(Feature, rows(1), 0, 0)));
+}
+
 // ---------------------------------------------------------------------------
 // OOB error
 // ---------------------------------------------------------------------------
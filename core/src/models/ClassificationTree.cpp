@@ -28,13 +28,36 @@ namespace ppforest2 {
       FeatureMatrix& x,
       OutcomeVector& y,
       GroupPartition const& y_part,
-      stats::RNG& rng
+      stats::RNG& rng,
+      WeightVector* weights
   ) {
     invariant(training_spec.mode == Mode::Classification, "ClassificationTree::train requires mode = Classification");
 
-    TreeNode::Ptr root_ptr = Tree::build_root(training_spec, x, y, y_part, rng);
+    Nodes nodes = Tree::build_root(training_spec, x, y, y_part, rng, weights);
 
-    return std::make_unique<ClassificationTree>(std::move(root_ptr), TrainingSpec::make(training_spec));
+    auto tree   = std::make_unique<ClassificationTree>(std::move(nodes.root), TrainingSpec::make(training_spec));
+    tree->arena = std::move(nodes.arena);
+
+    return tree;
+  }
+
+  ClassificationTree::Ptr ClassificationTree::train(
+      TrainingSpec const& training_spec,
+      FeatureMatrix const& x,
+      OutcomeVector& y,
+      GroupPartition const& y_part,
+      stats::RNG& rng,
+      WeightVector* weights,
+      std::vector<int>& source_rows
+  ) {
+    invariant(training_spec.mode == Mode::Classification, "ClassificationTree::train requires mode = Classification");
+
+    Nodes nodes = Tree::build_root(training_spec, x, y, y_part, rng, weights, source_rows);
+
+    auto tree   = std::make_unique<ClassificationTree>(std::move(nodes.root), TrainingSpec::make(training_spec));
+    tree->arena = std::move(nodes.arena);
+
+    return tree;
   }
 
   FeatureMatrix ClassificationTree::predict(FeatureMatrix const& data, Proportions) const {
@@ -50,9 +73,10 @@ namespace ppforest2 {
     int const n               = static_cast<int>(data.rows());
     FeatureMatrix proportions = FeatureMatrix::Zero(n, G);
 
+    OutcomeVector const preds = Tree::predict(data);
+
     for (int i = 0; i < n; ++i) {
-      Outcome const pred                                       = Tree::predict(static_cast<FeatureVector>(data.row(i)));
-      proportions(i, group_to_col[static_cast<GroupId>(pred)]) = Feature(1);
+      proportions(i, group_to_col[static_cast<GroupId>(preds(i))]) = Feature(1);
     }
 
     return proportions;
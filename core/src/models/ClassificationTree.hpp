@@ -30,13 +30,32 @@ namespace ppforest2 {
      * @param y              Response vector (integer class labels encoded as floats).
      * @param y_part     Initial root group partition.
      * @param rng            Random number generator.
+     * @param weights        Bootstrap count per row, or null for unit weights.
      */
     static Ptr train(
         TrainingSpec const& training_spec,
         types::FeatureMatrix& x,
         types::OutcomeVector& y,
         stats::GroupPartition const& y_part,
-        stats::RNG& rng
+        stats::RNG& rng,
+        types::WeightVector* weights = nullptr
+    );
+
+    /**
+     * @brief Train on rows @p source_rows of a read-only @p x.
+     *
+     * Training row `i` is row `source_rows[i]` of @p x; @p y and
+     * @p weights are indexed by training row. @p x is never written
+     * (see `Tree::build_root`).
+     */
+    static Ptr train(
+        TrainingSpec const& training_spec,
+        types::FeatureMatrix const& x,
+        types::OutcomeVector& y,
+        stats::GroupPartition const& y_part,
+        stats::RNG& rng,
+        types::WeightVector* weights,
+        std::vector<int>& source_rows
     );
 
     /** @brief One-hot encoding of the predicted group per row. */
@@ -3,12 +3,15 @@
 
 #include "models/Tree.hpp"
 #include "models/ClassificationTree.hpp"
+#include "models/CompiledTree.hpp"
+#include "models/NodeArena.hpp"
 #include "models/TreeBranch.hpp"
 #include "models/TreeLeaf.hpp"
 
 #include "models/TrainingSpec.hpp"
 #include "TestSpec.hpp"
 
+#include "stats/ScatterCache.hpp"
 #include "stats/Simulation.hpp"
 #include "stats/Stats.hpp"
 #include "utils/Macros.hpp"
@@ -850,3 +853,106 @@ TEST(TreeEdgeCase, ExtremeImbalance) {
 
   ASSERT_EQ_DATA(tree->predict(x), y.cast<Outcome>());
 }
+
+TEST(TreeTasks, SameTreeForAnyCutoffAndThreadCount) {
+  RNG rng(0);
+  auto data = simulate(300, 5, 4, rng);
+
+  auto const spec_for = [](int cutoff, int threads) {
+    return TrainingSpec::builder(Mode::Classification)
+        .vars(vars::uniform(3))
+        .seed(7)
+        .task_cutoff(cutoff)
+        .threads(threads)
+        .build();
+  };
+
+  auto const expected = Tree::train(spec_for(10000, 1), data.x, data.y);
+
+  for (int const threads : {1, 4}) {
+    for (int const cutoff : {1, 20, 100}) {
+      auto const actual = Tree::train(spec_for(cutoff, threads), data.x, data.y);
+      ASSERT_EQ(*expected, *actual) << "cutoff " << cutoff << ", threads " << threads;
+    }
+  }
+}
+
+TEST(TreeTasks, SubtreesUseTheRootsScatterCacheDecision) {
+  RNG rng(3);
+  auto data = simulate(100, 470, 10, rng);
+
+  // 10 label blocks over 470 columns exceed the scatter cache's budget,
+  // while any subtree below the root (at most 9 groups) would fit.
+  ASSERT_FALSE(ScatterCache::fits(10, 470));
+  ASSERT_TRUE(ScatterCache::fits(9, 470));
+
+  auto const spec_for = [](int cutoff, int threads) {
+    return TrainingSpec::builder(Mode::Classification)
+        .pp(pp::pda(Feature(0)))
+        .vars(vars::uniform(3))
+        .seed(5)
+        .task_cutoff(cutoff)
+        .threads(threads)
+        .cache_scatter(true)
+        .build();
+  };
+
+  // Bit-for-bit: cached and uncached scatter agree only up to rounding,
+  // which the tree's structural equality would not notice.
+  CompiledTree const expected = CompiledTree::compile(*Tree::train(spec_for(10000, 1), data.x, data.y)->root);
+
+  for (int const threads : {1, 4}) {
+    CompiledTree const actual = CompiledTree::compile(*Tree::train(spec_for(1, threads), data.x, data.y)->root);
+
+    ASSERT_EQ(expected.cutpoints, actual.cutpoints) << "threads " << threads;
+    ASSERT_EQ(expected.dense_coefficients, actual.dense_coefficients) << "threads " << threads;
+    ASSERT_EQ(expected.leaves, actual.leaves) << "threads " << threads;
+  }
+}
+
+TEST(TreeTasks, TasksShareTheTreesScatterCache) {
+  RNG rng(4);
+  auto data = simulate(300, 6, 4, rng);
+
+  auto const spec_for = [](int cutoff, int threads) {
+    return TrainingSpec::builder(Mode::Classification)
+        .pp(pp::pda(Feature(0.5)))
+        .vars(vars::uniform(3))
+        .seed(2)
+        .task_cutoff(cutoff)
+        .threads(threads)
+        .cache_scatter(true)
+        .build();
+  };
+
+  CompiledTree const expected = CompiledTree::compile(*Tree::train(spec_for(10000, 1), data.x, data.y)->root);
+
+  for (int const threads : {1, 4}) {
+    CompiledTree const actual = CompiledTree::compile(*Tree::train(spec_for(1, threads), data.x, data.y)->root);
+
+    ASSERT_EQ(expected.cutpoints, actual.cutpoints) << "threads " << threads;
+    ASSERT_EQ(expected.dense_coefficients, actual.dense_coefficients) << "threads " << threads;
+    ASSERT_EQ(expected.leaves, actual.leaves) << "threads " << threads;
+  }
+}
+
+TEST(TreeTasks, TasksBuildIntoTheTreeArena) {
+  RNG rng(1);
+  auto data = simulate(200, 4, 3, rng);
+
+  auto const spec = TrainingSpec::builder(Mode::Classification).seed(3).task_cutoff(1).threads(4).build();
+
+  auto const expected = Tree::train(spec, data.x, data.y);
+
+  auto arena = std::make_unique<NodeArena>();
+  Tree::Ptr actual;
+  {
+    NodeArena::Scope const scope(*arena);
+    actual = Tree::train(spec, data.x, data.y);
+  }
+  actual->arena = std::move(arena);
+
+  ASSERT_GT(actual->arena->bytes_allocated(), 0u);
+  ASSERT_EQ(*expected, *actual);
+  ASSERT_EQ(expected->predict(data.x), actual->predict(data.x));
+}
@@ -0,0 +1,208 @@
+#include "models/CompiledForest.hpp"
+
+#include "models/ClassificationForest.hpp"
+#include "models/Tree.hpp"
+#include "utils/Invariant.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace ppforest2::types;
+
+namespace ppforest2 {
+  CompiledForest CompiledForest::compile(Forest const& forest) {
+    invariant(!forest.trees.empty(), "Forest has no trees.");
+
+    CompiledForest compiled;
+    compiled.mode = forest.training_spec ? forest.training_spec->mode : Mode::Classification;
+    compiled.trees.reserve(forest.trees.size());
+
+    for (auto const& tree : forest.trees) {
+      compiled.trees.push_back(CompiledTree::compile(*tree->model->root));
+    }
+
+    if (auto const* classification = dynamic_cast<ClassificationForest const*>(&forest)) {
+      compiled.groups = classification->groups;
+    }
+
+    // Aggregation indexes vote counters by `group_column` without a bounds
+    // check, so every leaf a classification tree can reach must map to one.
+    if (compiled.mode == Mode::Classification) {
+      for (CompiledTree const& tree : compiled.trees) {
+        for (Outcome const leaf : tree.leaves) {
+          invariant(
+              compiled.group_column(static_cast<GroupId>(leaf)) >= 0,
+              "CompiledForest::compile: leaf label has no group column"
+          );
+        }
+      }
+    }
+
+    return compiled;
+  }
+
+  CompiledForest CompiledForest::compile(Tree const& tree) {
+    CompiledForest compiled;
+    compiled.mode = tree.training_spec ? tree.training_spec->mode : Mode::Classification;
+    compiled.trees.push_back(CompiledTree::compile(*tree.root));
+
+    if (compiled.mode == Mode::Classification) {
+      auto const groups = tree.root->node_groups();
+      compiled.groups.assign(groups.begin(), groups.end());
+    }
+
+    return compiled;
+  }
+
+  CompiledForest CompiledForest::compile(Model const& model) {
+    struct Compiler : public Model::Visitor {
+      CompiledForest result;
+
+      void visit(Tree const& tree) override { result = CompiledForest::compile(tree); }
+      void visit(Forest const& forest) override { result = CompiledForest::compile(forest); }
+    };
+
+    Compiler compiler;
+    model.accept(compiler);
+    return std::move(compiler.result);
+  }
+
+  namespace {
+    /**
+     * @brief Batch-major driver shared by both `predict` overloads.
+     *
+     * For every block of `CompiledTree::block_rows` rows: transpose the
+     * block once, route it through each tree in turn, and hand the m × B
+     * matrix of per-tree predictions to @p aggregate together with the
+     * block's first row. Tree order along the columns matches
+     * `forest.trees`, so aggregating a row left to right reproduces the
+     * per-row loop exactly (same vote order, same summation order).
+     *
+     * Blocks are distributed statically over @p threads; @p aggregate is
+     * called concurrently for different blocks and must only write the
+     * block's own rows.
+     */
+    template<typename Aggregate>
+    void for_each_block(CompiledForest const& forest, FeatureView const& data, int threads, Aggregate&& aggregate) {
+      Eigen::Index const n        = data.rows();
+      Eigen::Index const B        = static_cast<Eigen::Index>(forest.trees.size());
+      Eigen::Index const n_blocks = (n + CompiledTree::block_rows - 1) / CompiledTree::block_rows;
+      int const team              = std::max(threads, 1);
+
+      // clang-format off
+      #pragma omp parallel num_threads(team) if (team > 1 && n_blocks > 1)
+      // clang-format on
+      {
+        FeatureMatrix block;
+        Matrix<Outcome> tree_preds;
+        std::vector<int> order;
+        std::vector<int> leaf(static_cast<std::size_t>(CompiledTree::block_rows));
+
+        // clang-format off
+        #pragma omp for schedule(static)
+        // clang-format on
+        for (Eigen::Index k = 0; k < n_blocks; ++k) {
+          Eigen::Index const start = k * CompiledTree::block_rows;
+          Eigen::Index const m     = std::min(CompiledTree::block_rows, n - start);
+
+          data.transpose_rows(start, m, block);
+          tree_preds.resize(m, B);
+
+          for (Eigen::Index t = 0; t < B; ++t) {
+            CompiledTree const& tree = forest.trees[static_cast<std::size_t>(t)];
+            tree.route(block, order, leaf.data());
+
+            for (Eigen::Index i = 0; i < m; ++i) {
+              tree_preds(i, t) = tree.leaves[static_cast<std::size_t>(leaf[static_cast<std::size_t>(i)])];
+            }
+          }
+
+          aggregate(start, tree_preds);
+        }
+      }
+    }
+  }
+
+  int CompiledForest::group_column(GroupId label) const {
+    auto const it = std::lower_bound(groups.begin(), groups.end(), label);
+    return it != groups.end() && *it == label ? static_cast<int>(it - groups.begin()) : -1;
+  }
+
+  OutcomeVector CompiledForest::predict(FeatureView const& data, int threads) const {
+    OutcomeVector predictions(data.rows());
+
+    if (mode == Mode::Regression) {
+      for_each_block(*this, data, threads, [&](Eigen::Index start, Matrix<Outcome> const& tree_preds) {
+        for (Eigen::Index i = 0; i < tree_preds.rows(); ++i) {
+          Feature sum = Feature(0);
+
+          for (Eigen::Index t = 0; t < tree_preds.cols(); ++t) {
+            sum += static_cast<Feature>(tree_preds(i, t));
+          }
+
+          predictions(start + i) = static_cast<Outcome>(sum / static_cast<Feature>(trees.size()));
+        }
+      });
+
+      return predictions;
+    }
+
+    int const G = static_cast<int>(groups.size());
+
+    for_each_block(*this, data, threads, [&](Eigen::Index start, Matrix<Outcome> const& tree_preds) {
+      // One dense counter row per row of the block; the lambda runs once
+      // per block, so the buffer is per-thread.
+      Matrix<int> votes = Matrix<int>::Zero(tree_preds.rows(), G);
+
+      for (Eigen::Index t = 0; t < tree_preds.cols(); ++t) {
+        for (Eigen::Index i = 0; i < tree_preds.rows(); ++i) {
+          votes(i, group_column(static_cast<GroupId>(tree_preds(i, t)))) += 1;
+        }
+      }
+
+      // Strictly-greater over ascending labels: ties go to the smallest label.
+      for (Eigen::Index i = 0; i < tree_preds.rows(); ++i) {
+        Eigen::Index best = 0;
+
+        for (Eigen::Index g = 1; g < G; ++g) {
+          if (votes(i, g) > votes(i, best)) {
+            best = g;
+          }
+        }
+
+        predictions(start + i) = static_cast<Outcome>(groups[static_cast<std::size_t>(best)]);
+      }
+    });
+
+    return predictions;
+  }
+
+  FeatureMatrix CompiledForest::predict(FeatureView const& data, Proportions, int threads) const {
+    if (mode == Mode::Regression) {
+      throw std::invalid_argument("Vote proportions are not available for regression forests. "
+                                  "Use predict(data) for numeric predictions.");
+    }
+
+    int const G = static_cast<int>(groups.size());
+
+    FeatureMatrix proportions = FeatureMatrix::Zero(data.rows(), G);
+
+    for_each_block(*this, data, threads, [&](Eigen::Index start, Matrix<Outcome> const& tree_preds) {
+      for (Eigen::Index t = 0; t < tree_preds.cols(); ++t) {
+        for (Eigen::Index i = 0; i < tree_preds.rows(); ++i) {
+          proportions(start + i, group_column(static_cast<GroupId>(tree_preds(i, t)))) += 1;
+        }
+      }
+
+      for (Eigen::Index i = 0; i < tree_preds.rows(); ++i) {
+        Feature total = proportions.row(start + i).sum();
+
+        if (total > 0) {
+          proportions.row(start + i) /= total;
+        }
+      }
+    });
+
+    return proportions;
+  }
+}
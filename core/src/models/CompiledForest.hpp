@@ -0,0 +1,98 @@
+#pragma once
+
+#include "models/CompiledTree.hpp"
+#include "models/Model.hpp"
+#include "utils/FeatureView.hpp"
+#include "utils/Types.hpp"
+
+#include <vector>
+
+namespace ppforest2 {
+  struct Forest;
+  struct Tree;
+
+  /**
+   * @brief Flat, inference-only representation of a trained forest.
+   *
+   * One `CompiledTree` per bagged tree plus what aggregation needs: the
+   * training mode (majority vote vs mean) and, for classification, the
+   * sorted group labels that index the columns of a proportions matrix.
+   *
+   * Models compile themselves once and keep the result (`Model::compiled`),
+   * which `Forest::predict(FeatureMatrix)`,
+   * `ClassificationForest::predict(FeatureMatrix, Proportions)` and
+   * `Tree::predict(FeatureMatrix)` score through:
+   *
+   * @code
+   *   std::shared_ptr<CompiledForest const> compiled = forest.compiled();
+   *   OutcomeVector preds = compiled->predict(x);
+   *   FeatureMatrix props = compiled->predict(x, Proportions{});
+   * @endcode
+   *
+   * Evaluation is batch-major: rows are scored `CompiledTree::block_rows`
+   * at a time, each block routed through one tree after another (see
+   * `CompiledTree::route`), so a tree's arrays stay in cache for a whole
+   * block rather than being revisited once per row.
+   *
+   * Results are identical to aggregating `TreeNode::predict` over the
+   * node graph: same per-tree predictions (see `CompiledTree`), same vote
+   * tie-breaking (smallest label wins) and same summation order for the
+   * regression mean.
+   */
+  struct CompiledForest {
+    /** @brief Aggregation mode (majority vote or mean). */
+    types::Mode mode = types::Mode::Classification;
+    /** @brief One compiled tree per bagged tree, in forest order. */
+    std::vector<CompiledTree> trees;
+    /**
+     * @brief Sorted group labels, copied from `ClassificationForest::groups`.
+     * Vote and proportion column `g` counts votes for `groups[g]`.
+     */
+    std::vector<types::GroupId> groups;
+
+    /**
+     * @brief Flatten every tree of @p forest.
+     *
+     * Throws (`invariant`) if the forest has no trees: there is nothing to
+     * aggregate, mirroring `ClassificationForest::predict`. Also throws if
+     * a classification leaf's label has no column in `groups`.
+     */
+    static CompiledForest compile(Forest const& forest);
+
+    /**
+     * @brief Flatten a single tree into a one-tree forest.
+     *
+     * `groups` holds the labels the tree can predict, so predictions and
+     * (one-hot) proportions match `Tree::predict`.
+     */
+    static CompiledForest compile(Tree const& tree);
+
+    /** @brief Flatten either model kind (see the two overloads above). */
+    static CompiledForest compile(Model const& model);
+
+    /** @brief Column of @p label in `groups`, or `-1` if no tree predicts it. */
+    int group_column(types::GroupId label) const;
+
+    /**
+     * @brief Majority vote (classification) or mean (regression) per row.
+     *
+     * With @p threads > 1, row blocks are spread over an OpenMP team. Each
+     * thread owns its block buffers and per-tree prediction matrix, and
+     * every row is aggregated by exactly one thread in tree order, so the
+     * result does not depend on the thread count.
+     *
+     * @p data is read one block at a time, so a `FeatureView` over
+     * double-precision memory is converted block by block rather than
+     * copied up front.
+     */
+    types::OutcomeVector predict(types::FeatureView const& data, int threads = 1) const;
+
+    /**
+     * @brief Per-group vote proportions (n × G). Classification only.
+     *
+     * Rows are normalized by the number of votes (the tree count).
+     * Threading and input as in `predict(FeatureView, int)`.
+     */
+    types::FeatureMatrix predict(types::FeatureView const& data, Proportions, int threads = 1) const;
+  };
+}
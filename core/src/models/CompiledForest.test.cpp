@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+
+#include "models/CompiledForest.hpp"
+#include "models/ClassificationForest.hpp"
+#include "models/RegressionForest.hpp"
+
+#include "models/TrainingSpec.hpp"
+#include "TestSpec.hpp"
+
+#include "stats/Simulation.hpp"
+
+using namespace ppforest2;
+using namespace ppforest2::stats;
+using namespace ppforest2::types;
+
+namespace {
+  Forest::Ptr train_classification_forest(DataPacket const& data) {
+    return Forest::train(
+        TrainingSpec::builder(types::Mode::Classification).size(15).threads(1).vars(vars::uniform(3)).build(),
+        data.x,
+        data.y
+    );
+  }
+}
+
+TEST(CompiledForest, CompilesEveryTree) {
+  RNG rng(0);
+  auto data   = simulate(90, 5, 3, rng);
+  auto forest = train_classification_forest(data);
+
+  CompiledForest const compiled = CompiledForest::compile(*forest);
+
+  ASSERT_EQ(forest->trees.size(), compiled.trees.size());
+  ASSERT_EQ((std::vector<GroupId>{0, 1, 2}), compiled.groups);
+}
+
+TEST(CompiledForest, ModelsCompileOnce) {
+  RNG rng(5);
+  auto data   = simulate(90, 5, 3, rng);
+  auto forest = train_classification_forest(data);
+
+  auto const compiled = forest->compiled();
+
+  ASSERT_EQ(compiled, forest->compiled());
+  ASSERT_EQ(compiled->predict(data.x), forest->predict(data.x));
+}
+
+TEST(CompiledForest, AddingATreeRecompiles) {
+  RNG rng(6);
+  auto data    = simulate(90, 5, 3, rng);
+  auto trained = train_classification_forest(data);
+
+  ClassificationForest forest(trained->training_spec);
+  forest.add_tree(std::move(trained->trees[0]));
+
+  auto const first = forest.compiled();
+  ASSERT_EQ(1U, first->trees.size());
+
+  // A caller's compiled form outlives the model's dropping it.
+  forest.add_tree(std::move(trained->trees[1]));
+  ASSERT_EQ(2U, forest.compiled()->trees.size());
+  ASSERT_EQ(1U, first->trees.size());
+}
+
+TEST(CompiledForest, MatchesNodeGraphClassification) {
+  RNG rng(1);
+  auto data   = simulate(120, 6, 4, rng);
+  auto forest = train_classification_forest(data);
+
+  OutcomeVector const compiled = CompiledForest::compile(*forest).predict(data.x);
+
+  for (int i = 0; i < data.x.rows(); ++i) {
+    ASSERT_EQ(forest->predict(static_cast<FeatureVector>(data.x.row(i))), compiled(i)) << "row " << i;
+  }
+}
+
+TEST(CompiledForest, ProportionsMatchVotes) {
+  RNG rng(2);
+  auto data   = simulate(90, 4, 3, rng);
+  auto forest = train_classification_forest(data);
+
+  CompiledForest const compiled = CompiledForest::compile(*forest);
+  FeatureMatrix const props     = compiled.predict(data.x, Proportions{});
+  int const B                   = static_cast<int>(forest->trees.size());
+
+  ASSERT_EQ(data.x.rows(), props.rows());
+  ASSERT_EQ(3, props.cols());
+
+  for (int i = 0; i < data.x.rows(); ++i) {
+    FeatureVector const row = data.x.row(i);
+
+    for (int g = 0; g < 3; ++g) {
+      int votes = 0;
+
+      for (auto const& tree : forest->trees) {
+        votes += static_cast<GroupId>(tree->predict(row)) == g ? 1 : 0;
+      }
+
+      ASSERT_FLOAT_EQ(static_cast<Feature>(votes) / static_cast<Feature>(B), props(i, g));
+    }
+  }
+}
+
+TEST(CompiledForest, MatchesNodeGraphRegression) {
+  RNG rng(0);
+  auto data = simulate_regression(100, 4, rng);
+
+  auto spec = TrainingSpec::builder(types::Mode::Regression)
+                  .grouping(grouping::by_cutpoint())
+                  .leaf(leaf::mean_response())
+                  .stop(stop::any({stop::min_size(5), stop::min_variance(0.001F)}))
+                  .size(10)
+                  .threads(1)
+                  .build();
+
+  auto forest = Forest::train(spec, data.x, data.y);
+
+  CompiledForest const compiled = CompiledForest::compile(*forest);
+  OutcomeVector const preds     = compiled.predict(data.x);
+
+  for (int i = 0; i < data.x.rows(); ++i) {
+    ASSERT_EQ(forest->predict(static_cast<FeatureVector>(data.x.row(i))), preds(i)) << "row " << i;
+  }
+
+  ASSERT_THROW(compiled.predict(data.x, Proportions{}), std::invalid_argument);
+}
+
+TEST(CompiledForest, EmptyForestThrows) {
+  ClassificationForest const forest(test::classification_spec());
+
+  ASSERT_THROW(CompiledForest::compile(forest), std::exception);
+}
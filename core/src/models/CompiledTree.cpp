@@ -0,0 +1,175 @@
+#include "models/CompiledTree.hpp"
+
+#include "models/TreeBranch.hpp"
+#include "models/TreeLeaf.hpp"
+#include "utils/Invariant.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+using namespace ppforest2::types;
+
+namespace ppforest2 {
+  namespace {
+    /**
+     * @brief Pre-order flattener. Each `visit` leaves the reference of the
+     * visited node in `ref`, so the parent can record it after recursing.
+     * Projectors are collected by pointer and copied once the branch count
+     * (and therefore the matrix size) is known.
+     */
+    struct Flattener : public TreeNode::Visitor {
+      std::vector<pp::Projector const*> projectors;
+      std::vector<Feature> cutpoints;
+      std::vector<int> lower;
+      std::vector<int> upper;
+      std::vector<Outcome> leaves;
+      int ref = 0;
+
+      void visit(TreeBranch const& node) override {
+        int const b = static_cast<int>(cutpoints.size());
+
+        projectors.push_back(&node.projector);
+        cutpoints.push_back(node.cutpoint);
+        lower.push_back(0);
+        upper.push_back(0);
+
+        node.lower->accept(*this);
+        lower[static_cast<std::size_t>(b)] = ref;
+
+        node.upper->accept(*this);
+        upper[static_cast<std::size_t>(b)] = ref;
+
+        ref = b;
+      }
+
+      void visit(TreeLeaf const& node) override {
+        ref = CompiledTree::leaf_ref(static_cast<int>(leaves.size()));
+        leaves.push_back(node.value);
+      }
+    };
+  }
+
+  CompiledTree CompiledTree::compile(TreeNode const& root) {
+    Flattener flattener;
+    root.accept(flattener);
+
+    CompiledTree compiled;
+    compiled.root = flattener.ref;
+
+    if (!flattener.projectors.empty()) {
+      Eigen::Index const p = flattener.projectors.front()->size();
+      Eigen::Index const B = static_cast<Eigen::Index>(flattener.projectors.size());
+
+      std::vector<Feature> dense_coefficients(static_cast<std::size_t>(p) * static_cast<std::size_t>(B));
+      Eigen::Map<FeatureMatrix> projectors(dense_coefficients.data(), p, B);
+
+      for (Eigen::Index b = 0; b < B; ++b) {
+        pp::Projector const& projector = *flattener.projectors[static_cast<std::size_t>(b)];
+        invariant(projector.size() == p, "CompiledTree::compile: projectors of different sizes in one tree");
+        projectors.col(b) = projector;
+      }
+
+      compiled.vars               = static_cast<int>(p);
+      compiled.dense_coefficients = std::move(dense_coefficients);
+    }
+
+    compiled.cutpoints = std::move(flattener.cutpoints);
+    compiled.lower     = std::move(flattener.lower);
+    compiled.upper     = std::move(flattener.upper);
+    compiled.leaves    = std::move(flattener.leaves);
+
+    return compiled;
+  }
+
+  void CompiledTree::route(FeatureMatrix const& block, std::vector<int>& order, int* leaf) const {
+    struct Range {
+      int ref;
+      int begin;
+      int end;
+    };
+
+    int const m = static_cast<int>(block.cols());
+
+    order.resize(static_cast<std::size_t>(m));
+    std::iota(order.begin(), order.end(), 0);
+
+    std::vector<Range> stack;
+    stack.push_back({root, 0, m});
+
+    while (!stack.empty()) {
+      Range const range = stack.back();
+      stack.pop_back();
+
+      if (range.begin == range.end) {
+        continue;
+      }
+
+      if (range.ref < 0) {
+        for (int k = range.begin; k < range.end; ++k) {
+          leaf[order[static_cast<std::size_t>(k)]] = leaf_index(range.ref);
+        }
+
+        continue;
+      }
+
+      std::size_t const b    = static_cast<std::size_t>(range.ref);
+      auto const projector   = projectors().col(range.ref);
+      Feature const cutpoint = cutpoints[b];
+
+      // In-place partition: rows below the cutpoint are swapped to the front.
+      int mid = range.begin;
+
+      for (int k = range.begin; k < range.end; ++k) {
+        int const i = order[static_cast<std::size_t>(k)];
+
+        if (block.col(i).dot(projector) < cutpoint) {
+          std::swap(order[static_cast<std::size_t>(k)], order[static_cast<std::size_t>(mid)]);
+          ++mid;
+        }
+      }
+
+      stack.push_back({upper[b], mid, range.end});
+      stack.push_back({lower[b], range.begin, mid});
+    }
+  }
+
+  OutcomeVector CompiledTree::predict(FeatureMatrix const& data, int threads) const {
+    // Rows are transposed into a contiguous p × m block: `data.row(i)` is
+    // strided in column-major storage, and a strided dot product would both
+    // lose vectorization and change the summation order relative to the
+    // node graph's `TreeBranch::predict`.
+    Eigen::Index const n        = data.rows();
+    Eigen::Index const n_blocks = (n + block_rows - 1) / block_rows;
+    int const team              = std::max(threads, 1);
+
+    OutcomeVector predictions(n);
+
+    // clang-format off
+    #pragma omp parallel num_threads(team) if (team > 1 && n_blocks > 1)
+    // clang-format on
+    {
+      FeatureMatrix block;
+      std::vector<int> order;
+      std::vector<int> leaf(static_cast<std::size_t>(block_rows));
+
+      // clang-format off
+      #pragma omp for schedule(static)
+      // clang-format on
+      for (Eigen::Index k = 0; k < n_blocks; ++k) {
+        Eigen::Index const start = k * block_rows;
+        Eigen::Index const m     = std::min(block_rows, n - start);
+
+        block.resize(data.cols(), m);
+        block = data.middleRows(start, m).transpose();
+
+        route(block, order, leaf.data());
+
+        for (Eigen::Index i = 0; i < m; ++i) {
+          predictions(start + i) = leaves[static_cast<std::size_t>(leaf[static_cast<std::size_t>(i)])];
+        }
+      }
+    }
+
+    return predictions;
+  }
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "models/TreeNode.hpp"
+#include "utils/ConstArray.hpp"
+#include "utils/Types.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace ppforest2 {
+  /**
+   * @brief Flat, inference-only representation of a trained tree.
+   *
+   * The node graph (`TreeBranch` / `TreeLeaf` linked through `unique_ptr`)
+   * is convenient for training, serialization and visitors, but scoring a
+   * row through it costs a virtual call and a pointer chase per level.
+   * `CompiledTree` packs the same tree into a structure of arrays:
+   *
+   *   - `projectors`  — one column per branch, contiguous (stored as
+   *     `dense_coefficients`, viewed as a matrix through `projectors()`);
+   *   - `cutpoints`, `lower`, `upper` — one entry per branch;
+   *   - `leaves`      — one entry per leaf.
+   *
+   * Child references are plain integers: a non-negative value is a branch
+   * index, a negative value `r` is the leaf `-r - 1` (see `leaf_ref`).
+   * Branches are laid out in pre-order (lower subtree first), so the most
+   * common walk touches memory front to back.
+   *
+   * Predictions are bit-identical to `TreeNode::predict`: the projection is
+   * computed as a dot product of two contiguous vectors, exactly as
+   * `TreeBranch::predict` does, so the summation order does not change and
+   * rows sitting on a cutpoint route the same way.
+   *
+   * The arrays are read-only once built. `compile` fills owning arrays;
+   * `serialization::binary::decode` borrows them straight from the model
+   * file's bytes and keeps the file alive through `storage`.
+   *
+   * @code
+   *   CompiledTree const compiled = CompiledTree::compile(*tree->root);
+   *   OutcomeVector preds         = compiled.predict(x);
+   * @endcode
+   */
+  struct CompiledTree {
+    /** @brief Projection vectors, column-major, one column of `vars` per branch. */
+    utils::ConstArray<types::Feature> dense_coefficients;
+    /** @brief Number of predictor variables (0 for single-leaf trees). */
+    int vars = 0;
+    /** @brief Split cutpoint per branch. */
+    utils::ConstArray<types::Feature> cutpoints;
+    /** @brief Child reference taken when the projected value is < cutpoint. */
+    utils::ConstArray<int> lower;
+    /** @brief Child reference taken when the projected value is ≥ cutpoint. */
+    utils::ConstArray<int> upper;
+    /** @brief Leaf values (group label or mean response). */
+    utils::ConstArray<types::Outcome> leaves;
+    /** @brief Reference to the root node (a leaf for single-leaf trees). */
+    int root = leaf_ref(0);
+    /** @brief Memory the borrowed arrays point into (null when every array owns its values). */
+    std::shared_ptr<void const> storage;
+
+    /** @brief Encode leaf index @p leaf as a child reference. */
+    static constexpr int leaf_ref(int leaf) { return -leaf - 1; }
+
+    /** @brief Decode a (negative) child reference into a leaf index. */
+    static constexpr int leaf_index(int ref) { return -ref - 1; }
+
+    /**
+     * @brief Flatten a node graph into a compiled tree.
+     *
+     * @param root  Root node of a trained tree.
+     */
+    static CompiledTree compile(TreeNode const& root);
+
+    /** @brief Projectors as a matrix (p × n_branches) over `dense_coefficients`. */
+    Eigen::Map<types::FeatureMatrix const> projectors() const {
+      Eigen::Index const cols = vars == 0 ? 0 : static_cast<Eigen::Index>(dense_coefficients.size()) / vars;
+      return {dense_coefficients.data(), vars, cols};
+    }
+
+    /** @brief Number of split nodes. */
+    int branch_count() const { return static_cast<int>(cutpoints.size()); }
+
+    /** @brief Number of predictor variables (0 for single-leaf trees). */
+    int n_vars() const { return vars; }
+
+    /**
+     * @brief Walk one observation from the root to its leaf.
+     *
+     * @param data  Contiguous feature vector (p).
+     * @return      Leaf index reached by @p data.
+     */
+    int leaf_of(types::FeatureVector const& data) const {
+      int ref = root;
+
+      while (ref >= 0) {
+        std::size_t const b     = static_cast<std::size_t>(ref);
+        types::Feature const pv = data.dot(projectors().col(ref));
+        ref                     = pv < cutpoints[b] ? lower[b] : upper[b];
+      }
+
+      return leaf_index(ref);
+    }
+
+    /**
+     * @brief Route a block of rows through the tree together (batch-major).
+     *
+     * Rows are kept as an index list that is partitioned toward `lower` /
+     * `upper` at every branch, so each branch's projector is loaded once
+     * per block instead of once per row, and the tree stays hot in cache
+     * while the whole block is routed.
+     *
+     * @param block  Transposed row block (p × m): column `i` holds row `i`.
+     *               Columns are contiguous, which keeps every projection the
+     *               same dot product `TreeBranch::predict` computes.
+     * @param order  Scratch row-index list, resized to m.
+     * @param leaf   Output leaf index per block column (size ≥ m).
+     */
+    void route(types::FeatureMatrix const& block, std::vector<int>& order, int* leaf) const;
+
+    /** @brief Predict a single observation. */
+    types::Outcome predict(types::FeatureVector const& data) const {
+      return leaves[static_cast<std::size_t>(leaf_of(data))];
+    }
+
+    /**
+     * @brief Predict each row of a feature matrix, `block_rows` rows at a time.
+     *
+     * Blocks are independent, so with @p threads > 1 they are spread over
+     * an OpenMP team (static schedule, one scratch buffer per thread). Every
+     * row is written by exactly one block, so the result does not depend on
+     * the thread count.
+     */
+    types::OutcomeVector predict(types::FeatureMatrix const& data, int threads = 1) const;
+
+    /**
+     * @brief Rows per block in batch-major evaluation.
+     *
+     * A transposed block is p × 256 floats — 1 KB per variable — which keeps
+     * the block in L2 for the p we see in practice while amortizing the
+     * per-branch overhead over enough rows.
+     */
+    static constexpr Eigen::Index block_rows = 256;
+  };
+}
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+
+#include "models/CompiledTree.hpp"
+#include "models/Tree.hpp"
+#include "models/TreeBranch.hpp"
+#include "models/TreeLeaf.hpp"
+
+#include "models/TrainingSpec.hpp"
+#include "TestSpec.hpp"
+
+#include "stats/Simulation.hpp"
+#include "utils/Macros.hpp"
+
+using namespace ppforest2;
+using namespace ppforest2::stats;
+using namespace ppforest2::types;
+using namespace ppforest2::pp;
+
+namespace {
+  Projector as_projector(std::vector<Feature> v) {
+    return Eigen::Map<Projector>(v.data(), v.size());
+  }
+
+  void expect_matches_node_graph(Tree const& tree, FeatureMatrix const& x) {
+    CompiledTree const compiled = CompiledTree::compile(*tree.root);
+    OutcomeVector const batch   = compiled.predict(x);
+
+    for (int i = 0; i < x.rows(); ++i) {
+      FeatureVector const row = x.row(i);
+      ASSERT_EQ(tree.root->predict(row), compiled.predict(row)) << "row " << i;
+      ASSERT_EQ(tree.root->predict(row), batch(i)) << "row " << i;
+    }
+  }
+}
+
+TEST(CompiledTree, SingleLeaf) {
+  CompiledTree const compiled = CompiledTree::compile(*TreeLeaf::make(3));
+
+  ASSERT_EQ(0, compiled.branch_count());
+  ASSERT_EQ(1, compiled.leaves.size());
+  ASSERT_EQ(3, compiled.predict(VEC(Feature, 1, 2)));
+}
+
+TEST(CompiledTree, PreOrderLayout) {
+  auto root = TreeBranch::make(
+      as_projector({1, 0}),
+      5,
+      TreeBranch::make(as_projector({0, 1}), 2, TreeLeaf::make(0), TreeLeaf::make(1)),
+      TreeLeaf::make(2)
+  );
+
+  CompiledTree const compiled = CompiledTree::compile(*root);
+
+  ASSERT_EQ(2, compiled.branch_count());
+  ASSERT_EQ(2, compiled.n_vars());
+  ASSERT_EQ(0, compiled.root);
+
+  // Branch 0 is the root; its lower child is branch 1, its upper child the third leaf.
+  ASSERT_EQ(1, compiled.lower[0]);
+  ASSERT_EQ(CompiledTree::leaf_ref(2), compiled.upper[0]);
+  ASSERT_EQ(CompiledTree::leaf_ref(0), compiled.lower[1]);
+  ASSERT_EQ(CompiledTree::leaf_ref(1), compiled.upper[1]);
+
+  ASSERT_EQ(0, compiled.predict(VEC(Feature, 1, 1)));
+  ASSERT_EQ(1, compiled.predict(VEC(Feature, 1, 3)));
+  ASSERT_EQ(2, compiled.predict(VEC(Feature, 6, 0)));
+}
+
+TEST(CompiledTree, CutpointGoesUpper) {
+  auto root = TreeBranch::make(as_projector({1, 1}), 2, TreeLeaf::make(0), TreeLeaf::make(1));
+
+  CompiledTree const compiled = CompiledTree::compile(*root);
+
+  ASSERT_EQ(root->predict(VEC(Feature, 1, 1)), compiled.predict(VEC(Feature, 1, 1)));
+  ASSERT_EQ(1, compiled.predict(VEC(Feature, 1, 1)));
+}
+
+TEST(CompiledTree, MatchesNodeGraphClassification) {
+  RNG rng(0);
+  auto data = simulate(150, 6, 4, rng);
+
+  auto tree = Tree::train(
+      TrainingSpec::builder(types::Mode::Classification).vars(vars::uniform(3)).build(), data.x, data.y
+  );
+
+  expect_matches_node_graph(*tree, data.x);
+}
+
+TEST(CompiledTree, MatchesNodeGraphRegression) {
+  RNG rng(0);
+  auto data = simulate_regression(120, 5, rng);
+
+  auto spec = TrainingSpec::builder(types::Mode::Regression)
+                  .grouping(grouping::by_cutpoint())
+                  .leaf(leaf::mean_response())
+                  .stop(stop::any({stop::min_size(5), stop::min_variance(0.001F)}))
+                  .build();
+  auto tree = Tree::train(spec, data.x, data.y);
+
+  expect_matches_node_graph(*tree, data.x);
+}
+
+TEST(CompiledTree, RouteSpansSeveralBlocks) {
+  RNG rng(3);
+  auto data = simulate(2 * static_cast<int>(CompiledTree::block_rows) + 37, 5, 3, rng);
+
+  auto tree = Tree::train(
+      TrainingSpec::builder(types::Mode::Classification).vars(vars::uniform(2)).build(), data.x, data.y
+  );
+
+  expect_matches_node_graph(*tree, data.x);
+}
+
+TEST(CompiledTree, RouteAssignsEveryColumn) {
+  auto root = TreeBranch::make(
+      as_projector({1, 0}),
+      5,
+      TreeBranch::make(as_projector({0, 1}), 2, TreeLeaf::make(0), TreeLeaf::make(1)),
+      TreeLeaf::make(2)
+  );
+
+  CompiledTree const compiled = CompiledTree::compile(*root);
+
+  // Columns are observations: (1, 1), (6, 0), (1, 3), (9, 9).
+  FeatureMatrix const block = MAT(Feature, rows(2), 1, 6, 1, 9, 1, 0, 3, 9);
+
+  std::vector<int> order;
+  std::vector<int> leaf(4, -1);
+  compiled.route(block, order, leaf.data());
+
+  ASSERT_EQ((std::vector<int>{0, 2, 1, 2}), leaf);
+}
@@ -1,12 +1,15 @@
 #include "models/Forest.hpp"
 
 #include "models/ClassificationForest.hpp"
+#include "models/CompiledForest.hpp"
 #include "models/Model.hpp"
 #include "models/RegressionForest.hpp"
 #include "models/VIVisitor.hpp"
 #include "stats/Stats.hpp"
 #include "utils/Invariant.hpp"
 
+#include <algorithm>
+
 using namespace ppforest2::types;
 
 namespace ppforest2 {
@@ -54,13 +57,36 @@ namespace ppforest2 {
   }
 
   OutcomeVector Forest::predict(FeatureMatrix const& data) const {
-    OutcomeVector predictions(data.rows());
+    return compiled()->predict(data, resolve_threads());
+  }
 
-    for (int i = 0; i < data.rows(); ++i) {
-      predictions(i) = predict(static_cast<FeatureVector>(data.row(i)));
-    }
+  void Forest::for_each_oob_prediction(
+      FeatureMatrix const& x,
+      std::function<void(int, std::vector<int> const&, OutcomeVector const&)> const& visit
+  ) const {
+    int const n_total = static_cast<int>(x.rows());
+    int const B       = static_cast<int>(trees.size());
+    int const team    = std::max(resolve_threads(), 1);
+
+    std::vector<std::vector<int>> oob_idx(static_cast<std::size_t>(team));
+    std::vector<OutcomeVector> preds(static_cast<std::size_t>(team));
+
+    for (int first = 0; first < B; first += team) {
+      int const count = std::min(team, B - first);
+
+      // clang-format off
+      #pragma omp parallel for num_threads(team) schedule(static) if (count > 1)
+      // clang-format on
+      for (int c = 0; c < count; ++c) {
+        BaggedTree const& tree                = *trees[static_cast<std::size_t>(first + c)];
+        oob_idx[static_cast<std::size_t>(c)] = tree.oob_indices(n_total);
+        preds[static_cast<std::size_t>(c)]   = tree.predict_oob(x, oob_idx[static_cast<std::size_t>(c)]);
+      }
 
-    return predictions;
+      for (int c = 0; c < count; ++c) {
+        visit(first + c, oob_idx[static_cast<std::size_t>(c)], preds[static_cast<std::size_t>(c)]);
+      }
+    }
   }
 
   void Forest::add_tree(BaggedTree::Ptr tree) {
@@ -91,6 +117,8 @@ namespace ppforest2 {
       );
     }
     trees.push_back(std::move(tree));
+    drop_compiled();
+    on_tree_added(*trees.back());
   }
 
   bool Forest::operator==(Forest const& other) const {
@@ -111,7 +139,7 @@ namespace ppforest2 {
     return !(*this == other);
   }
 
-  Forest::Ptr Forest::train(TrainingSpec const& training_spec, FeatureMatrix const& x, OutcomeVector const& y) {
+  Forest::Ptr Forest::train(TrainingSpec const& training_spec, FeatureView const& x, OutcomeVector const& y) {
     Model::check_train_inputs(x, y);
 
     if (training_spec.mode == types::Mode::Regression) {
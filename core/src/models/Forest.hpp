@@ -1,9 +1,11 @@
 #pragma once
 
+#include "models/ForestSchedule.hpp"
 #include "models/Model.hpp"
 #include "models/Tree.hpp"
 #include "models/VariableImportance.hpp"
 
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -39,6 +41,14 @@ namespace ppforest2 {
      * polymorphic inner `Tree` with its sample indices. */
     std::vector<BaggedTree::Ptr> trees;
 
+    /**
+     * @brief How training spread over the threads (see `train_bags`).
+     *
+     * Filled by `train`; empty for forests read back from disk. Not part
+     * of the model: neither serialized nor compared.
+     */
+    ScheduleReport schedule;
+
     /**
      * @brief Train a random forest.
      *
@@ -47,10 +57,21 @@ namespace ppforest2 {
      * not mutated here — each bootstrap tree resamples into its own local
      * storage. (Contrast with single-tree `Tree::train`, where regression
      * mode does permute `x` / `y` in place.)
+     *
+     * `x` is only read bag by bag, so it can be a `FeatureView` over the
+     * caller's own (e.g. double-precision) memory; a `FeatureMatrix`
+     * converts implicitly. Under `weighted_bootstrap` trees read their
+     * drawn rows in place from a `FeatureMatrix` argument; other views
+     * gather each bag's distinct drawn rows once.
      */
-    static Ptr train(TrainingSpec const& training_spec, types::FeatureMatrix const& x, types::OutcomeVector const& y);
+    static Ptr train(TrainingSpec const& training_spec, types::FeatureView const& x, types::OutcomeVector const& y);
 
-    /** @brief Concrete — iterates rows and calls the virtual `predict(FeatureVector)`. */
+    /**
+     * @brief Concrete — scores through `compiled()` (see `CompiledForest`)
+     * and aggregates per-row with the mode's rule, over `resolve_threads()`
+     * threads. Same results as calling the virtual `predict(FeatureVector)`
+     * on every row, for any thread count.
+     */
     types::OutcomeVector predict(types::FeatureMatrix const& data) const override;
 
     /** @brief Per-row prediction (mode-specific: majority vote or mean). */
@@ -159,5 +180,33 @@ namespace ppforest2 {
   protected:
     Forest();
     explicit Forest(TrainingSpec::Ptr training_spec);
+
+    /**
+     * @brief Hook run by `add_tree` after the tree is appended.
+     *
+     * Lets subclasses keep per-forest indexes (e.g. the classification
+     * label-to-column mapping) in sync with `trees` on every construction
+     * path — training and deserialization alike. No-op by default.
+     */
+    virtual void on_tree_added(BaggedTree const& /*tree*/) {}
+
+    /**
+     * @brief Hand every tree's out-of-bag predictions to @p visit, in tree order.
+     *
+     * Trees are independent, so their OOB predictions are computed
+     * `resolve_threads()` trees at a time in parallel; @p visit is then
+     * called sequentially for each tree of the chunk, in forest order. Any
+     * order-sensitive aggregation in @p visit (float sums, vote ties) is
+     * therefore the same as a plain sequential loop over `trees`, and peak
+     * memory is one chunk of prediction vectors rather than one per tree.
+     *
+     * @param x      Training feature matrix (n × p).
+     * @param visit  Called as `visit(k, oob_idx, preds)` where `preds(j)`
+     *               is tree `k`'s prediction for row `oob_idx[j]`.
+     */
+    void for_each_oob_prediction(
+        types::FeatureMatrix const& x,
+        std::function<void(int, std::vector<int> const&, types::OutcomeVector const&)> const& visit
+    ) const;
   };
 }
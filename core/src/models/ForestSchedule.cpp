@@ -0,0 +1,167 @@
+#include "models/ForestSchedule.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace ppforest2::stats;
+
+namespace ppforest2 {
+  namespace {
+    using Clock = std::chrono::steady_clock;
+
+    double ms_since(Clock::time_point start) {
+      return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    int thread_id() {
+      // clang-format off
+      #ifdef _OPENMP
+      return omp_get_thread_num();
+      #else
+      return 0;
+      #endif
+      // clang-format on
+    }
+
+    /** @brief Shared state of one `train_bags` call; every slot is written by one unit at a time. */
+    struct Schedule {
+      int size;
+      int seed;
+      int max_retries;
+      std::function<BaggedTree::Ptr(RNG&, uint64_t)> const& train_bag;
+
+      std::vector<BaggedTree::Ptr> bags;
+      std::vector<std::exception_ptr> errors;
+
+      std::vector<ScheduleReport::Thread> threads;
+      // Units entered and not yet left, per thread. A unit can start on a
+      // thread that is waiting inside another unit (the tree's own tasks
+      // reach a task scheduling point), and its time is already counted.
+      std::vector<int> depth;
+      std::vector<int> retries;
+
+      void run(int i, int attempt) {
+        int const thread              = thread_id();
+        bool const outermost          = depth[static_cast<std::size_t>(thread)]++ == 0;
+        Clock::time_point const start = Clock::now();
+
+        bool retry = false;
+
+        try {
+          // Stream id `i + attempt * size` partitions `[0, size*(max_retries+1))`
+          // into disjoint blocks: attempt 0 uses ids [0, size), attempt 1 uses
+          // [size, 2*size), etc. Each (tree_index, attempt) pair gets a unique
+          // stream. This formula is load-bearing for golden-file reproducibility
+          // — changing the stride invalidates every classification and
+          // regression golden file.
+          uint64_t stream = static_cast<uint64_t>(i) + static_cast<uint64_t>(attempt) * static_cast<uint64_t>(size);
+          RNG rng(static_cast<uint64_t>(seed), stream);
+          bags[static_cast<std::size_t>(i)] = train_bag(rng, stream);
+
+          retry = bags[static_cast<std::size_t>(i)]->degenerate() && attempt < max_retries;
+        } catch (...) {
+          errors[static_cast<std::size_t>(i)] = std::current_exception();
+        }
+
+        ScheduleReport::Thread& load = threads[static_cast<std::size_t>(thread)];
+        load.units += 1;
+
+        if (outermost) {
+          load.busy_ms += ms_since(start);
+        }
+
+        depth[static_cast<std::size_t>(thread)] -= 1;
+
+        if (retry) {
+          retries[static_cast<std::size_t>(thread)] += 1;
+
+          // clang-format off
+          #pragma omp task default(shared) firstprivate(i, attempt)
+          // clang-format on
+          run(i, attempt + 1);
+        }
+      }
+    };
+  }
+
+  nlohmann::json ScheduleReport::to_json() const {
+    nlohmann::json per_thread = nlohmann::json::array();
+
+    for (Thread const& thread : threads) {
+      per_thread.push_back({{"busy_ms", thread.busy_ms}, {"idle_ms", thread.idle_ms}, {"units", thread.units}});
+    }
+
+    return {{"wall_ms", wall_ms}, {"retries", retries}, {"threads", per_thread}};
+  }
+
+  std::vector<BaggedTree::Ptr> train_bags(
+      int size,
+      int seed,
+      int max_retries,
+      int threads,
+      std::function<BaggedTree::Ptr(RNG&, uint64_t)> const& train_bag,
+      ScheduleReport* report
+  ) {
+    int const team = std::max(threads, 1);
+
+    auto const n_bags    = static_cast<std::size_t>(size);
+    auto const n_threads = static_cast<std::size_t>(team);
+
+    Schedule schedule{
+        size,
+        seed,
+        max_retries,
+        train_bag,
+        std::vector<BaggedTree::Ptr>(n_bags),
+        std::vector<std::exception_ptr>(n_bags),
+        std::vector<ScheduleReport::Thread>(n_threads),
+        std::vector<int>(n_threads, 0),
+        std::vector<int>(n_threads, 0),
+    };
+
+    Clock::time_point const start = Clock::now();
+
+    // One thread queues the first attempts; the whole team, the queuing
+    // thread included, then drains the queue and any retries it grows.
+    // clang-format off
+    #pragma omp parallel num_threads(team)
+    #pragma omp single
+    // clang-format on
+    {
+      for (int i = 0; i < size; ++i) {
+        // clang-format off
+        #pragma omp task default(shared) firstprivate(i)
+        // clang-format on
+        schedule.run(i, 0);
+      }
+    }
+
+    for (std::exception_ptr const& error : schedule.errors) {
+      if (error) {
+        std::rethrow_exception(error);
+      }
+    }
+
+    if (report != nullptr) {
+      report->wall_ms = ms_since(start);
+      report->retries = 0;
+      report->threads = std::move(schedule.threads);
+
+      for (int const retries : schedule.retries) {
+        report->retries += retries;
+      }
+
+      for (ScheduleReport::Thread& thread : report->threads) {
+        thread.idle_ms = std::max(report->wall_ms - thread.busy_ms, 0.0);
+      }
+    }
+
+    return std::move(schedule.bags);
+  }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "models/Tree.hpp"
+#include "stats/Stats.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace ppforest2 {
+  /**
+   * @brief How the work of training a forest was spread over its threads.
+   *
+   * Busy time is spent training bags; idle time is the rest of the
+   * parallel region's wall time (waiting for work, or for the slowest
+   * thread at the end). A large spread in `busy_ms` across threads is the
+   * load imbalance this report exists to show.
+   */
+  struct ScheduleReport {
+    struct Thread {
+      double busy_ms = 0;
+      double idle_ms = 0;
+      /** @brief Bags (first attempts and retries) this thread trained. */
+      int units = 0;
+    };
+
+    double wall_ms = 0;
+    /** @brief Retry attempts scheduled after a degenerate bag. */
+    int retries = 0;
+    std::vector<Thread> threads;
+
+    nlohmann::json to_json() const;
+  };
+
+  /**
+   * @brief Train @p size bags under a dynamic schedule.
+   *
+   * Every attempt at a bag is its own OpenMP task: the first attempts are
+   * queued up front, and a degenerate bag queues its retry as a new task
+   * instead of holding its thread through the retry loop. Idle threads
+   * pick up whichever unit is next, so a few expensive bags no longer
+   * decide when the whole forest finishes.
+   *
+   * Attempt `a` of bag `i` draws from stream `i + a * size` of @p seed, and
+   * bag `i` keeps its first non-degenerate attempt (or its last one), so
+   * the forest is the same for any thread count or execution order.
+   *
+   * @param train_bag  Trains one bag from the given RNG, whose stream id it
+   *                   is also passed; must be thread-safe.
+   * @param report     Filled with per-thread busy/idle times when not null.
+   * @return The bags, in order. Rethrows the first failure (by bag index).
+   */
+  std::vector<BaggedTree::Ptr> train_bags(
+      int size,
+      int seed,
+      int max_retries,
+      int threads,
+      std::function<BaggedTree::Ptr(stats::RNG&, std::uint64_t)> const& train_bag,
+      ScheduleReport* report = nullptr
+  );
+}
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+
+#include "models/ClassificationForest.hpp"
+#include "models/ClassificationTree.hpp"
+#include "models/ForestSchedule.hpp"
+#include "models/TrainingSpec.hpp"
+#include "models/TreeLeaf.hpp"
+#include "stats/Simulation.hpp"
+
+#include <stdexcept>
+
+using namespace ppforest2;
+using namespace ppforest2::stats;
+using namespace ppforest2::types;
+
+namespace {
+  /**
+   * @brief A one-leaf bag labelled by the first draw of its stream.
+   *
+   * Odd draws are flagged degenerate, so about half of all attempts retry.
+   */
+  BaggedTree::Ptr leaf_bag(RNG& rng, std::uint64_t /*stream*/) {
+    static TrainingSpec::Ptr const spec = TrainingSpec::builder(Mode::Classification).make();
+    std::uint32_t const draw            = rng();
+
+    auto tree        = std::make_unique<ClassificationTree>(TreeLeaf::make(Outcome(draw % 1000)), spec);
+    tree->degenerate = draw % 2 == 1;
+
+    return std::make_unique<BaggedTree>(std::move(tree), std::vector<int>{});
+  }
+
+  /** @brief The bag `train_bags` must keep for index @p i, replayed sequentially. */
+  BaggedTree::Ptr expected_bag(int i, int size, int seed, int max_retries) {
+    BaggedTree::Ptr bag;
+
+    for (int attempt = 0; attempt <= max_retries; ++attempt) {
+      RNG rng(static_cast<uint64_t>(seed), static_cast<uint64_t>(i + attempt * size));
+      bag = leaf_bag(rng, static_cast<uint64_t>(i + attempt * size));
+
+      if (!bag->degenerate()) {
+        break;
+      }
+    }
+
+    return bag;
+  }
+}
+
+TEST(ForestSchedule, RetriesKeepTheirStreams) {
+  int const size        = 40;
+  int const seed        = 5;
+  int const max_retries = 3;
+
+  for (int const threads : {1, 4}) {
+    ScheduleReport report;
+    auto const bags = train_bags(size, seed, max_retries, threads, leaf_bag, &report);
+
+    ASSERT_EQ(static_cast<std::size_t>(size), bags.size());
+
+    for (int i = 0; i < size; ++i) {
+      auto const expected = expected_bag(i, size, seed, max_retries);
+      ASSERT_EQ(*expected->model, *bags[static_cast<std::size_t>(i)]->model) << "bag " << i << ", threads " << threads;
+      ASSERT_EQ(expected->degenerate(), bags[static_cast<std::size_t>(i)]->degenerate());
+    }
+
+    int units = 0;
+    for (auto const& thread : report.threads) {
+      units += thread.units;
+      ASSERT_GE(thread.busy_ms, 0);
+      ASSERT_GE(thread.idle_ms, 0);
+    }
+
+    ASSERT_GT(report.retries, 0);
+    ASSERT_EQ(size + report.retries, units);
+    ASSERT_LE(report.threads.size(), static_cast<std::size_t>(threads));
+  }
+}
+
+TEST(ForestSchedule, NoRetriesWithoutBudget) {
+  ScheduleReport report;
+  auto const bags = train_bags(20, 0, 0, 2, leaf_bag, &report);
+
+  ASSERT_EQ(0, report.retries);
+
+  for (int i = 0; i < 20; ++i) {
+    ASSERT_EQ(*expected_bag(i, 20, 0, 0)->model, *bags[static_cast<std::size_t>(i)]->model);
+  }
+}
+
+TEST(ForestSchedule, RethrowsFirstFailureByIndex) {
+  auto const failing = [](RNG& rng, std::uint64_t stream) -> BaggedTree::Ptr {
+    BaggedTree::Ptr bag = leaf_bag(rng, stream);
+
+    if (!bag->degenerate()) {
+      throw std::runtime_error("bag failed");
+    }
+
+    return bag;
+  };
+
+  ASSERT_THROW(train_bags(10, 1, 2, 4, failing), std::runtime_error);
+}
+
+TEST(ForestSchedule, ForestReportsThreadLoad) {
+  RNG rng(0);
+  auto data = simulate(120, 4, 3, rng);
+
+  auto const spec = [](int threads) {
+    return TrainingSpec::builder(Mode::Classification).size(12).seed(2).threads(threads).build();
+  };
+
+  auto const sequential = ClassificationForest::train(spec(1), data.x, data.y);
+  auto const parallel   = ClassificationForest::train(spec(3), data.x, data.y);
+
+  ASSERT_EQ(*sequential, *parallel);
+
+  ASSERT_EQ(1u, sequential->schedule.threads.size());
+  ASSERT_EQ(12, sequential->schedule.threads[0].units);
+  ASSERT_GT(sequential->schedule.wall_ms, 0);
+
+  auto const j = parallel->schedule.to_json();
+  ASSERT_TRUE(j.contains("wall_ms"));
+  ASSERT_TRUE(j.contains("retries"));
+  ASSERT_EQ(parallel->schedule.threads.size(), j["threads"].size());
+}
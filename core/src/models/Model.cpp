@@ -1,8 +1,10 @@
 #include "models/Model.hpp"
+#include "models/CompiledForest.hpp"
 #include "models/Tree.hpp"
 #include "models/Forest.hpp"
 #include "utils/UserError.hpp"
 
+#include <memory>
 #include <string>
 
 namespace ppforest2 {
@@ -20,7 +22,47 @@ namespace ppforest2 {
     return std::shared_ptr<Tree>(Tree::train(spec, x, y).release());
   }
 
-  void Model::check_train_inputs(types::FeatureMatrix const& x, types::OutcomeVector const& y) {
+  Model::Ptr Model::train(TrainingSpec const& spec, types::FeatureView const& x, types::OutcomeVector& y) {
+    if (spec.is_forest()) {
+      return std::shared_ptr<Forest>(Forest::train(spec, x, y).release());
+    }
+
+    // A tree over the caller's own matrix reads it in place. Other views
+    // (double, reordered) are converted once: unlike a forest's bags, a
+    // single tree reads every row at its root.
+    if (types::FeatureMatrix const* const matrix = x.matrix()) {
+      return std::shared_ptr<Tree>(Tree::train(spec, *matrix, y).release());
+    }
+
+    types::FeatureMatrix owned = x.to_matrix();
+    return std::shared_ptr<Tree>(Tree::train(spec, owned, y).release());
+  }
+
+  int Model::resolve_threads() const {
+    return training_spec ? training_spec->resolve_threads() : 1;
+  }
+
+  std::shared_ptr<CompiledForest const> Model::compiled() const {
+    std::shared_ptr<CompiledForest const> kept = std::atomic_load(&compiled_cache);
+
+    if (!kept) {
+      auto fresh = std::make_shared<CompiledForest const>(CompiledForest::compile(*this));
+
+      // Keep the first result stored; a caller that lost the race takes
+      // the winner's, so concurrent first calls share one compiled form.
+      if (std::atomic_compare_exchange_strong(&compiled_cache, &kept, fresh)) {
+        kept = std::move(fresh);
+      }
+    }
+
+    return kept;
+  }
+
+  void Model::drop_compiled() {
+    std::atomic_store(&compiled_cache, std::shared_ptr<CompiledForest const>());
+  }
+
+  void Model::check_train_inputs(types::FeatureView const& x, types::OutcomeVector const& y) {
     user_error(y.size() > 0, "Training requires a non-empty response vector.");
     user_error(
         y.size() == x.rows(),
@@ -1,11 +1,13 @@
 #pragma once
 
 #include "models/TrainingSpec.hpp"
+#include "utils/FeatureView.hpp"
 #include "utils/Types.hpp"
 
 #include <memory>
 
 namespace ppforest2 {
+  struct CompiledForest;
   struct Tree;
   struct Forest;
 
@@ -47,6 +49,30 @@ namespace ppforest2 {
     /** @brief Accept a model visitor (double dispatch). */
     virtual void accept(Visitor& visitor) const = 0;
 
+    /**
+     * @brief Thread count for batch prediction.
+     *
+     * The training spec's `resolve_threads()`, so prediction runs with the
+     * same parallelism the model was trained with; 1 for a model without a
+     * spec (e.g. assembled by hand in tests). Callers that want a different
+     * count per call use `CompiledTree` / `CompiledForest` directly.
+     */
+    int resolve_threads() const;
+
+    /**
+     * @brief Flattened form of the model, compiled on first use and kept.
+     *
+     * Batch prediction (`predict(FeatureMatrix)`, proportions, the R
+     * bindings) scores through it, so scoring many batches against the
+     * same model flattens it once. Safe to call from several threads: a
+     * concurrent first call may compile twice, but every caller gets the
+     * one result that was kept. `Forest::add_tree` drops the model's
+     * copy; a caller holding the returned pointer keeps the old one alive.
+     *
+     * Throws like `CompiledForest::compile` (e.g. for an empty forest).
+     */
+    std::shared_ptr<CompiledForest const> compiled() const;
+
     /**
      * @brief Predict a single observation.
      *
@@ -88,6 +114,16 @@ namespace ppforest2 {
      */
     static Ptr train(TrainingSpec const& spec, types::FeatureMatrix& x, types::OutcomeVector& y);
 
+    /**
+     * @brief Train from a view over caller-owned data.
+     *
+     * Forests read the view bag by bag (see `Forest::train`). A single
+     * tree reads a view over a `FeatureMatrix` in place (see
+     * `Tree::train(TrainingSpec const&, FeatureMatrix const&, OutcomeVector&)`);
+     * any other view is converted to one owned copy.
+     */
+    static Ptr train(TrainingSpec const& spec, types::FeatureView const& x, types::OutcomeVector& y);
+
     /**
      * @brief Validate common training inputs (y non-empty, matching x rows).
      *
@@ -95,6 +131,14 @@ namespace ppforest2 {
      * at their entry points so both modes get the same validation and the
      * checks aren't duplicated per-mode.
      */
-    static void check_train_inputs(types::FeatureMatrix const& x, types::OutcomeVector const& y);
+    static void check_train_inputs(types::FeatureView const& x, types::OutcomeVector const& y);
+
+  protected:
+    /** @brief Forget the compiled form; called when the model's trees change. */
+    void drop_compiled();
+
+  private:
+    /** @brief Set once by `compiled()`; read and written atomically. */
+    mutable std::shared_ptr<CompiledForest const> compiled_cache;
   };
 }
@@ -0,0 +1,55 @@
+#include "models/NodeArena.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace ppforest2 {
+  namespace {
+    thread_local NodeArena* active_arena = nullptr;
+  }
+
+  void* NodeArena::allocate(std::size_t bytes, std::size_t alignment) {
+    auto const address    = reinterpret_cast<std::uintptr_t>(cursor);
+    std::size_t const pad = (alignment - address % alignment) % alignment;
+
+    if (cursor == nullptr || pad + bytes > remaining) {
+      // Oversized requests get a dedicated chunk; the padding slack keeps
+      // the recursive call from failing on alignment.
+      std::size_t const size = std::max(chunk_bytes, bytes + alignment);
+
+      chunks.emplace_back(new std::byte[size]);
+      cursor    = chunks.back().get();
+      remaining = size;
+
+      return allocate(bytes, alignment);
+    }
+
+    std::byte* const result = cursor + pad;
+
+    cursor = result + bytes;
+    remaining -= pad + bytes;
+    allocated += bytes;
+
+    return result;
+  }
+
+  void NodeArena::adopt(Ptr other) {
+    adopted.push_back(std::move(other));
+  }
+
+  NodeArena* NodeArena::current() {
+    return active_arena;
+  }
+
+  NodeArena::Scope::Scope(NodeArena& arena)
+      : Scope(&arena) {}
+
+  NodeArena::Scope::Scope(NodeArena* arena)
+      : previous(active_arena) {
+    active_arena = arena;
+  }
+
+  NodeArena::Scope::~Scope() {
+    active_arena = previous;
+  }
+}
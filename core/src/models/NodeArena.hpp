@@ -0,0 +1,190 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <set>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ppforest2 {
+  /**
+   * @brief Monotonic arena that owns the node storage of one tree.
+   *
+   * Nodes are carved out of large chunks instead of being individually
+   * `malloc`ed, so a tree's branches and leaves sit next to each other in
+   * memory and forest training threads stop contending on the global
+   * allocator for every node. Nothing is returned to the arena until it is
+   * destroyed; then every chunk is released at once.
+   *
+   * Arenas are thread-confined. While a `Scope` is alive on a thread,
+   * every `TreeBranch` / `TreeLeaf` allocated on that thread comes from
+   * its arena (see `TreeNode::operator new`), and so do the arrays a
+   * branch keeps (`ArenaArray`); outside a scope they go to the heap.
+   * Whoever opens the scope must keep the arena alive for as long as the
+   * nodes. `Tree::build_root` opens one per trained tree, whose arena
+   * `Tree::arena` then owns; a caller can also open its own:
+   *
+   * @code
+   *   auto arena = std::make_unique<NodeArena>();
+   *   {
+   *     NodeArena::Scope scope(*arena);
+   *     tree = Tree::train(spec, x, y);  // nodes in `arena`, tree->arena null
+   *   }
+   *   tree->arena = std::move(arena);
+   * @endcode
+   */
+  class NodeArena {
+  public:
+    using Ptr = std::unique_ptr<NodeArena>;
+
+    /** @brief Bytes per chunk; a few hundred nodes of a typical tree. */
+    static constexpr std::size_t chunk_bytes = 16 * 1024;
+
+    NodeArena() = default;
+
+    NodeArena(NodeArena const&)            = delete;
+    NodeArena& operator=(NodeArena const&) = delete;
+
+    /**
+     * @brief Reserve @p bytes aligned to @p alignment.
+     *
+     * Requests larger than a chunk get a chunk of their own.
+     */
+    void* allocate(std::size_t bytes, std::size_t alignment);
+
+    /** @brief Total bytes handed out so far (excluding alignment padding). */
+    std::size_t bytes_allocated() const { return allocated; }
+
+    /**
+     * @brief Keep @p other alive, and its nodes valid, for as long as this arena.
+     *
+     * Used when part of a tree is built on another thread, into an arena
+     * of its own.
+     */
+    void adopt(Ptr other);
+
+    /** @brief Arena the calling thread currently allocates nodes from, or null. */
+    static NodeArena* current();
+
+    /**
+     * @brief Route node allocations on this thread to an arena.
+     *
+     * Scopes nest: destruction restores the previously active arena.
+     */
+    class Scope {
+    public:
+      explicit Scope(NodeArena& arena);
+      /** @brief Route to @p arena, or to the heap when null (hiding any enclosing scope). */
+      explicit Scope(NodeArena* arena);
+      ~Scope();
+
+      Scope(Scope const&)            = delete;
+      Scope& operator=(Scope const&) = delete;
+
+    private:
+      NodeArena* previous;
+    };
+
+  private:
+    std::vector<std::unique_ptr<std::byte[]>> chunks;
+    std::byte* cursor     = nullptr;
+    std::size_t remaining = 0;
+    std::size_t allocated = 0;
+    std::vector<Ptr> adopted;
+  };
+
+  /**
+   * @brief Fixed-length array of plain values, stored like the node that owns it.
+   *
+   * Allocated from `NodeArena::current()` when a scope is open and from the
+   * heap otherwise, so a branch's group labels sit in the tree's arena
+   * next to the branch instead of in a separate heap block. Arena storage
+   * is released with the arena; only heap storage is freed by the
+   * destructor. A copy is allocated wherever the copying thread allocates
+   * nodes, as a cloned node is.
+   */
+  template<typename T> class ArenaArray {
+    static_assert(std::is_trivially_copyable_v<T>, "ArenaArray holds plain values only");
+
+  public:
+    ArenaArray() = default;
+
+    /** @brief @p size value-initialized elements. */
+    explicit ArenaArray(std::size_t size) {
+      allocate(size);
+      std::fill_n(items, count, T());
+    }
+
+    /** @brief Copy of `[first, last)`. */
+    template<typename Iterator> ArenaArray(Iterator first, Iterator last) {
+      allocate(static_cast<std::size_t>(std::distance(first, last)));
+      std::copy(first, last, items);
+    }
+
+    ArenaArray(std::initializer_list<T> values)
+        : ArenaArray(values.begin(), values.end()) {}
+
+    /** @brief The values of @p values, in ascending order. */
+    ArenaArray(std::set<T> const& values) // NOLINT(google-explicit-constructor)
+        : ArenaArray(values.begin(), values.end()) {}
+
+    ArenaArray(ArenaArray const& other)
+        : ArenaArray(other.begin(), other.end()) {}
+
+    ArenaArray(ArenaArray&& other) noexcept
+        : items(std::exchange(other.items, nullptr))
+        , count(std::exchange(other.count, 0))
+        , heap(std::move(other.heap)) {}
+
+    ArenaArray& operator=(ArenaArray other) noexcept {
+      std::swap(items, other.items);
+      std::swap(count, other.count);
+      std::swap(heap, other.heap);
+      return *this;
+    }
+
+    ~ArenaArray() = default;
+
+    T* data() { return items; }
+    T const* data() const { return items; }
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    T* begin() { return items; }
+    T* end() { return items + count; }
+    T const* begin() const { return items; }
+    T const* end() const { return items + count; }
+
+    T& operator[](std::size_t i) { return items[i]; }
+    T const& operator[](std::size_t i) const { return items[i]; }
+
+    bool operator==(ArenaArray const& other) const { return std::equal(begin(), end(), other.begin(), other.end()); }
+    bool operator!=(ArenaArray const& other) const { return !(*this == other); }
+
+  private:
+    T* items          = nullptr;
+    std::size_t count = 0;
+    /** @brief Owns the elements when they were allocated outside an arena. */
+    std::unique_ptr<T[]> heap;
+
+    void allocate(std::size_t size) {
+      if (size == 0) {
+        return;
+      }
+
+      if (NodeArena* const arena = NodeArena::current()) {
+        items = static_cast<T*>(arena->allocate(size * sizeof(T), alignof(T)));
+      } else {
+        heap  = std::make_unique<T[]>(size);
+        items = heap.get();
+      }
+
+      count = size;
+    }
+  };
+}
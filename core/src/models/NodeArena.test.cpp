@@ -0,0 +1,186 @@
+#include <gtest/gtest.h>
+
+#include "models/NodeArena.hpp"
+#include "models/ClassificationForest.hpp"
+#include "models/RegressionForest.hpp"
+#include "models/TreeBranch.hpp"
+#include "models/TreeLeaf.hpp"
+
+#include "models/TrainingSpec.hpp"
+#include "TestSpec.hpp"
+
+#include "stats/Simulation.hpp"
+#include "utils/Macros.hpp"
+
+#include <cstdint>
+#include <set>
+
+using namespace ppforest2;
+using namespace ppforest2::stats;
+using namespace ppforest2::types;
+
+TEST(NodeArena, AllocationsAreAligned) {
+  NodeArena arena;
+
+  for (std::size_t alignment : {1U, 8U, 16U, 64U}) {
+    void* const ptr = arena.allocate(3, alignment);
+    ASSERT_EQ(0U, reinterpret_cast<std::uintptr_t>(ptr) % alignment) << "alignment " << alignment;
+  }
+
+  ASSERT_EQ(12U, arena.bytes_allocated());
+}
+
+TEST(NodeArena, OversizedRequestGetsItsOwnChunk) {
+  NodeArena arena;
+
+  void* const small = arena.allocate(16, 16);
+  void* const large = arena.allocate(NodeArena::chunk_bytes * 2, 16);
+
+  ASSERT_NE(nullptr, small);
+  ASSERT_NE(nullptr, large);
+  ASSERT_EQ(16U + NodeArena::chunk_bytes * 2, arena.bytes_allocated());
+}
+
+TEST(NodeArena, ScopeRoutesNodeAllocations) {
+  NodeArena arena;
+  TreeNode::Ptr root;
+
+  ASSERT_EQ(nullptr, NodeArena::current());
+
+  {
+    NodeArena::Scope const scope(arena);
+    ASSERT_EQ(&arena, NodeArena::current());
+
+    root = TreeBranch::make(VEC(Feature, 1, 0), 0.5F, TreeLeaf::make(0), TreeLeaf::make(1));
+  }
+
+  ASSERT_EQ(nullptr, NodeArena::current());
+  ASSERT_GT(arena.bytes_allocated(), 0U);
+  ASSERT_EQ(1, root->predict(VEC(Feature, 1, 0)));
+
+  // Destroying arena nodes runs their destructors without freeing storage.
+  root.reset();
+}
+
+TEST(NodeArena, ScopeHoldsBranchArrays) {
+  NodeArena arena;
+  TreeNode::Ptr root;
+
+  {
+    NodeArena::Scope const scope(arena);
+    root = TreeBranch::make(VEC(Feature, 1, 0), 0.5F, TreeLeaf::make(0), TreeLeaf::make(1), {0, 1});
+  }
+
+  std::size_t const with_arrays = arena.bytes_allocated();
+
+  NodeArena bare;
+  {
+    NodeArena::Scope const scope(bare);
+    TreeNode::Ptr const node = TreeBranch::make(VEC(Feature, 1, 0), 0.5F, TreeLeaf::make(0), TreeLeaf::make(1));
+  }
+
+  ASSERT_GE(with_arrays, bare.bytes_allocated() + 2 * sizeof(GroupId));
+  ASSERT_EQ((std::set<GroupId>{0, 1}), root->node_groups());
+}
+
+TEST(NodeArena, ArenaArrayCopiesToTheHeapOutsideScope) {
+  NodeArena arena;
+  ArenaArray<int> inside;
+
+  {
+    NodeArena::Scope const scope(arena);
+    inside = ArenaArray<int>{3, 1, 2};
+  }
+
+  ArenaArray<int> const copy(inside);
+
+  ASSERT_EQ(3U * sizeof(int), arena.bytes_allocated());
+  ASSERT_EQ(inside, copy);
+  ASSERT_NE(inside.data(), copy.data());
+}
+
+TEST(NodeArena, ScopesNest) {
+  NodeArena outer;
+  NodeArena inner;
+
+  NodeArena::Scope const outer_scope(outer);
+
+  {
+    NodeArena::Scope const inner_scope(inner);
+    ASSERT_EQ(&inner, NodeArena::current());
+  }
+
+  ASSERT_EQ(&outer, NodeArena::current());
+}
+
+TEST(NodeArena, HeapNodesOutsideScope) {
+  TreeNode::Ptr leaf = TreeLeaf::make(2);
+  TreeNode::Ptr copy = leaf->clone();
+
+  ASSERT_EQ(*leaf, *copy);
+}
+
+TEST(NodeArena, ForestTreesOwnTheirArena) {
+  RNG rng(0);
+  auto data = simulate(90, 4, 3, rng);
+
+  auto forest = Forest::train(
+      TrainingSpec::builder(types::Mode::Classification).size(5).threads(1).vars(vars::uniform(2)).build(),
+      data.x,
+      data.y
+  );
+
+  for (auto const& tree : forest->trees) {
+    ASSERT_NE(nullptr, tree->model->arena);
+    ASSERT_GT(tree->model->arena->bytes_allocated(), 0U);
+  }
+}
+
+TEST(NodeArena, RegressionForestTreesOwnTheirArena) {
+  RNG rng(0);
+  auto data = simulate_regression(80, 3, rng);
+
+  auto spec = TrainingSpec::builder(types::Mode::Regression)
+                  .grouping(grouping::by_cutpoint())
+                  .leaf(leaf::mean_response())
+                  .stop(stop::any({stop::min_size(5), stop::min_variance(0.001F)}))
+                  .size(4)
+                  .threads(1)
+                  .build();
+
+  auto forest = Forest::train(spec, data.x, data.y);
+
+  for (auto const& tree : forest->trees) {
+    ASSERT_NE(nullptr, tree->model->arena);
+  }
+}
+
+TEST(NodeArena, StandaloneTreesOwnTheirArena) {
+  RNG rng(0);
+  auto data = simulate(90, 4, 3, rng);
+
+  auto const tree = Tree::train(TrainingSpec::builder(types::Mode::Classification).seed(1).build(), data.x, data.y);
+
+  ASSERT_NE(nullptr, tree->arena);
+  ASSERT_GT(tree->arena->bytes_allocated(), 0U);
+}
+
+TEST(NodeArena, TreeArenaHoldsOnlyItsNodes) {
+  RNG rng(2);
+  auto data = simulate(150, 8, 4, rng);
+
+  auto const tree = Tree::train(
+      TrainingSpec::builder(types::Mode::Classification).seed(3).vars(vars::uniform(2)).build(), data.x, data.y
+  );
+
+  // A clone allocates exactly the nodes and arrays the tree keeps; split
+  // searches must not have left anything else in the tree's arena.
+  NodeArena copy;
+  TreeNode::Ptr clone;
+  {
+    NodeArena::Scope const scope(copy);
+    clone = tree->root->clone();
+  }
+
+  ASSERT_EQ(copy.bytes_allocated(), tree->arena->bytes_allocated());
+}
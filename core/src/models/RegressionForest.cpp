@@ -1,6 +1,7 @@
 #include "models/RegressionForest.hpp"
 
 #include "models/Bagged.hpp"
+#include "models/ForestSchedule.hpp"
 #include "models/RegressionTree.hpp"
 #include "models/VIVisitor.hpp"
 #include "stats/RegressionMetrics.hpp"
@@ -14,6 +15,7 @@
 #include <cmath>
 #include <limits>
 #include <numeric>
+#include <optional>
 #include <stdexcept>
 
 namespace {
@@ -44,19 +46,12 @@ namespace {
     return ss / static_cast<double>(n);
   }
 
-  /** @brief Uniform sample with replacement: n indices drawn from [0, n-1]. */
-  std::vector<int> uniform_sample(int n, RNG& rng) {
-    std::vector<int> indices;
-    indices.reserve(n);
-
-    Uniform const unif(0, n - 1);
-
-    for (int j = 0; j < n; ++j) {
-      indices.push_back(unif(rng));
-    }
-
-    std::sort(indices.begin(), indices.end());
-    return indices;
+  /** @brief Uniform sampling with replacement: each bag draws n indices from [0, n-1]. */
+  Bootstrap::Ptr uniform_bootstrap(int n, int seed) {
+    auto bootstrap  = std::make_shared<Bootstrap>();
+    bootstrap->seed = seed;
+    bootstrap->strata.push_back({0, n});
+    return bootstrap;
   }
 
   /**
@@ -69,38 +64,81 @@ namespace {
    * the wrapper's role.
    */
   BaggedTree::Ptr train_regression_bag(
-      TrainingSpec::Ptr const& training_spec, FeatureMatrix const& x, RNG& rng, OutcomeVector const& y
+      TrainingSpec::Ptr const& training_spec,
+      FeatureView const& x,
+      OutcomeVector const& y,
+      Bootstrap::Ptr const& bootstrap,
+      RNG& rng,
+      std::uint64_t stream
   ) {
     invariant(y.size() == x.rows(), "Response size must match x.rows() for regression");
 
-    int const n_total = static_cast<int>(x.rows());
+    std::vector<int> sample_indices = bootstrap->draw(rng);
 
-    std::vector<int> sample_indices = uniform_sample(n_total, rng);
+    // With a weighted bootstrap each drawn row is kept once, with the
+    // number of times it was drawn; otherwise every draw is its own row.
+    std::optional<Draws> draws;
 
-    // Subsample x and y.
-    FeatureMatrix sampled_x = x(sample_indices, Eigen::all);
-    OutcomeVector sampled_y = y(sample_indices, Eigen::all).eval();
+    if (training_spec->weighted_bootstrap) {
+      draws = count_draws(sample_indices);
+    }
+
+    std::vector<int> const& drawn_rows = draws ? draws->rows : sample_indices;
+    OutcomeVector const sampled_y      = y(drawn_rows, Eigen::all).eval();
 
     // Sort sampled data by continuous response so ByCutpoint's
-    // contiguous-block invariant holds at the root.
+    // contiguous-block invariant holds at the root. The order is worked
+    // out on the response alone, so x is read in that order from the start.
     int const n = static_cast<int>(sampled_y.size());
     std::vector<int> order(static_cast<std::size_t>(n));
     std::iota(order.begin(), order.end(), 0);
 
     std::stable_sort(order.begin(), order.end(), [&sampled_y](int a, int b) { return sampled_y(a) < sampled_y(b); });
 
-    FeatureMatrix sorted_x(n, sampled_x.cols());
+    std::vector<int> sorted_rows(static_cast<std::size_t>(n));
     OutcomeVector sorted_y(n);
 
     for (int i = 0; i < n; ++i) {
-      sorted_x.row(i) = sampled_x.row(order[static_cast<std::size_t>(i)]);
-      sorted_y(i)     = sampled_y(order[static_cast<std::size_t>(i)]);
+      int const k = order[static_cast<std::size_t>(i)];
+
+      sorted_rows[static_cast<std::size_t>(i)] = drawn_rows[static_cast<std::size_t>(k)];
+      sorted_y(i)                              = sampled_y(k);
     }
 
-    // Build the initial median-split GroupPartition from the sorted response.
-    GroupPartition sampled_gp = training_spec->init_groups(sorted_y);
+    // A weighted bag over the caller's own matrix copies no rows: the
+    // tree reads that matrix through `sorted_rows`, which ByCutpoint
+    // reorders instead, and each node gathers only its own rows. Any other
+    // bag gathers its (distinct) rows once, already sorted and converted
+    // from the view's precision, for ByCutpoint to reorder in place.
+    FeatureMatrix const* const shared_x = draws ? x.matrix() : nullptr;
+    FeatureMatrix sorted_x;
 
-    RegressionTree::Ptr tree = RegressionTree::train(*training_spec, sorted_x, sorted_y, sampled_gp, rng);
+    if (shared_x == nullptr) {
+      sorted_x = x.gather(sorted_rows);
+    }
+
+    WeightVector sorted_weights;
+
+    if (draws) {
+      sorted_weights = draws->counts(order);
+    }
+
+    WeightVector* const weights = draws ? &sorted_weights : nullptr;
+
+    // Build the initial median-split GroupPartition from the sorted response.
+    GroupPartition sampled_gp = weights != nullptr ? training_spec->init_groups(sorted_y, *weights)
+                                                   : training_spec->init_groups(sorted_y);
+
+    // The tree's nodes go to an arena of its own (see `Tree::build_root`).
+    RegressionTree::Ptr tree =
+        shared_x != nullptr
+            ? RegressionTree::train(*training_spec, *shared_x, sorted_y, sampled_gp, rng, weights, sorted_rows)
+            : RegressionTree::train(*training_spec, sorted_x, sorted_y, sampled_gp, rng, weights);
+
+    // See train_classification_bag: a compact bag keeps only its stream.
+    if (training_spec->compact_samples) {
+      return std::make_unique<BaggedTree>(std::move(tree), bootstrap, stream);
+    }
 
     return std::make_unique<BaggedTree>(std::move(tree), std::move(sample_indices));
   }
@@ -128,7 +166,7 @@ namespace ppforest2 {
   }
 
   RegressionForest::Ptr
-  RegressionForest::train(TrainingSpec const& training_spec, FeatureMatrix const& x, OutcomeVector const& y) {
+  RegressionForest::train(TrainingSpec const& training_spec, FeatureView const& x, OutcomeVector const& y) {
     invariant(training_spec.mode == Mode::Regression, "RegressionForest::train requires mode = Regression");
 
     int const size        = training_spec.size;
@@ -147,45 +185,25 @@ namespace ppforest2 {
     // `train_regression_bag` rebuilds the initial partition from the
     // sampled, resorted response (each tree's OOB subset has different
     // median-split boundaries from the full dataset).
-    TrainingSpec::Ptr spec = TrainingSpec::make(training_spec);
-
-    std::vector<BaggedTree::Ptr> boots(size);
-    std::vector<std::exception_ptr> errors(size);
-
-    // clang-format off
-    #pragma omp parallel for schedule(static)
-    // clang-format on
-    for (int i = 0; i < size; ++i) {
-      for (int attempt = 0; attempt <= max_retries; ++attempt) {
-        try {
-          // Stream id `i + attempt * size` partitions `[0, size*(max_retries+1))`
-          // into disjoint blocks: attempt 0 uses ids [0, size), attempt 1 uses
-          // [size, 2*size), etc. Each (tree_index, attempt) pair gets a unique
-          // stream. This formula is load-bearing for golden-file reproducibility
-          // — changing either the loop bounds or the stride invalidates every
-          // regression golden file and breaks the determinism contract
-          // documented in CLAUDE.md (reproducibility across platforms).
-          uint64_t stream = static_cast<uint64_t>(i) + static_cast<uint64_t>(attempt) * static_cast<uint64_t>(size);
-          RNG rng(static_cast<uint64_t>(seed), stream);
-          boots[i] = train_regression_bag(spec, x, rng, y);
-
-          if (!boots[i]->degenerate()) {
-            break;
-          }
-        } catch (...) {
-          errors[i] = std::current_exception();
-          break;
-        }
-      }
-    }
+    TrainingSpec::Ptr spec         = TrainingSpec::make(training_spec);
+    Bootstrap::Ptr const bootstrap = uniform_bootstrap(static_cast<int>(x.rows()), seed);
+
+    ScheduleReport schedule;
+
+    std::vector<BaggedTree::Ptr> boots = train_bags(
+        size,
+        seed,
+        max_retries,
+        training_spec.resolve_threads(),
+        [&](RNG& rng, std::uint64_t stream) { return train_regression_bag(spec, x, y, bootstrap, rng, stream); },
+        &schedule
+    );
 
     auto forest = std::make_unique<RegressionForest>(spec);
 
-    for (int i = 0; i < size; ++i) {
-      if (errors[i]) {
-        std::rethrow_exception(errors[i]);
-      }
+    forest->schedule = std::move(schedule);
 
+    for (int i = 0; i < size; ++i) {
       if (boots[i]->degenerate()) {
         forest->degenerate = true;
       }
@@ -228,22 +246,17 @@ namespace ppforest2 {
     // undefined (there's no aggregation to perform), but "OOB stats over
     // zero trees" is well-defined (the empty average).
     int const n_total = static_cast<int>(x.rows());
-    int const B       = static_cast<int>(trees.size());
 
     std::vector<Feature> sums(static_cast<std::size_t>(n_total), Feature(0));
     std::vector<int> counts(static_cast<std::size_t>(n_total), 0);
 
-    for (int k = 0; k < B; ++k) {
-      BaggedTree const& tree   = *trees[k];
-      std::vector<int> oob_idx = tree.oob_indices(n_total);
-      OutcomeVector preds      = tree.predict_oob(x, oob_idx);
-
+    for_each_oob_prediction(x, [&](int, std::vector<int> const& oob_idx, OutcomeVector const& preds) {
       for (int j = 0; j < static_cast<int>(oob_idx.size()); ++j) {
         int i = oob_idx[static_cast<std::size_t>(j)];
         sums[static_cast<std::size_t>(i)] += static_cast<Feature>(preds(j));
         counts[static_cast<std::size_t>(i)] += 1;
       }
-    }
+    });
 
     // Sentinel: NaN for observations with no OOB tree. -1 would collide with
     // valid regression predictions. Callers filter with std::isnan.
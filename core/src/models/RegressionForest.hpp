@@ -25,7 +25,7 @@ namespace ppforest2 {
     // Bring the Forest::predict(FeatureMatrix) overload into scope.
     using Forest::predict;
 
-    static Ptr train(TrainingSpec const& training_spec, types::FeatureMatrix const& x, types::OutcomeVector const& y);
+    static Ptr train(TrainingSpec const& training_spec, types::FeatureView const& x, types::OutcomeVector const& y);
 
     types::Outcome predict(types::FeatureVector const& data) const override;
     types::FeatureMatrix predict(types::FeatureMatrix const& data, Proportions) const override;
@@ -172,6 +172,64 @@ TEST(RegressionForest, OobError) {
   EXPECT_NEAR(*oob_err, expected_mse, 1e-6);
 }
 
+TEST(RegressionForest, WeightedBootstrapKeepsDraws) {
+  auto data = make_regression_data(60, 0);
+
+  auto const spec = [](bool weighted) {
+    return TrainingSpec::builder(types::Mode::Regression)
+        .pp(pp::pda(0.0F))
+        .vars(vars::all())
+        .grouping(grouping::by_cutpoint())
+        .leaf(leaf::mean_response())
+        .stop(stop::any({stop::min_size(5), stop::min_variance(0.001F)}))
+        .size(8)
+        .seed(3)
+        .threads(1)
+        .weighted_bootstrap(weighted)
+        .build();
+  };
+
+  auto const expanded = Forest::train(spec(false), data.x, data.y);
+  auto const weighted = Forest::train(spec(true), data.x, data.y);
+
+  // Bags draw the same rows; only how the duplicates are stored differs.
+  for (std::size_t k = 0; k < expanded->trees.size(); ++k) {
+    ASSERT_EQ(expanded->trees[k]->sample_indices, weighted->trees[k]->sample_indices);
+  }
+
+  OutcomeVector const preds = weighted->predict(data.x);
+  double const expanded_mse = stats::mse(expanded->predict(data.x), data.y);
+
+  EXPECT_TRUE(preds.allFinite());
+  EXPECT_LT(stats::mse(preds, data.y), 2 * expanded_mse) << expanded_mse;
+}
+
+TEST(RegressionForest, WeightedBootstrapReadsCallerRows) {
+  auto data                    = make_regression_data(60, 1);
+  FeatureMatrix const original = data.x;
+
+  auto const spec = TrainingSpec::builder(types::Mode::Regression)
+                        .pp(pp::pda(0.0F))
+                        .vars(vars::uniform(1))
+                        .grouping(grouping::by_cutpoint())
+                        .leaf(leaf::mean_response())
+                        .stop(stop::min_size(5))
+                        .size(6)
+                        .threads(2)
+                        .weighted_bootstrap(true)
+                        .build();
+
+  // ByCutpoint reorders each tree's row map, never the caller's rows; over
+  // a double view each bag gathers its distinct drawn rows and trains the
+  // same forest.
+  Eigen::MatrixXd const x_double = data.x.cast<double>();
+  auto const from_matrix         = Forest::train(spec, data.x, data.y);
+  auto const from_doubles = Forest::train(spec, FeatureView(x_double.data(), x_double.rows(), x_double.cols()), data.y);
+
+  EXPECT_EQ(original, data.x);
+  EXPECT_EQ(from_matrix->predict(data.x), from_doubles->predict(data.x));
+}
+
 TEST(RegressionForest, ProportionsNotAllowed) {
   auto data = make_regression_data(40, 0);
   auto spec = make_regression_forest_spec(5);
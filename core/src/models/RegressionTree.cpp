@@ -25,16 +25,40 @@ namespace ppforest2 {
       FeatureMatrix& x,
       OutcomeVector& y,
       GroupPartition const& y_part,
-      stats::RNG& rng
+      stats::RNG& rng,
+      WeightVector* weights
   ) {
     invariant(training_spec.mode == Mode::Regression, "RegressionTree::train requires mode = Regression");
 
-    // ByCutpoint reorders rows of `x` and `y` in place on the caller's
-    // storage — no copy. Caller is responsible for providing a buffer
-    // it is willing to see mutated.
-    TreeNode::Ptr root_ptr = Tree::build_root(training_spec, x, y, y_part, rng);
+    // ByCutpoint reorders rows of `x` and `y` in
+    // place on the caller's storage — no copy. Caller is responsible for
+    // providing a buffer it is willing to see mutated.
+    Nodes nodes = Tree::build_root(training_spec, x, y, y_part, rng, weights);
 
-    return std::make_unique<RegressionTree>(std::move(root_ptr), TrainingSpec::make(training_spec));
+    auto tree   = std::make_unique<RegressionTree>(std::move(nodes.root), TrainingSpec::make(training_spec));
+    tree->arena = std::move(nodes.arena);
+
+    return tree;
+  }
+
+  RegressionTree::Ptr RegressionTree::train(
+      TrainingSpec const& training_spec,
+      FeatureMatrix const& x,
+      OutcomeVector& y,
+      GroupPartition const& y_part,
+      stats::RNG& rng,
+      WeightVector* weights,
+      std::vector<int>& source_rows
+  ) {
+    invariant(training_spec.mode == Mode::Regression, "RegressionTree::train requires mode = Regression");
+
+    // ByCutpoint reorders `source_rows`, `y` and `weights`; `x` is only read.
+    Nodes nodes = Tree::build_root(training_spec, x, y, y_part, rng, weights, source_rows);
+
+    auto tree   = std::make_unique<RegressionTree>(std::move(nodes.root), TrainingSpec::make(training_spec));
+    tree->arena = std::move(nodes.arena);
+
+    return tree;
   }
 
   FeatureMatrix RegressionTree::predict(FeatureMatrix const& /*data*/, Proportions) const {
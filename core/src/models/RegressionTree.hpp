@@ -45,13 +45,34 @@ namespace ppforest2 {
      *                       Will be permuted in place during training.
      * @param y_part     Initial root group partition (typically a median split).
      * @param rng            Random number generator.
+     * @param weights        Bootstrap count per row, or null for unit weights.
+     *                       Permuted in place along with `x`.
      */
     static Ptr train(
         TrainingSpec const& training_spec,
         types::FeatureMatrix& x,
         types::OutcomeVector& y,
         stats::GroupPartition const& y_part,
-        stats::RNG& rng
+        stats::RNG& rng,
+        types::WeightVector* weights = nullptr
+    );
+
+    /**
+     * @brief Train on rows @p source_rows of a read-only @p x.
+     *
+     * Training row `i` is row `source_rows[i]` of @p x; @p y and
+     * @p weights are indexed by training row. @p x is never written:
+     * row reordering permutes @p source_rows instead
+     * (see `Tree::build_root`).
+     */
+    static Ptr train(
+        TrainingSpec const& training_spec,
+        types::FeatureMatrix const& x,
+        types::OutcomeVector& y,
+        stats::GroupPartition const& y_part,
+        stats::RNG& rng,
+        types::WeightVector* weights,
+        std::vector<int>& source_rows
     );
 
     /** @brief Not supported for regression — throws. */
@@ -165,6 +165,34 @@ TEST(RegressionTree, Reproducible) {
   }
 }
 
+TEST(RegressionTree, TaskParallelMatchesSequentialPathStreams) {
+  auto data = make_regression_data(200, 0);
+
+  auto const spec_for = [](int cutoff, int threads) {
+    return TrainingSpec::builder(types::Mode::Regression)
+        .pp(pp::pda(0.0F))
+        .grouping(grouping::by_cutpoint())
+        .leaf(leaf::mean_response())
+        .stop(stop::any({stop::min_size(5), stop::min_variance(0.001F)}))
+        .task_cutoff(cutoff)
+        .threads(threads)
+        .build();
+  };
+
+  // Rows are reordered in place, so each tree trains on its own copy.
+  FeatureMatrix x_sequential = data.x;
+  OutcomeVector y_sequential = data.y;
+  FeatureMatrix x_tasks      = data.x;
+  OutcomeVector y_tasks      = data.y;
+
+  auto const sequential = Tree::train(spec_for(10000, 1), x_sequential, y_sequential);
+  auto const tasks      = Tree::train(spec_for(8, 4), x_tasks, y_tasks);
+
+  ASSERT_EQ(*sequential, *tasks);
+  ASSERT_EQ(x_sequential, x_tasks);
+  ASSERT_EQ(y_sequential, y_tasks);
+}
+
 TEST(RegressionTree, ConstantResponse) {
   // All y values are the same; tree should immediately hit min_variance stop.
   int const n = 30;
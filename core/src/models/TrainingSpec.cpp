@@ -37,7 +37,11 @@ namespace ppforest2 {
         size_,
         seed_,
         threads_,
-        max_retries_
+        max_retries_,
+        task_cutoff_,
+        weighted_bootstrap_,
+        compact_samples_,
+        cache_scatter_
     );
   }
 
@@ -80,7 +84,11 @@ namespace ppforest2 {
       int size,
       int seed,
       int threads,
-      int max_retries
+      int max_retries,
+      int task_cutoff,
+      bool weighted_bootstrap,
+      bool compact_samples,
+      bool cache_scatter
   )
       : pp(std::move(pp))
       , vars(std::move(vars))
@@ -93,7 +101,11 @@ namespace ppforest2 {
       , size(size)
       , seed(seed)
       , threads(threads)
-      , max_retries(max_retries) {
+      , max_retries(max_retries)
+      , task_cutoff(task_cutoff)
+      , weighted_bootstrap(weighted_bootstrap)
+      , compact_samples(compact_samples)
+      , cache_scatter(cache_scatter) {
     // Mode-strategy compatibility check. Fails fast at spec construction.
     check_supports(this->pp, "pp", mode);
     check_supports(this->vars, "vars", mode);
@@ -121,6 +133,23 @@ namespace ppforest2 {
         {"max_retries", max_retries},
     };
 
+    // Only written when set, so specs that don't use it export as before.
+    if (task_cutoff > 0) {
+      j["task_cutoff"] = task_cutoff;
+    }
+
+    if (weighted_bootstrap) {
+      j["weighted_bootstrap"] = true;
+    }
+
+    if (compact_samples) {
+      j["compact_samples"] = true;
+    }
+
+    if (cache_scatter) {
+      j["cache_scatter"] = true;
+    }
+
     return j;
   }
 
@@ -132,6 +161,10 @@ namespace ppforest2 {
         .seed(j.value("seed", 0))
         .threads(j.value("threads", 0))
         .max_retries(j.value("max_retries", 3))
+        .task_cutoff(j.value("task_cutoff", 0))
+        .weighted_bootstrap(j.value("weighted_bootstrap", false))
+        .compact_samples(j.value("compact_samples", false))
+        .cache_scatter(j.value("cache_scatter", false))
         .pp(pp::ProjectionPursuit::from_json(j.at("pp")))
         .vars(vars::VariableSelection::from_json(j.at("vars")))
         .cutpoint(cutpoint::Cutpoint::from_json(j.at("cutpoint")))
@@ -198,8 +231,8 @@ namespace ppforest2 {
     types::GroupId lower = *it;
     types::GroupId upper = *std::next(it);
 
-    types::Feature const mean_lower = y_part.group(ctx.x, lower).colwise().mean().dot(*ctx.projector);
-    types::Feature const mean_upper = y_part.group(ctx.x, upper).colwise().mean().dot(*ctx.projector);
+    types::Feature const mean_lower = ctx.x_group(y_part, lower).colwise().mean().dot(*ctx.projector);
+    types::Feature const mean_upper = ctx.x_group(y_part, upper).colwise().mean().dot(*ctx.projector);
 
     if (mean_lower > mean_upper) {
       std::swap(lower, upper);
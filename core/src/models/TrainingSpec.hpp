@@ -69,6 +69,44 @@ namespace ppforest2 {
     int const threads;
     /** @brief Maximum retry attempts for degenerate trees. */
     int const max_retries;
+    /**
+     * @brief Minimum node size (rows) at which subtrees are grown as parallel tasks (0 = sequential).
+     *
+     * When set, each node draws from an RNG stream derived from its path
+     * in the tree instead of sharing the tree's stream, so the tree
+     * depends on the seed but not on this cutoff, the thread count or the
+     * task schedule. Trees grown with 0 keep the shared stream and are
+     * therefore not comparable with trees grown with a cutoff.
+     */
+    int const task_cutoff;
+    /**
+     * @brief Train each bag on its distinct rows, weighted by draw count.
+     *
+     * A bootstrap sample holds about 63% of the rows, many of them more
+     * than once. With this set the tree reads each drawn row once, in
+     * place through its index, and every strategy counts it as often as
+     * it was drawn, instead of copying every duplicate into a bag matrix.
+     */
+    bool const weighted_bootstrap;
+    /**
+     * @brief Keep each bag's RNG stream instead of its sample indices.
+     *
+     * A bag's sample is the first draw from its stream, so out-of-bag
+     * queries draw it again on demand (see `Bootstrap`). Saves n indices
+     * per tree in memory and in the JSON export.
+     */
+    bool const compact_samples;
+    /**
+     * @brief Read label-grouped nodes' scatter from per-block cached moments.
+     *
+     * Each block's moments are computed once per tree (see
+     * `stats::ScatterCache`) instead of at every node. Cached and row-wise
+     * scatter agree only up to rounding, which PDA can amplify on
+     * ill-conditioned nodes, so this is off by default. It pays off when
+     * nodes read most columns; on wide data with small random variable
+     * subsets the cache fills tiles that few nodes read again.
+     */
+    bool const cache_scatter;
 
     /**
      * @brief Fluent builder for TrainingSpec.
@@ -96,10 +134,14 @@ namespace ppforest2 {
 
       types::Mode const mode_;
 
-      int size_        = 0;
-      int seed_        = 0;
-      int threads_     = 0;
-      int max_retries_ = 3;
+      int size_                = 0;
+      int seed_                = 0;
+      int threads_             = 0;
+      int max_retries_         = 3;
+      int task_cutoff_         = 0;
+      bool weighted_bootstrap_ = false;
+      bool compact_samples_    = false;
+      bool cache_scatter_      = false;
 
       explicit Builder(types::Mode mode);
 
@@ -148,6 +190,22 @@ namespace ppforest2 {
         max_retries_ = v;
         return *this;
       }
+      Builder& task_cutoff(int v) {
+        task_cutoff_ = v;
+        return *this;
+      }
+      Builder& weighted_bootstrap(bool v) {
+        weighted_bootstrap_ = v;
+        return *this;
+      }
+      Builder& compact_samples(bool v) {
+        compact_samples_ = v;
+        return *this;
+      }
+      Builder& cache_scatter(bool v) {
+        cache_scatter_ = v;
+        return *this;
+      }
 
       /**
        * @brief Finalize the builder into a `TrainingSpec`.
@@ -186,6 +244,10 @@ namespace ppforest2 {
      * @param seed         RNG seed.
      * @param threads      Number of threads (0 = hardware concurrency).
      * @param max_retries  Maximum retry attempts for degenerate trees.
+     * @param task_cutoff  Minimum node size for parallel subtree tasks (0 = sequential).
+     * @param weighted_bootstrap  Train bags on distinct rows with draw counts.
+     * @param compact_samples     Keep bag streams instead of sample indices.
+     * @param cache_scatter       Read label-grouped scatter from cached block moments.
      */
     TrainingSpec(
         pp::ProjectionPursuit::Ptr pp,
@@ -199,7 +261,11 @@ namespace ppforest2 {
         int size,
         int seed,
         int threads,
-        int max_retries
+        int max_retries,
+        int task_cutoff = 0,
+        bool weighted_bootstrap = false,
+        bool compact_samples = false,
+        bool cache_scatter = false
     );
 
     // -- Forwarding methods (delegate to the underlying strategy) -----------
@@ -237,6 +303,11 @@ namespace ppforest2 {
     /** @brief Create the initial group partition from the training response. */
     stats::GroupPartition init_groups(types::OutcomeVector const& y) const { return grouping->init(y); }
 
+    /** @brief Create the initial group partition from bootstrap-weighted rows. */
+    stats::GroupPartition init_groups(types::OutcomeVector const& y, types::WeightVector const& weights) const {
+      return grouping->init(y, weights);
+    }
+
     /** @brief Create a leaf node from the current node context. */
     TreeNode::Ptr create_leaf(NodeContext const& ctx, stats::RNG& rng) const { return (*leaf)(ctx, rng); }
 
@@ -89,6 +89,39 @@ TEST(TrainingSpec, ToJsonRoundTripSingleTree) {
   EXPECT_EQ(j, restored->to_json());
 }
 
+TEST(TrainingSpec, TaskCutoffRoundTrip) {
+  auto const spec = TrainingSpec::builder(types::Mode::Classification).task_cutoff(64).make();
+
+  auto j        = spec->to_json();
+  auto restored = TrainingSpec::from_json(j);
+
+  EXPECT_EQ(64, j.at("task_cutoff"));
+  EXPECT_EQ(64, restored->task_cutoff);
+  EXPECT_FALSE(TrainingSpec::builder(types::Mode::Classification).make()->to_json().contains("task_cutoff"));
+}
+
+TEST(TrainingSpec, WeightedBootstrapRoundTrip) {
+  auto const spec = TrainingSpec::builder(types::Mode::Classification).weighted_bootstrap(true).make();
+
+  auto j        = spec->to_json();
+  auto restored = TrainingSpec::from_json(j);
+
+  EXPECT_EQ(true, j.at("weighted_bootstrap"));
+  EXPECT_TRUE(restored->weighted_bootstrap);
+  EXPECT_FALSE(TrainingSpec::builder(types::Mode::Classification).make()->to_json().contains("weighted_bootstrap"));
+}
+
+TEST(TrainingSpec, CacheScatterRoundTrip) {
+  auto const spec = TrainingSpec::builder(types::Mode::Classification).cache_scatter(true).make();
+
+  auto j        = spec->to_json();
+  auto restored = TrainingSpec::from_json(j);
+
+  EXPECT_EQ(true, j.at("cache_scatter"));
+  EXPECT_TRUE(restored->cache_scatter);
+  EXPECT_FALSE(TrainingSpec::builder(types::Mode::Classification).make()->to_json().contains("cache_scatter"));
+}
+
 // ---------------------------------------------------------------------------
 // from_json — default values for optional fields
 // ---------------------------------------------------------------------------
@@ -1,16 +1,31 @@
 #include "models/Tree.hpp"
 
 #include "models/ClassificationTree.hpp"
+#include "models/CompiledForest.hpp"
 #include "models/Model.hpp"
 #include "models/RegressionTree.hpp"
 #include "models/TreeBranch.hpp"
+#include "models/NodeArena.hpp"
 #include "models/VIVisitor.hpp"
 #include "models/strategies/NodeContext.hpp"
+#include "stats/ScatterCache.hpp"
 #include "stats/Stats.hpp"
-
+#include "utils/Scratch.hpp"
+
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <numeric>
+#include <optional>
+#include <set>
 #include <stack>
+#include <vector>
 #include <Eigen/Dense>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace ppforest2::pp;
 using namespace ppforest2::stats;
 using namespace ppforest2::types;
@@ -26,10 +41,52 @@ namespace ppforest2 {
       return leaf;
     }
 
+    /**
+     * @brief Whether the tree's nodes read their scatter from a `ScatterCache`.
+     *
+     * Only when the spec asks for it. Decided once, at the root, and
+     * passed down: a subtree has fewer blocks and could fit the cache
+     * budget where the root did not, but cached and row-wise scatter agree
+     * only up to rounding, so every node of a tree must take the same path
+     * whatever task it is grown in.
+     */
+    bool caches_moments(TrainingSpec const& spec, GroupPartition const& root, FeatureMatrix const& x) {
+      return spec.cache_scatter && spec.grouping->keeps_blocks() &&
+             stats::ScatterCache::fits(root.groups.size(), x.cols());
+    }
+
+    /**
+     * @brief Per-node RNG streams derived from each node's path, for task-parallel growth.
+     *
+     * A node's stream depends only on the tree's base value and the
+     * lower/upper turns from the root, never on which thread grows the
+     * node or when, so subtrees can be grown in any order.
+     */
+    struct NodeStreams {
+      std::uint64_t base;
+      int task_cutoff;
+
+      static constexpr std::uint64_t root = 1;
+
+      /** @brief Path key of the lower (`side = 0`) or upper (`side = 1`) child of @p path. */
+      static std::uint64_t child(std::uint64_t path, int side) {
+        // splitmix64 finalizer: distinct keys at any depth, unlike 2k + side.
+        std::uint64_t z = path + 0x9E3779B97F4A7C15ULL * static_cast<std::uint64_t>(side + 1);
+        z               = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z               = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+      }
+
+      stats::RNG rng(std::uint64_t path) const { return stats::RNG(base, path); }
+
+      bool spawns(GroupPartition const& node) const { return node.total_size() >= task_cutoff; }
+    };
+
     struct Step {
       GroupPartition y;
       TreeNode::Ptr* node;
       int depth;
+      std::uint64_t path;
 
       bool pop               = false;
       TreeNode::Ptr upper    = nullptr;
@@ -38,87 +95,408 @@ namespace ppforest2 {
       Feature pp_index_value = 0;
       Projector projector;
 
-      Step(GroupPartition const& y, TreeNode::Ptr* node, int const cols, int depth = 0)
+      Step(GroupPartition const& y, TreeNode::Ptr* node, int const cols, int depth, std::uint64_t path)
           : y(y)
           , node(node)
           , depth(depth)
+          , path(path)
           , projector(Projector::Zero(cols)) {}
     };
 
+    /** @brief Pending nodes of one `grow` call, held in its scratch region. */
+    using StepStack = std::stack<Step, std::deque<Step, utils::ScratchAllocator<Step>>>;
+
+    void save_split(Step& step, NodeContext const& ctx) {
+      step.projector      = *ctx.projector;
+      step.cutpoint       = *ctx.cutpoint;
+      step.pp_index_value = *ctx.pp_index_value;
+      step.pop            = true;
+    }
+
     void push_children(
         Step& step,
         NodeContext const& ctx,
         GroupPartition const& lower_y_part,
         GroupPartition const& upper_y_part,
         FeatureMatrix const& x,
-        std::stack<Step>& stack
+        StepStack& stack
     ) {
-      step.projector      = *ctx.projector;
-      step.cutpoint       = *ctx.cutpoint;
-      step.pp_index_value = *ctx.pp_index_value;
-
-      stack.emplace(lower_y_part, &step.lower, x.cols(), step.depth + 1);
-      stack.emplace(upper_y_part, &step.upper, x.cols(), step.depth + 1);
+      save_split(step, ctx);
 
-      step.pop = true;
+      stack.emplace(lower_y_part, &step.lower, x.cols(), step.depth + 1, NodeStreams::child(step.path, 0));
+      stack.emplace(upper_y_part, &step.upper, x.cols(), step.depth + 1, NodeStreams::child(step.path, 1));
     }
 
-  }
-
-  TreeNode::Ptr Tree::build_root(
-      TrainingSpec const& spec, FeatureMatrix& x, OutcomeVector& y, GroupPartition const& partition, stats::RNG& rng
-  ) {
-    std::stack<Step> stack;
+    TreeNode::Ptr grow(
+        TrainingSpec const& spec,
+        FeatureMatrix const& x,
+        FeatureMatrix* movable_x,
+        OutcomeVector& y,
+        WeightVector* weights,
+        std::vector<int>* source_rows,
+        GroupPartition const& partition,
+        int depth,
+        std::uint64_t path,
+        stats::ScatterCache* scatter_cache,
+        stats::RNG& rng,
+        NodeStreams const* streams
+    );
+
+    /**
+     * @brief Grow both children of @p step, the upper one as an OpenMP task.
+     *
+     * The two subtrees own disjoint row ranges, so regression's in-place
+     * reordering in one never touches the other's rows. The task builds
+     * into an arena of its own (adopted by the current one afterwards) or
+     * onto the heap, never into whatever arena its thread happens to have
+     * open. Exceptions are carried past the `taskwait`.
+     */
+    void grow_children_in_tasks(
+        Step& step,
+        TrainingSpec const& spec,
+        FeatureMatrix const& x,
+        FeatureMatrix* movable_x,
+        OutcomeVector& y,
+        WeightVector* weights,
+        std::vector<int>* source_rows,
+        GroupPartition const& lower_y_part,
+        GroupPartition const& upper_y_part,
+        stats::ScatterCache* scatter_cache,
+        stats::RNG& rng,
+        NodeStreams const& streams
+    ) {
+      NodeArena* const arena     = NodeArena::current();
+      NodeArena::Ptr upper_arena = arena != nullptr ? std::make_unique<NodeArena>() : nullptr;
+
+      std::exception_ptr upper_error;
+      std::exception_ptr lower_error;
+
+      // clang-format off
+      #pragma omp task default(shared)
+      // clang-format on
+      {
+        try {
+          NodeArena::Scope const scope(upper_arena.get());
+          std::uint64_t const path = NodeStreams::child(step.path, 1);
+          step.upper = grow(
+              spec,
+              x,
+              movable_x,
+              y,
+              weights,
+              source_rows,
+              upper_y_part,
+              step.depth + 1,
+              path,
+              scatter_cache,
+              rng,
+              &streams
+          );
+        } catch (...) {
+          upper_error = std::current_exception();
+        }
+      }
 
-    TreeNode::Ptr root;
+      try {
+        std::uint64_t const path = NodeStreams::child(step.path, 0);
+        step.lower = grow(
+            spec,
+            x,
+            movable_x,
+            y,
+            weights,
+            source_rows,
+            lower_y_part,
+            step.depth + 1,
+            path,
+            scatter_cache,
+            rng,
+            &streams
+        );
+      } catch (...) {
+        lower_error = std::current_exception();
+      }
 
-    stack.emplace(partition, &root, x.cols());
+      // clang-format off
+      #pragma omp taskwait
+      // clang-format on
 
-    while (!stack.empty()) {
-      Step& step = stack.top();
+      if (upper_arena) {
+        arena->adopt(std::move(upper_arena));
+      }
 
-      if (step.pop) {
-        *step.node = TreeBranch::make(
-            step.projector,
-            step.cutpoint,
-            std::move(step.lower),
-            std::move(step.upper),
-            step.y.groups,
-            step.pp_index_value
-        );
+      for (auto const& error : {lower_error, upper_error}) {
+        if (error) {
+          std::rethrow_exception(error);
+        }
+      }
+    }
 
-        stack.pop();
-        continue;
+    /**
+     * @brief Grow the subtree rooted at @p partition.
+     *
+     * Without @p streams every node draws from @p rng in depth-first
+     * order. With @p streams each node draws from its own path-derived
+     * stream, and nodes of at least `task_cutoff` rows grow their two
+     * subtrees in parallel.
+     *
+     * Growth stays depth first. The nodes of one level own disjoint rows,
+     * so a breadth-first builder would only recover the parallelism the
+     * subtree tasks already give, while holding every level's partitions.
+     *
+     * Pending steps, and the partitions they carry, live in a scratch
+     * region released when the subtree is done. Whatever a node's
+     * strategies allocate lives in a second region, rewound before the
+     * next node. Strategies run with node allocations routed to the heap:
+     * only the leaves and branches the tree keeps go into its arena.
+     */
+    TreeNode::Ptr grow(
+        TrainingSpec const& spec,
+        FeatureMatrix const& x,
+        FeatureMatrix* movable_x,
+        OutcomeVector& y,
+        WeightVector* weights,
+        std::vector<int>* source_rows,
+        GroupPartition const& partition,
+        int depth,
+        std::uint64_t path,
+        stats::ScatterCache* scatter_cache,
+        stats::RNG& rng,
+        NodeStreams const* streams
+    ) {
+      utils::ScratchArena steps;
+      utils::ScratchArena node;
+      utils::ScratchArena::Scope const in_steps(steps);
+
+      StepStack stack;
+      TreeNode::Ptr root;
+
+      stack.emplace(partition, &root, x.cols(), depth, path);
+
+      while (!stack.empty()) {
+        Step& step = stack.top();
+
+        if (step.pop) {
+          *step.node = TreeBranch::make(
+              step.projector,
+              step.cutpoint,
+              std::move(step.lower),
+              std::move(step.upper),
+              ArenaArray<GroupId>(step.y.groups.begin(), step.y.groups.end()),
+              step.pp_index_value
+          );
+
+          stack.pop();
+          continue;
+        }
+
+        node.reset();
+
+        std::optional<stats::RNG> path_rng;
+
+        if (streams != nullptr) {
+          path_rng.emplace(streams->rng(step.path));
+        }
+
+        stats::RNG& node_rng = path_rng ? *path_rng : rng;
+
+        NodeContext ctx(x, step.y, y, step.depth);
+        ctx.movable_x     = movable_x;
+        ctx.scatter_cache = scatter_cache;
+        ctx.weights       = weights;
+        ctx.source_rows   = source_rows;
+
+        utils::ScratchArena::Scope const in_node(node);
+        bool stop = false;
+
+        {
+          NodeArena::Scope const off_tree(nullptr);
+
+          stop = spec.should_stop(ctx, node_rng);
+
+          if (!stop) {
+            spec.select_vars(ctx, node_rng);
+
+            spec.find_projection(ctx, node_rng);
+            if (step.y.groups.size() > 2) {
+              spec.regroup(ctx, node_rng);
+              spec.find_projection(ctx, node_rng);
+            }
+            spec.find_cutpoint(ctx, node_rng);
+            spec.group(ctx, node_rng);
+          }
+        }
+
+        if (stop) {
+          *step.node = spec.create_leaf(ctx, node_rng);
+          stack.pop();
+          continue;
+        }
+
+        if (ctx.aborted) {
+          *step.node = degenerate_leaf(spec, ctx, node_rng);
+          stack.pop();
+          continue;
+        }
+
+        if (streams != nullptr && streams->spawns(step.y)) {
+          // Children are grown before this step is revisited, so the
+          // branch is assembled by the `pop` case above.
+          save_split(step, ctx);
+          grow_children_in_tasks(
+              step,
+              spec,
+              x,
+              movable_x,
+              y,
+              weights,
+              source_rows,
+              *ctx.lower_y_part,
+              *ctx.upper_y_part,
+              scatter_cache,
+              rng,
+              *streams
+          );
+          continue;
+        }
+
+        // Child steps copy their partitions out of the node's region.
+        utils::ScratchArena::Scope const back_to_steps(steps);
+        push_children(step, ctx, *ctx.lower_y_part, *ctx.upper_y_part, x, stack);
       }
 
-      NodeContext ctx(x, step.y, y, step.depth);
+      return root;
+    }
 
-      if (spec.should_stop(ctx, rng)) {
-        *step.node = spec.create_leaf(ctx, rng);
-        stack.pop();
-        continue;
+    /** @brief Grow a whole tree into the calling thread's node arena. */
+    TreeNode::Ptr grow_tree(
+        TrainingSpec const& spec,
+        FeatureMatrix const& x,
+        FeatureMatrix* movable_x,
+        OutcomeVector& y,
+        GroupPartition const& partition,
+        stats::RNG& rng,
+        WeightVector* weights,
+        std::vector<int>* source_rows
+    ) {
+      // Label blocks stay put below the root, so their moments are shared
+      // by every node of the tree, whatever task grows it.
+      std::optional<stats::ScatterCache> cache;
+
+      if (caches_moments(spec, partition, x)) {
+        cache.emplace(x, weights, source_rows);
       }
 
-      spec.select_vars(ctx, rng);
+      stats::ScatterCache* const scatter_cache = cache ? &*cache : nullptr;
 
-      spec.find_projection(ctx, rng);
-      if (step.y.groups.size() > 2) {
-        spec.regroup(ctx, rng);
-        spec.find_projection(ctx, rng);
+      if (spec.task_cutoff <= 0) {
+        return grow(
+            spec, x, movable_x, y, weights, source_rows, partition, 0, NodeStreams::root, scatter_cache, rng, nullptr
+        );
       }
-      spec.find_cutpoint(ctx, rng);
-      spec.group(ctx, rng);
 
-      if (ctx.aborted) {
-        *step.node = degenerate_leaf(spec, ctx, rng);
-        stack.pop();
-        continue;
+      // One 64-bit draw from the tree's stream seeds every node stream.
+      std::uint64_t const high = rng();
+      NodeStreams const streams{(high << 32) | rng(), spec.task_cutoff};
+
+      // clang-format off
+      #ifdef _OPENMP
+      // Inside a forest's parallel loop the tasks go to the forest's team;
+      // on its own a tree opens a team for them.
+      if (!omp_in_parallel() && spec.resolve_threads() > 1) {
+        NodeArena* const arena = NodeArena::current();
+        TreeNode::Ptr root;
+        std::exception_ptr error;
+
+        #pragma omp parallel num_threads(spec.resolve_threads())
+        #pragma omp single
+        {
+          try {
+            NodeArena::Scope const scope(arena);
+            root = grow(
+                spec,
+                x,
+                movable_x,
+                y,
+                weights,
+                source_rows,
+                partition,
+                0,
+                NodeStreams::root,
+                scatter_cache,
+                rng,
+                &streams
+            );
+          } catch (...) {
+            error = std::current_exception();
+          }
+        }
+
+        if (error) {
+          std::rethrow_exception(error);
+        }
+
+        return root;
       }
+      #endif
+      // clang-format on
 
-      push_children(step, ctx, *ctx.lower_y_part, *ctx.upper_y_part, x, stack);
+      return grow(
+          spec, x, movable_x, y, weights, source_rows, partition, 0, NodeStreams::root, scatter_cache, rng, &streams
+      );
     }
 
-    return root;
+    /**
+     * @brief Grow a tree into the caller's node arena, or into @p own_arena when no scope is open.
+     *
+     * A caller that opened a scope keeps the nodes in its arena; any other
+     * tree gets an arena of its own, returned through @p own_arena.
+     */
+    TreeNode::Ptr grow_in_arena(
+        NodeArena::Ptr& own_arena,
+        TrainingSpec const& spec,
+        FeatureMatrix const& x,
+        FeatureMatrix* movable_x,
+        OutcomeVector& y,
+        GroupPartition const& partition,
+        stats::RNG& rng,
+        WeightVector* weights,
+        std::vector<int>* source_rows
+    ) {
+      if (NodeArena::current() == nullptr) {
+        own_arena = std::make_unique<NodeArena>();
+      }
+
+      NodeArena::Scope const scope(own_arena ? own_arena.get() : NodeArena::current());
+      return grow_tree(spec, x, movable_x, y, partition, rng, weights, source_rows);
+    }
+  }
+
+  Tree::Nodes Tree::build_root(
+      TrainingSpec const& spec,
+      FeatureMatrix& x,
+      OutcomeVector& y,
+      GroupPartition const& partition,
+      stats::RNG& rng,
+      WeightVector* weights
+  ) {
+    Nodes nodes;
+    nodes.root = grow_in_arena(nodes.arena, spec, x, &x, y, partition, rng, weights, nullptr);
+    return nodes;
+  }
+
+  Tree::Nodes Tree::build_root(
+      TrainingSpec const& spec,
+      FeatureMatrix const& x,
+      OutcomeVector& y,
+      GroupPartition const& partition,
+      stats::RNG& rng,
+      WeightVector* weights,
+      std::vector<int>& source_rows
+  ) {
+    Nodes nodes;
+    nodes.root = grow_in_arena(nodes.arena, spec, x, nullptr, y, partition, rng, weights, &source_rows);
+    return nodes;
   }
 
   // ---------------------------------------------------------------------------
@@ -156,9 +534,7 @@ namespace ppforest2 {
   }
 
   OutcomeVector Tree::predict(FeatureMatrix const& data) const {
-    return OutcomeVector::NullaryExpr(data.rows(), [&](Eigen::Index i) {
-      return predict(static_cast<FeatureVector>(data.row(i)));
-    });
+    return compiled()->trees.front().predict(data, resolve_threads());
   }
 
   bool Tree::operator==(Tree const& other) const {
@@ -193,4 +569,24 @@ namespace ppforest2 {
 
     return tree;
   }
+
+  Tree::Ptr Tree::train(TrainingSpec const& spec, FeatureMatrix const& x, OutcomeVector& y) {
+    Model::check_train_inputs(x, y);
+
+    stats::RNG rng(spec.seed);
+    GroupPartition const y_part = spec.init_groups(y);
+
+    std::vector<int> rows(static_cast<std::size_t>(x.rows()));
+    std::iota(rows.begin(), rows.end(), 0);
+
+    Tree::Ptr tree;
+
+    if (spec.mode == types::Mode::Regression) {
+      tree = RegressionTree::train(spec, x, y, y_part, rng, nullptr, rows);
+    } else {
+      tree = ClassificationTree::train(spec, x, y, y_part, rng, nullptr, rows);
+    }
+
+    return tree;
+  }
 }
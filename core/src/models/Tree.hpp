@@ -4,6 +4,7 @@
 
 #include "models/Bagged.hpp"
 #include "models/Model.hpp"
+#include "models/NodeArena.hpp"
 #include "models/TreeNode.hpp"
 #include "models/VariableImportance.hpp"
 
@@ -30,6 +31,15 @@ namespace ppforest2 {
   struct Tree : public Model {
     using Ptr = std::unique_ptr<Tree>;
 
+    /**
+     * @brief Storage of the nodes when the tree owns it.
+     *
+     * Set for trained trees; null for trees built onto the heap (e.g.
+     * deserialized) or into an arena their caller owns. Declared before
+     * `root` so the nodes are destroyed before the memory backing them.
+     */
+    NodeArena::Ptr arena;
+
     /** @brief Root node of the tree. */
     TreeNode::Ptr root;
 
@@ -62,6 +72,16 @@ namespace ppforest2 {
     /** @copydoc Tree::train(TrainingSpec const&, FeatureMatrix&, OutcomeVector&) */
     static Ptr train(TrainingSpec const& spec, types::FeatureMatrix& x, types::OutcomeVector& y, stats::RNG& rng);
 
+    /**
+     * @brief Train a tree without writing @p x.
+     *
+     * Tree rows read @p x through an identity row map, which regression's
+     * `ByCutpoint` permutes instead of moving rows (see `build_root`), so
+     * the caller's matrix is neither copied nor reordered. @p y is still
+     * permuted during regression training.
+     */
+    static Ptr train(TrainingSpec const& spec, types::FeatureMatrix const& x, types::OutcomeVector& y);
+
     /**
      * @brief Predict a single observation.
      *
@@ -71,7 +91,14 @@ namespace ppforest2 {
      */
     types::Outcome predict(types::FeatureVector const& data) const override;
 
-    /** @brief Predict each row of a feature matrix. */
+    /**
+     * @brief Predict each row of a feature matrix.
+     *
+     * Walks every row through the tree's compiled form (`compiled()`,
+     * flattened on the first call) — same results as
+     * `predict(FeatureVector)` per row, without the per-level virtual
+     * dispatch.
+     */
     types::OutcomeVector predict(types::FeatureMatrix const& data) const override;
 
     /**
@@ -109,6 +136,12 @@ namespace ppforest2 {
   protected:
     Tree(TreeNode::Ptr root, TrainingSpec::Ptr training_spec);
 
+    /** @brief A grown tree's root and, when the build created one, the arena holding its nodes. */
+    struct Nodes {
+      NodeArena::Ptr arena;
+      TreeNode::Ptr root;
+    };
+
     /**
      * @brief Build the root node of a tree.
      *
@@ -116,6 +149,11 @@ namespace ppforest2 {
      * implementation used by `ClassificationTree::train` and
      * `RegressionTree::train`.
      *
+     * Nodes go to the calling thread's `NodeArena` when a
+     * `NodeArena::Scope` is open; otherwise the build opens one over a
+     * new arena and returns it with the root, for the tree to own.
+     * Training scratch never enters the arena (see `utils::ScratchArena`).
+     *
      * `x` and `y` are mutable: regression's `ByCutpoint` grouping strategy
      * reorders rows in place. Classification doesn't mutate either — the
      * reference is still non-const to keep the signature uniform across
@@ -128,14 +166,34 @@ namespace ppforest2 {
      * @param y          Response vector. Same mutation contract as `x`.
      * @param partition  Initial group partition for the root node.
      * @param rng        Random number generator (tree-local).
-     * @return           Root `TreeNode` of the constructed tree.
+     * @param weights    Bootstrap count of each row, or null when every
+     *                   row stands for itself. Reordered along with `x`.
+     * @return           Root `TreeNode` of the constructed tree, with its arena.
      */
-    static TreeNode::Ptr build_root(
+    static Nodes build_root(
         TrainingSpec const& spec,
         types::FeatureMatrix& x,
         types::OutcomeVector& y,
         stats::GroupPartition const& partition,
-        stats::RNG& rng
+        stats::RNG& rng,
+        types::WeightVector* weights = nullptr
+    );
+
+    /**
+     * @brief `build_root` over a read-only matrix, through a row map.
+     *
+     * Tree row `i` reads row `source_rows[i]` of @p x. Strategies that
+     * reorder rows reorder @p source_rows (with @p y and @p weights)
+     * instead, so @p x is never written (see `NodeContext::source_rows`).
+     */
+    static Nodes build_root(
+        TrainingSpec const& spec,
+        types::FeatureMatrix const& x,
+        types::OutcomeVector& y,
+        stats::GroupPartition const& partition,
+        stats::RNG& rng,
+        types::WeightVector* weights,
+        std::vector<int>& source_rows
     );
   };
 
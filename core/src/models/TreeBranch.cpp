@@ -16,7 +16,7 @@ namespace ppforest2 {
       Feature cutpoint,
       TreeNode::Ptr lower,
       TreeNode::Ptr upper,
-      std::set<GroupId> groups,
+      ArenaArray<GroupId> groups,
       Feature pp_index_value
   )
       : projector(std::move(projector))
@@ -63,7 +63,7 @@ namespace ppforest2 {
       Feature cutpoint,
       TreeNode::Ptr lower,
       TreeNode::Ptr upper,
-      std::set<GroupId> groups,
+      ArenaArray<GroupId> groups,
       Feature pp_index_value
   ) {
     return std::make_unique<TreeBranch>(
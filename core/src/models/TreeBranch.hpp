@@ -1,5 +1,6 @@
 #pragma once
 
+#include "models/NodeArena.hpp"
 #include "models/TreeNode.hpp"
 #include "models/Projector.hpp"
 #include "utils/Types.hpp"
@@ -24,8 +25,12 @@ namespace ppforest2 {
     /** @brief Child node for observations with projected value ≥ cutpoint. */
     TreeNode::Ptr upper;
 
-    /** @brief Set of group labels reachable from this node. */
-    std::set<types::GroupId> groups;
+    /**
+     * @brief Group labels reachable from this node, in ascending order.
+     *
+     * Kept in the tree's `NodeArena` with the branch when it has one.
+     */
+    ArenaArray<types::GroupId> groups;
     /** @brief Projection pursuit index value achieved at this split. */
     types::Feature pp_index_value = 0;
 
@@ -34,8 +39,8 @@ namespace ppforest2 {
         types::Feature cutpoint,
         TreeNode::Ptr lower,
         TreeNode::Ptr upper,
-        std::set<types::GroupId> groups = {},
-        types::Feature pp_index_value   = 0
+        ArenaArray<types::GroupId> groups = {},
+        types::Feature pp_index_value     = 0
     );
 
     void accept(TreeNode::Visitor& visitor) const override;
@@ -58,7 +63,7 @@ namespace ppforest2 {
 
     int group_count() const override { return static_cast<int>(groups.size()); }
 
-    std::set<types::GroupId> node_groups() const override { return groups; }
+    std::set<types::GroupId> node_groups() const override { return {groups.begin(), groups.end()}; }
 
     bool equals(TreeNode const& other) const override;
     TreeNode::Ptr clone() const override;
@@ -69,8 +74,8 @@ namespace ppforest2 {
         types::Feature cutpoint,
         TreeNode::Ptr lower,
         TreeNode::Ptr upper,
-        std::set<types::GroupId> groups = {},
-        types::Feature pp_index_value   = 0
+        ArenaArray<types::GroupId> groups = {},
+        types::Feature pp_index_value     = 0
     );
   };
 }
@@ -1,7 +1,15 @@
-
 #include "models/TreeNode.hpp"
 
+#include "models/NodeArena.hpp"
+
+#include <new>
+
 namespace ppforest2 {
+  namespace {
+    // Keeps the node behind the header aligned like any `new` result.
+    constexpr std::size_t node_header = alignof(std::max_align_t);
+  }
+
   bool TreeNode::operator==(TreeNode const& other) const {
     return this->equals(other);
   }
@@ -9,4 +17,26 @@ namespace ppforest2 {
   bool TreeNode::operator!=(TreeNode const& other) const {
     return !this->equals(other);
   }
+
+  void* TreeNode::operator new(std::size_t bytes) {
+    NodeArena* const arena = NodeArena::current();
+
+    void* const base = arena != nullptr ? arena->allocate(node_header + bytes, node_header)
+                                        : ::operator new(node_header + bytes);
+
+    ::new (base) bool(arena != nullptr);
+    return static_cast<std::byte*>(base) + node_header;
+  }
+
+  void TreeNode::operator delete(void* ptr) noexcept {
+    if (ptr == nullptr) {
+      return;
+    }
+
+    void* const base = static_cast<std::byte*>(ptr) - node_header;
+
+    if (!*static_cast<bool*>(base)) {
+      ::operator delete(base);
+    }
+  }
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <set>
 
@@ -70,5 +71,15 @@ namespace ppforest2 {
 
     bool operator==(TreeNode const& other) const;
     bool operator!=(TreeNode const& other) const;
+
+    /**
+     * @brief Allocate a node from `NodeArena::current()`, or the heap if no arena is active.
+     *
+     * Each allocation carries a small header recording its origin, so
+     * `delete` through `TreeNode::Ptr` frees heap nodes and leaves arena
+     * nodes to be released with their arena.
+     */
+    static void* operator new(std::size_t bytes);
+    static void operator delete(void* ptr) noexcept;
   };
 }
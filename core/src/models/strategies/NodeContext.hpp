@@ -3,9 +3,11 @@
 #include "models/Projector.hpp"
 #include "models/strategies/vars/VariableSelection.hpp"
 #include "stats/GroupPartition.hpp"
+#include "stats/ScatterCache.hpp"
 #include "utils/Types.hpp"
 
 #include <optional>
+#include <vector>
 
 using Projector = ppforest2::pp::Projector;
 
@@ -18,15 +20,16 @@ namespace ppforest2 {
    * reads what it needs and writes its results back.
    */
   struct NodeContext {
+    /** @brief Full feature matrix. Strategies read it; only `ByCutpoint` moves rows, through `movable_x`. */
+    types::FeatureMatrix const& x;
     /**
-     * @brief Full feature matrix.
+     * @brief `x` for in-place row reordering, or null when `x` is read-only.
      *
-     * Non-const because regression's `ByCutpoint` grouping strategy
-     * reorders rows in place within each node's range. Classification
-     * strategies only read — there's no mode-specific subtype, so the
-     * const promise lives at the strategy level, not in the context.
+     * Regression's `ByCutpoint` moves rows within each node's range here.
+     * Null for contexts built over a const matrix, which read their rows
+     * through `source_rows` and reorder that map instead.
      */
-    types::FeatureMatrix& x;
+    types::FeatureMatrix* movable_x;
     /** @brief Original G-group partition for this node. */
     stats::GroupPartition const& y;
     /** @brief Depth of this node in the tree. */
@@ -50,11 +53,41 @@ namespace ppforest2 {
      *
      * Regression strategies (`MeanResponse` leaf, `MinVariance` stop,
      * `ByCutpoint` grouping) read or reorder it; classification
-     * strategies ignore it. Non-const for the same reason as `x`.
+     * strategies ignore it. Non-const because `ByCutpoint` reorders it.
      * Always set — no mode-conditional logic at the call site.
      */
     types::OutcomeVector* y_vec;
 
+    /**
+     * @brief Per-row multiplicities under the count-weighted bootstrap, or null.
+     *
+     * Row `i` of `x` stands for `(*weights)(i)` copies of one sampled
+     * observation; every statistic a strategy computes counts it that
+     * many times. Null means every row counts once. Row order matches
+     * `x`, and `ByCutpoint` reorders it with `x` and `y_vec`.
+     */
+    types::WeightVector* weights = nullptr;
+
+    /**
+     * @brief Row of `x` each tree row reads, or null when tree row `i` is row `i` of `x`.
+     *
+     * Set for count-weighted bags, which train on the forest's matrix
+     * through their distinct drawn rows instead of a copy of them. Tree
+     * rows (partition blocks, `y_vec`, `weights`) index this vector, so
+     * strategies read `x(x_rows(rows), cols)`, and `ByCutpoint` reorders
+     * it with `y_vec` and `weights` instead of moving rows of `x`.
+     */
+    std::vector<int>* source_rows = nullptr;
+
+    /**
+     * @brief Per-tree block moments of `x`, or null.
+     *
+     * Set by `Tree::build_root` when the grouping keeps the root's row
+     * blocks (`Grouping::keeps_blocks`); PDA then builds its scatter
+     * matrices from it instead of gathering the node's rows.
+     */
+    stats::ScatterCache* scatter_cache = nullptr;
+
     /** @brief Set by select_vars: variable selection result. `std::nullopt` before select_vars runs. */
     std::optional<vars::VariableSelection::Result> var_selection;
 
@@ -87,8 +120,18 @@ namespace ppforest2 {
     std::optional<stats::GroupPartition> lower_y_part;
     std::optional<stats::GroupPartition> upper_y_part;
 
+    /** @brief Context over a matrix strategies may reorder in place. */
     NodeContext(types::FeatureMatrix& x, stats::GroupPartition const& y, types::OutcomeVector& y_vec, int depth)
         : x(x)
+        , movable_x(&x)
+        , y(y)
+        , depth(depth)
+        , y_vec(&y_vec) {}
+
+    /** @brief Context over a read-only matrix; set `source_rows` before a strategy reorders rows. */
+    NodeContext(types::FeatureMatrix const& x, stats::GroupPartition const& y, types::OutcomeVector& y_vec, int depth)
+        : x(x)
+        , movable_x(nullptr)
         , y(y)
         , depth(depth)
         , y_vec(&y_vec) {}
@@ -100,5 +143,21 @@ namespace ppforest2 {
      * Before binarization (or for 2-group nodes), returns the original partition.
      */
     stats::GroupPartition const& active_partition() const { return y_bin.has_value() ? *y_bin : y; }
+
+    /** @brief Rows of `x` that tree rows @p rows read (see `source_rows`). */
+    stats::GroupPartition::Rows x_rows(stats::GroupPartition::Rows rows) const {
+      if (source_rows != nullptr) {
+        for (int& row : rows) {
+          row = (*source_rows)[static_cast<std::size_t>(row)];
+        }
+      }
+
+      return rows;
+    }
+
+    /** @brief Rows of `x` read by @p group of @p partition, as `partition.group(x, group)` without a row map. */
+    auto x_group(stats::GroupPartition const& partition, types::GroupId group) const {
+      return x(x_rows(partition.group_rows(group)), Eigen::all);
+    }
   };
 }
@@ -2,10 +2,10 @@
 
 #include "models/strategies/NodeContext.hpp"
 #include "utils/Invariant.hpp"
+#include "utils/Scratch.hpp"
 
 #include <algorithm>
 #include <cmath>
-#include <map>
 #include <tuple>
 #include <vector>
 
@@ -21,17 +21,41 @@ namespace ppforest2::binarize {
 
   void LargestGap::regroup(NodeContext& ctx, RNG& /*rng*/) const {
     invariant(ctx.projector.has_value(), "LargestGap requires projector on NodeContext");
-    FeatureMatrix const projected_x = ctx.x * *ctx.projector;
-    ctx.y_bin.emplace(compute(projected_x, ctx.y));
+    // Project only the node's rows; the binary mapping is expressed in
+    // group labels, so it applies unchanged to the node's own partition.
+    GroupPartition::Rows const rows = ctx.y.row_indices();
+    utils::ScratchMatrix<Feature> const projected_x(ctx.x(ctx.x_rows(rows), Eigen::all) * *ctx.projector);
+
+    if (ctx.weights != nullptr) {
+      WeightVector const weights = (*ctx.weights)(rows);
+      ctx.y_bin.emplace(ctx.y.remap(binary_mapping(projected_x.matrix(), ctx.y.compact(), &weights)));
+      return;
+    }
+
+    ctx.y_bin.emplace(ctx.y.remap(binary_mapping(projected_x.matrix(), ctx.y.compact())));
   }
 
-  GroupPartition LargestGap::compute(FeatureMatrix const& projected_x, GroupPartition const& y) const {
+  GroupPartition LargestGap::compute(Eigen::Ref<FeatureMatrix const> const& projected_x, GroupPartition const& y) const {
+    return y.remap(binary_mapping(projected_x, y));
+  }
+
+  GroupPartition::GroupMap LargestGap::binary_mapping(
+      Eigen::Ref<FeatureMatrix const> const& projected_x, GroupPartition const& y, WeightVector const* weights
+  ) {
     std::vector<std::tuple<GroupId, Feature>> means;
 
     invariant(projected_x.cols() == 1, "Binary regrouping requires unidimensional data");
 
     for (GroupId const group : y.groups) {
-      Feature const group_mean = y.group(projected_x, group).mean();
+      Feature group_mean = 0;
+
+      if (weights == nullptr) {
+        group_mean = y.group(projected_x, group).mean();
+      } else {
+        FeatureVector const projected = y.group(projected_x, group);
+        FeatureVector const counts    = y.group(*weights, group).cast<Feature>();
+        group_mean                    = projected.dot(counts) / counts.sum();
+      }
       means.emplace_back(group, group_mean);
     }
 
@@ -55,15 +79,15 @@ namespace ppforest2::binarize {
       edge_group = std::get<0>(means.front());
     }
 
-    std::map<GroupId, int> binary_mapping;
+    GroupPartition::GroupMap mapping;
 
     bool edge_found = false;
     for (auto const& [group, mean] : means) {
-      edge_found            = edge_found || group == edge_group;
-      binary_mapping[group] = edge_found ? 1 : 0;
+      edge_found     = edge_found || group == edge_group;
+      mapping[group] = edge_found ? 1 : 0;
     }
 
-    return y.remap(binary_mapping);
+    return mapping;
   }
 
   Binarization::Ptr largest_gap() {
@@ -26,7 +26,22 @@ namespace ppforest2::binarize {
     /**
      * @brief Direct computation: binarize from projected data and partition.
      */
-    stats::GroupPartition compute(types::FeatureMatrix const& projected_x, stats::GroupPartition const& y) const;
+    stats::GroupPartition
+    compute(Eigen::Ref<types::FeatureMatrix const> const& projected_x, stats::GroupPartition const& y) const;
+
+    /**
+     * @brief Group label → binary group (0 below the gap, 1 above).
+     *
+     * Only reads group means, so @p y may be a compacted partition over a
+     * node-local @p projected_x; the mapping then applies to the node's
+     * original partition as well. With @p weights (aligned with
+     * @p projected_x) the means are count-weighted.
+     */
+    static stats::GroupPartition::GroupMap binary_mapping(
+        Eigen::Ref<types::FeatureMatrix const> const& projected_x,
+        stats::GroupPartition const& y,
+        types::WeightVector const* weights = nullptr
+    );
 
     static Binarization::Ptr from_json(nlohmann::json const& j);
 
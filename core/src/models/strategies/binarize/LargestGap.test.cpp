@@ -161,6 +161,29 @@ TEST(LargestGapBinarize, NodeContextInterface) {
   EXPECT_EQ(ctx.y_bin->groups.size(), 2U); // NOLINT(bugprone-unchecked-optional-access)
 }
 
+TEST(LargestGapBinarize, NodeContextSubsetKeepsOriginalRows) {
+  // Node owns groups {1, 2, 3} only; group 0's rows must be ignored and the
+  // binary partition must still address rows of the full matrix.
+  FeatureMatrix x       = MAT(Feature, rows(8), 500, 0, 501, 0, 1, 0, 2, 0, 3, 0, 4, 0, 100, 0, 101, 0);
+  GroupIdVector const y = VEC(GroupId, 0, 0, 1, 1, 2, 2, 3, 3);
+  GroupPartition const gp = GroupPartition(y).subset({1, 2, 3});
+  RNG rng(0);
+
+  OutcomeVector ov = y.cast<Outcome>();
+  NodeContext ctx(x, gp, ov, 0);
+  ctx.projector = VEC(Feature, 1, 0);
+
+  LargestGap const lg;
+  lg.regroup(ctx, rng);
+
+  ASSERT_TRUE(ctx.y_bin.has_value());
+  auto const& y_bin = *ctx.y_bin; // NOLINT(bugprone-unchecked-optional-access)
+
+  EXPECT_EQ((std::set<GroupId>{1, 2}), y_bin.subgroups.at(0));
+  EXPECT_EQ((std::set<GroupId>{3}), y_bin.subgroups.at(1));
+  EXPECT_EQ_DATA(y_bin.group(x, 1), MAT(Feature, rows(2), 100, 0, 101, 0));
+}
+
 TEST(LargestGapBinarize, DisplayName) {
   LargestGap const lg;
   EXPECT_EQ(lg.display_name(), "Largest gap");
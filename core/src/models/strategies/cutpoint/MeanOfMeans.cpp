@@ -19,9 +19,17 @@ namespace ppforest2::cutpoint {
     auto const& y_part = ctx.active_partition();
     auto g1            = *y_part.groups.begin();
     auto g2            = *std::next(y_part.groups.begin());
-    auto data_1        = y_part.group(ctx.x, g1);
-    auto data_2        = y_part.group(ctx.x, g2);
-    ctx.cutpoint       = compute(data_1, data_2, *ctx.projector);
+    auto data_1        = ctx.x_group(y_part, g1);
+    auto data_2        = ctx.x_group(y_part, g2);
+
+    if (ctx.weights != nullptr) {
+      WeightVector const weights_1 = y_part.group(*ctx.weights, g1);
+      WeightVector const weights_2 = y_part.group(*ctx.weights, g2);
+      ctx.cutpoint                 = compute(data_1, data_2, *ctx.projector, weights_1, weights_2);
+      return;
+    }
+
+    ctx.cutpoint = compute(data_1, data_2, *ctx.projector);
   }
 
   Feature MeanOfMeans::compute(
@@ -30,6 +38,20 @@ namespace ppforest2::cutpoint {
     return ((group_1 * projector).mean() + (group_2 * projector).mean()) / 2;
   }
 
+  Feature MeanOfMeans::compute(
+      FeatureMatrix const& group_1,
+      FeatureMatrix const& group_2,
+      ppforest2::pp::Projector const& projector,
+      WeightVector const& weights_1,
+      WeightVector const& weights_2
+  ) const {
+    auto const weighted_mean = [&](FeatureMatrix const& group, WeightVector const& weights) {
+      return (group * projector).dot(weights.cast<Feature>()) / static_cast<Feature>(weights.sum());
+    };
+
+    return (weighted_mean(group_1, weights_1) + weighted_mean(group_2, weights_2)) / 2;
+  }
+
   Cutpoint::Ptr mean_of_means() {
     return std::make_shared<MeanOfMeans>();
   }
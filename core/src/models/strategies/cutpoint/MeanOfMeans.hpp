@@ -34,6 +34,15 @@ namespace ppforest2::cutpoint {
         ppforest2::pp::Projector const& projector
     ) const;
 
+    /** @brief Count-weighted `compute`: row `i` of each group counts @p weights_k(i) times. */
+    types::Feature compute(
+        types::FeatureMatrix const& group_1,
+        types::FeatureMatrix const& group_2,
+        ppforest2::pp::Projector const& projector,
+        types::WeightVector const& weights_1,
+        types::WeightVector const& weights_2
+    ) const;
+
     static Cutpoint::Ptr from_json(nlohmann::json const& j);
 
     PPFOREST2_REGISTER_STRATEGY(Cutpoint, "mean_of_means")
@@ -2,6 +2,7 @@
 
 #include "models/strategies/NodeContext.hpp"
 #include "utils/Invariant.hpp"
+#include "utils/Scratch.hpp"
 
 #include <algorithm>
 #include <numeric>
@@ -27,16 +28,102 @@ namespace ppforest2::grouping {
     return GroupPartition::two_groups(0, mid - 1, mid, n - 1);
   }
 
+  /**
+   * @brief Rows of [start, end] in the lower half of the weight.
+   *
+   * The smallest count whose cumulative weight reaches half the total
+   * (rounded down), kept within [1, n-1]. With unit weights this is `n / 2`,
+   * the unweighted median split.
+   */
+  static int weighted_mid(WeightVector const& weights, int start, int end) {
+    int const n    = end - start + 1;
+    int const half = weights.segment(start, n).sum() / 2;
+
+    int mid        = 0;
+    int cumulative = 0;
+
+    while (mid < n - 1 && cumulative < half) {
+      cumulative += weights(start + mid);
+      ++mid;
+    }
+
+    return std::max(mid, 1);
+  }
+
+  GroupPartition ByCutpoint::init(OutcomeVector const& y, WeightVector const& weights) const {
+    int const n = static_cast<int>(y.size());
+    invariant(n > 0, "ByCutpoint::init requires a non-empty response vector");
+    invariant(weights.size() == n, "ByCutpoint::init requires one weight per row");
+
+    if (n < 2) {
+      return GroupPartition::single_group(0, n - 1);
+    }
+
+    int const mid = weighted_mid(weights, 0, n - 1);
+    return GroupPartition::two_groups(0, mid - 1, mid, n - 1);
+  }
+
+  /**
+   * @brief Move row `start + order[i]` to `start + i` in x, continuous_y and the weights.
+   *
+   * With a row map (`NodeContext::source_rows`) the map's entries move
+   * instead of x's rows, and @p x may be null.
+   */
+  static void permute_rows(
+      FeatureMatrix* x,
+      std::vector<int>* source_rows,
+      OutcomeVector& continuous_y,
+      WeightVector* weights,
+      utils::ScratchVector<int> const& order,
+      int start
+  ) {
+    int const n = static_cast<int>(order.size());
+
+    OutcomeVector y_tmp = continuous_y.segment(start, n);
+
+    for (int i = 0; i < n; ++i) {
+      continuous_y(start + i) = y_tmp(order[static_cast<std::size_t>(i)]);
+    }
+
+    if (source_rows != nullptr) {
+      utils::ScratchVector<int> const rows_tmp(source_rows->begin() + start, source_rows->begin() + start + n);
+
+      for (int i = 0; i < n; ++i) {
+        int const from                                      = order[static_cast<std::size_t>(i)];
+        (*source_rows)[static_cast<std::size_t>(start + i)] = rows_tmp[static_cast<std::size_t>(from)];
+      }
+    } else {
+      invariant(x != nullptr, "ByCutpoint: a read-only x needs a row map to reorder");
+
+      utils::ScratchMatrix<Feature> const x_tmp(x->middleRows(start, n));
+
+      for (int i = 0; i < n; ++i) {
+        x->row(start + i) = x_tmp.matrix().row(order[static_cast<std::size_t>(i)]);
+      }
+    }
+
+    if (weights != nullptr) {
+      WeightVector const w_tmp = weights->segment(start, n);
+
+      for (int i = 0; i < n; ++i) {
+        (*weights)(start + i) = w_tmp(order[static_cast<std::size_t>(i)]);
+      }
+    }
+  }
+
   /**
    * @brief Partition rows in [start, end] by projected value vs cutpoint.
    *
-   * Reorders x and continuous_y in place so that rows with projected
-   * value < cutpoint come first. Returns the index of the first right-child
+   * Reorders x (or its row map), continuous_y and (when not null) the row weights in place
+   * so that rows with projected value < cutpoint come first. Returns the index of the first right-child
    * row (i.e., left child owns [start, mid-1], right owns [mid, end]).
    */
   static int partition_by_cutpoint(
-      FeatureMatrix& x,
+      FeatureMatrix const& x,
+      FeatureMatrix* movable_x,
+      std::vector<int>* source_rows,
       OutcomeVector& continuous_y,
+      WeightVector* weights,
       pp::Projector const& projector,
       Feature cutpoint,
       int start,
@@ -46,11 +133,12 @@ namespace ppforest2::grouping {
     FeatureVector projected(n);
 
     for (int i = 0; i < n; ++i) {
-      projected(i) = x.row(start + i).dot(projector);
+      int const row = source_rows != nullptr ? (*source_rows)[static_cast<std::size_t>(start + i)] : start + i;
+      projected(i)  = x.row(row).dot(projector);
     }
 
     // Build index array and partition: left (projected < cutpoint) first.
-    std::vector<int> order(static_cast<std::size_t>(n));
+    utils::ScratchVector<int> order(static_cast<std::size_t>(n));
     std::iota(order.begin(), order.end(), 0);
 
     auto pivot = std::stable_partition(order.begin(), order.end(), [&](int i) { return projected(i) < cutpoint; });
@@ -58,13 +146,7 @@ namespace ppforest2::grouping {
     int const left_count = static_cast<int>(std::distance(order.begin(), pivot));
 
     // Apply permutation to x and continuous_y.
-    FeatureMatrix x_tmp = x.middleRows(start, n);
-    OutcomeVector y_tmp = continuous_y.segment(start, n);
-
-    for (int i = 0; i < n; ++i) {
-      x.row(start + i)        = x_tmp.row(order[static_cast<std::size_t>(i)]);
-      continuous_y(start + i) = y_tmp(order[static_cast<std::size_t>(i)]);
-    }
+    permute_rows(movable_x, source_rows, continuous_y, weights, order, start);
 
     return start + left_count;
   }
@@ -72,42 +154,44 @@ namespace ppforest2::grouping {
   /**
    * @brief Sort rows in [start, end] by continuous_y value (ascending).
    *
-   * Reorders x and continuous_y in place.
+   * Reorders x (or its row map), continuous_y and (when not null) the row weights in place.
    */
-  static void sort_by_continuous_y(FeatureMatrix& x, OutcomeVector& continuous_y, int start, int end) {
+  static void sort_by_continuous_y(
+      FeatureMatrix* x,
+      std::vector<int>* source_rows,
+      OutcomeVector& continuous_y,
+      WeightVector* weights,
+      int start,
+      int end
+  ) {
     int const n = end - start + 1;
 
     if (n <= 1) {
       return;
     }
 
-    std::vector<int> order(static_cast<std::size_t>(n));
+    utils::ScratchVector<int> order(static_cast<std::size_t>(n));
     std::iota(order.begin(), order.end(), 0);
 
     std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
       return continuous_y(start + a) < continuous_y(start + b);
     });
 
-    FeatureMatrix x_tmp = x.middleRows(start, n);
-    OutcomeVector y_tmp = continuous_y.segment(start, n);
-
-    for (int i = 0; i < n; ++i) {
-      x.row(start + i)        = x_tmp.row(order[static_cast<std::size_t>(i)]);
-      continuous_y(start + i) = y_tmp(order[static_cast<std::size_t>(i)]);
-    }
+    permute_rows(x, source_rows, continuous_y, weights, order, start);
   }
 
   /**
    * @brief Create a 2-group partition by median-splitting rows [start, end].
    *
    * Assumes rows are already sorted by continuous_y within this range.
-   * Group 0 gets the first half, group 1 gets the second half.
+   * Group 0 gets the first half, group 1 gets the second half; halves are
+   * by weight when rows carry bootstrap counts.
    *
    * Requires n >= 2 (caller must check).
    */
-  static GroupPartition median_split(int start, int end) {
+  static GroupPartition median_split(WeightVector const* weights, int start, int end) {
     int const n   = end - start + 1;
-    int const mid = n / 2;
+    int const mid = weights != nullptr ? weighted_mid(*weights, start, end) : n / 2;
 
     invariant(n >= 2, "median_split requires at least 2 observations");
 
@@ -126,7 +210,17 @@ namespace ppforest2::grouping {
     int const node_end   = std::max(y_part.group_end(lower), y_part.group_end(upper));
 
     // 1. Partition by cutpoint: left-bound rows first.
-    int const mid = partition_by_cutpoint(ctx.x, *ctx.y_vec, *ctx.projector, *ctx.cutpoint, node_start, node_end);
+    int const mid = partition_by_cutpoint(
+        ctx.x,
+        ctx.movable_x,
+        ctx.source_rows,
+        *ctx.y_vec,
+        ctx.weights,
+        *ctx.projector,
+        *ctx.cutpoint,
+        node_start,
+        node_end
+    );
 
     int const left_n  = mid - node_start;
     int const right_n = node_end - mid + 1;
@@ -135,37 +229,38 @@ namespace ppforest2::grouping {
     // identical partitions for both children; the tree builder's no-progress
     // guard (Tree::build_root) detects this and converts the node to a leaf.
     if (left_n == 0) {
-      sort_by_continuous_y(ctx.x, *ctx.y_vec, mid, node_end);
-      auto edge_y_part = right_n >= 2 ? median_split(mid, node_end) : GroupPartition::single_group(mid, node_end);
+      sort_by_continuous_y(ctx.movable_x, ctx.source_rows, *ctx.y_vec, ctx.weights, mid, node_end);
+      auto edge_y_part =
+          right_n >= 2 ? median_split(ctx.weights, mid, node_end) : GroupPartition::single_group(mid, node_end);
       ctx.lower_y_part.emplace(edge_y_part);
       ctx.upper_y_part.emplace(edge_y_part);
       return;
     }
 
     if (right_n == 0) {
-      sort_by_continuous_y(ctx.x, *ctx.y_vec, node_start, node_end);
-      auto edge_y_part =
-          left_n >= 2 ? median_split(node_start, node_end) : GroupPartition::single_group(node_start, node_end);
+      sort_by_continuous_y(ctx.movable_x, ctx.source_rows, *ctx.y_vec, ctx.weights, node_start, node_end);
+      auto edge_y_part = left_n >= 2 ? median_split(ctx.weights, node_start, node_end)
+                                     : GroupPartition::single_group(node_start, node_end);
       ctx.lower_y_part.emplace(edge_y_part);
       ctx.upper_y_part.emplace(edge_y_part);
       return;
     }
 
     // 2. Sort each child's range by continuous_y.
-    sort_by_continuous_y(ctx.x, *ctx.y_vec, node_start, mid - 1);
-    sort_by_continuous_y(ctx.x, *ctx.y_vec, mid, node_end);
+    sort_by_continuous_y(ctx.movable_x, ctx.source_rows, *ctx.y_vec, ctx.weights, node_start, mid - 1);
+    sort_by_continuous_y(ctx.movable_x, ctx.source_rows, *ctx.y_vec, ctx.weights, mid, node_end);
 
     // 3. Median-split each child into 2 groups (if enough observations).
     // Children with < 2 observations get a single-group partition;
     // the stop rule will turn them into leaves.
-    auto make_child_partition = [](int start, int end) -> GroupPartition {
+    auto make_child_partition = [&ctx](int start, int end) -> GroupPartition {
       int const n = end - start + 1;
 
       if (n < 2) {
         return GroupPartition::single_group(start, end);
       }
 
-      return median_split(start, end);
+      return median_split(ctx.weights, start, end);
     };
 
     ctx.lower_y_part.emplace(make_child_partition(node_start, mid - 1));
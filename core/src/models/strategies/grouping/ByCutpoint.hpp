@@ -12,8 +12,9 @@ namespace ppforest2::grouping {
    * then each child's observations are sorted by continuous_y and
    * median-split into 2 artificial groups for the next PDA projection.
    *
-   * Requires the non-const ctx.x and ctx.y_vec on NodeContext for in-place
-   * reordering of data within each node's range.
+   * Requires ctx.movable_x and ctx.y_vec on NodeContext for in-place
+   * reordering of data within each node's range. With a row map
+   * (`NodeContext::source_rows`) the map is reordered and x is only read.
    *
    * - `init()`: wraps pre-computed GroupIdVector (median-split of sorted y)
    *   into a GroupPartition (same as ByLabel).
@@ -38,10 +39,17 @@ namespace ppforest2::grouping {
      */
     stats::GroupPartition init(types::OutcomeVector const& y) const override;
 
+    /**
+     * @brief Weighted median split: the first group holds the rows that
+     * make up the lower half of the total weight, so a row drawn several
+     * times counts as often as it was drawn.
+     */
+    stats::GroupPartition init(types::OutcomeVector const& y, types::WeightVector const& weights) const override;
+
     /**
      * @brief Split observations by cutpoint and re-cluster each child.
      *
-     * Requires the non-const ctx.x and ctx.y_vec on the context.
+     * Requires ctx.movable_x (or ctx.source_rows) and ctx.y_vec on the context.
      * 1. Partitions rows within the node's range by projected value vs cutpoint.
      * 2. Sorts each child's rows by continuous_y.
      * 3. Median-splits each child into 2 groups.
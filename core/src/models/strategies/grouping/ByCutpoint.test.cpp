@@ -1,5 +1,6 @@
 #include "models/strategies/grouping/ByCutpoint.hpp"
 #include "models/strategies/NodeContext.hpp"
+#include "utils/Macros.hpp"
 
 #include <gtest/gtest.h>
 
@@ -78,3 +79,17 @@ TEST(GroupPartition, SingleGroupFactory) {
   EXPECT_EQ(gp.group_end(0), 8);
   EXPECT_EQ(gp.group_size(0), 4);
 }
+
+TEST(ByCutpoint, WeightedInitSplitsByWeight) {
+  OutcomeVector const y = VEC(Outcome, 1, 2, 3, 4, 5);
+  ByCutpoint strategy;
+
+  // Unit weights give the unweighted median split.
+  GroupPartition const unit = strategy.init(y, WeightVector::Ones(5));
+  EXPECT_EQ(strategy.init(y).group_size(0), unit.group_size(0));
+
+  // Draws {1, 1, 1, 1, 2, 3, 4, 5}: the lower half is the first row alone.
+  GroupPartition const gp = strategy.init(y, VEC(int, 4, 1, 1, 1, 1));
+  EXPECT_EQ(gp.group_size(0), 1);
+  EXPECT_EQ(gp.group_size(1), 4);
+}
@@ -24,8 +24,11 @@ namespace ppforest2::grouping {
 
   std::pair<GroupPartition, GroupPartition>
   ByLabel::compute(GroupPartition const& y_part, GroupId lower, GroupId upper) const {
-    auto lower_y_part = y_part.subset(y_part.subgroups.at(lower));
-    auto upper_y_part = y_part.subset(y_part.subgroups.at(upper));
+    auto const lower_groups = y_part.subgroups.at(lower);
+    auto const upper_groups = y_part.subgroups.at(upper);
+
+    auto lower_y_part = y_part.subset(GroupPartition::GroupSet(lower_groups.begin(), lower_groups.end()));
+    auto upper_y_part = y_part.subset(GroupPartition::GroupSet(upper_groups.begin(), upper_groups.end()));
 
     return {std::move(lower_y_part), std::move(upper_y_part)};
   }
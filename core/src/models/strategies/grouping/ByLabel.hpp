@@ -38,6 +38,9 @@ namespace ppforest2::grouping {
      */
     void split(NodeContext& ctx, types::GroupId lower, types::GroupId upper, stats::RNG& rng) const override;
 
+    /** @brief Children are subsets of the node's label blocks; rows never move. */
+    bool keeps_blocks() const override { return true; }
+
     /**
      * @brief Direct computation: partition from group partition and lower/upper labels.
      *
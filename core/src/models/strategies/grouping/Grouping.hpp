@@ -37,6 +37,16 @@ namespace ppforest2::grouping {
      */
     virtual stats::GroupPartition init(types::OutcomeVector const& y) const = 0;
 
+    /**
+     * @brief Create the initial GroupPartition from bootstrap-weighted rows.
+     *
+     * Row `i` stands for `weights(i)` copies of itself. Strategies whose
+     * partition depends only on the labels ignore the weights.
+     */
+    virtual stats::GroupPartition init(types::OutcomeVector const& y, types::WeightVector const& /*weights*/) const {
+      return init(y);
+    }
+
     /** @brief Convenience overload for callers with a `GroupIdVector`. */
     stats::GroupPartition init(types::GroupIdVector const& y) const {
       return init(types::OutcomeVector(y.cast<types::Outcome>()));
@@ -45,6 +55,15 @@ namespace ppforest2::grouping {
     /** @brief Split observations into two child partitions; writes ctx.lower_y_part / upper_y_part. */
     virtual void split(NodeContext& ctx, types::GroupId lower, types::GroupId upper, stats::RNG& rng) const = 0;
 
+    /**
+     * @brief Whether every node's partition is made of the root's row blocks.
+     *
+     * True when `split()` never moves rows and children only subset or
+     * merge the root's groups, so per-block statistics computed once per
+     * tree stay valid at every node (see `stats::ScatterCache`).
+     */
+    virtual bool keeps_blocks() const { return false; }
+
     /** @brief Callable shorthand for split(). Skips if `ctx.aborted` is set. */
     void operator()(NodeContext& ctx, types::GroupId lower, types::GroupId upper, stats::RNG& rng) const;
   };
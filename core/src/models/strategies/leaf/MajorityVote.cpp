@@ -18,7 +18,7 @@ namespace ppforest2::leaf {
     int majority_size = 0;
 
     for (auto const& g : ctx.y.groups) {
-      int const sz = ctx.y.group_size(g);
+      int const sz = ctx.weights != nullptr ? ctx.y.group_weight(g, *ctx.weights) : ctx.y.group_size(g);
 
       if (sz > majority_size) {
         majority_size = sz;
@@ -115,3 +115,21 @@ TEST(MajorityVoteLeaf, DisplayName) {
   MajorityVote const mv;
   EXPECT_EQ(mv.display_name(), "Majority vote");
 }
+
+TEST(MajorityVoteLeaf, WeightedVoteCountsDraws) {
+  FeatureMatrix x       = MAT(Feature, rows(5), 1, 2, 3, 4, 5, 6, 7, 8, 9, 10);
+  GroupIdVector const y = VEC(GroupId, 0, 0, 0, 1, 1);
+  GroupPartition const gp(y);
+  OutcomeVector ov     = y.cast<Outcome>();
+  WeightVector weights = VEC(int, 1, 1, 1, 2, 2);
+  RNG rng(0);
+
+  NodeContext ctx(x, gp, ov, 0);
+  ctx.weights = &weights;
+
+  MajorityVote const mv;
+  auto leaf = mv.create_leaf(ctx, rng);
+
+  // Three distinct rows of group 0, but four draws of group 1.
+  EXPECT_EQ(leaf->response(), 1);
+}
@@ -27,6 +27,11 @@ namespace ppforest2::leaf {
 
     invariant(y.size() > 0, "MeanResponse: empty node (no observations in any group)");
 
+    if (ctx.weights != nullptr) {
+      Eigen::VectorXd const w = ctx.y.data(*ctx.weights).template cast<double>();
+      return TreeLeaf::make(static_cast<Feature>(y.dot(w) / w.sum()));
+    }
+
     return TreeLeaf::make(static_cast<Feature>(y.mean()));
   }
 
@@ -98,3 +98,21 @@ TEST(MeanResponseLeaf, MeanOfSubset) {
   // Only group 0 observations (indices 0,1) → mean of 10.0 and 20.0 = 15.0
   EXPECT_FLOAT_EQ(static_cast<float>(leaf->response()), 15.0f);
 }
+
+TEST(MeanResponseLeaf, WeightedMeanCountsDuplicates) {
+  FeatureMatrix x       = MAT(Feature, rows(3), 1, 2, 3, 4, 5, 6);
+  GroupIdVector const y = VEC(GroupId, 0, 0, 0);
+  GroupPartition const gp(y);
+  OutcomeVector ov     = VEC(Feature, 2.0, 4.0, 6.0);
+  WeightVector weights = VEC(int, 3, 1, 0);
+  RNG rng(0);
+
+  NodeContext ctx(x, gp, ov, 0);
+  ctx.weights = &weights;
+
+  MeanResponse const mr;
+  auto leaf = mr.create_leaf(ctx, rng);
+
+  // (3 * 2 + 4) / 4
+  EXPECT_FLOAT_EQ(static_cast<float>(leaf->response()), 2.5f);
+}
@@ -3,9 +3,11 @@
 #include "models/strategies/NodeContext.hpp"
 #include "utils/Invariant.hpp"
 #include "utils/JsonReader.hpp"
+#include "utils/Scratch.hpp"
 
 #include <cmath>
 #include <limits>
+#include <optional>
 #include <Eigen/Dense>
 #include <nlohmann/json.hpp>
 
@@ -14,8 +16,8 @@ using namespace ppforest2::stats;
 
 namespace ppforest2::pp {
   namespace {
-    ProjectionPursuit::Result nan_result(FeatureMatrix const& x) {
-      auto const projector   = FeatureVector::Constant(x.cols(), std::numeric_limits<Feature>::quiet_NaN());
+    ProjectionPursuit::Result nan_result(Eigen::Index cols) {
+      auto const projector   = FeatureVector::Constant(cols, std::numeric_limits<Feature>::quiet_NaN());
       auto const index_value = std::numeric_limits<Feature>::quiet_NaN();
       return ProjectionPursuit::Result{projector, index_value};
     }
@@ -31,26 +33,83 @@ namespace ppforest2::pp {
   void PDA::optimize(NodeContext& ctx, stats::RNG& /*rng*/) const {
     invariant(ctx.var_selection.has_value(), "PDA requires var_selection on NodeContext");
     auto const& partition = ctx.active_partition();
-    auto reduced_x        = ctx.x(Eigen::all, ctx.var_selection->selected_cols);
-    auto result           = compute(reduced_x, partition);
-    ctx.projector         = ctx.var_selection->expand(result.projector);
-    ctx.pp_index_value    = result.index_value;
+    auto const& cols      = ctx.var_selection->selected_cols;
+
+    ProjectionPursuit::Result result;
+
+    if (reads_scatter_cache(ctx)) {
+      // Block moments reused across the tree; only new column pairs touch rows.
+      result = compute(partition.scatter(*ctx.scatter_cache, cols), partition.groups.size());
+    } else if (ctx.weights != nullptr) {
+      // Counted rows: the dual's row basis assumes every row counts once,
+      // so weighted nodes always take the primal path.
+      GroupPartition::Rows const rows = partition.row_indices();
+      utils::ScratchMatrix<Feature> const reduced_x(ctx.x(ctx.x_rows(rows), cols));
+      WeightVector const reduced_w = (*ctx.weights)(rows);
+      auto const scatter           = partition.compact().scatter(reduced_x.matrix(), reduced_w);
+      result                       = compute(scatter, partition.groups.size());
+    } else {
+      // Node-local working set: only the rows this node owns and the
+      // selected columns, addressed by the compacted partition.
+      utils::ScratchMatrix<Feature> const reduced_x(ctx.x(ctx.x_rows(partition.row_indices()), cols));
+      result = compute(reduced_x.matrix(), partition.compact());
+    }
+
+    ctx.projector      = ctx.var_selection->expand(result.projector);
+    ctx.pp_index_value = result.index_value;
+  }
+
+  bool PDA::reads_scatter_cache(NodeContext const& ctx) const {
+    auto const cols = static_cast<Eigen::Index>(ctx.var_selection->selected_cols.size());
+
+    // Nodes solved in the dual need their rows, not the cached moments;
+    // weighted nodes are never solved in the dual.
+    return ctx.scatter_cache != nullptr
+        && (ctx.weights != nullptr || !use_dual(ctx.active_partition().total_size(), cols));
+  }
+
+  ProjectionPursuit::Result PDA::compute(Eigen::Ref<FeatureMatrix const> const& x, GroupPartition const& y_part) const {
+    if (use_dual(x.rows(), x.cols())) {
+      if (auto result = solve_dual(x, y_part)) {
+        return *result;
+      }
+    }
+
+    return compute(y_part.scatter(x), y_part.groups.size());
+  }
+
+  bool PDA::use_dual(Eigen::Index rows, Eigen::Index cols) const {
+    return lambda > 0 && rows * dual_ratio <= cols;
+  }
+
+  ProjectionPursuit::Result PDA::compute(GroupPartition::Scatter const& scatter, std::size_t groups) const {
+    if (groups == 2) {
+      if (auto result = solve_two_group(scatter)) {
+        return *result;
+      }
+    }
+
+    return solve_eigen(scatter);
   }
 
-  ProjectionPursuit::Result PDA::compute(FeatureMatrix const& x, GroupPartition const& y_part) const {
-    FeatureMatrix const B = y_part.bgss(x);
-    FeatureMatrix const W = y_part.wgss(x);
+  FeatureMatrix PDA::penalized_total(GroupPartition::Scatter const& scatter) const {
+    auto const& [B, W] = scatter;
 
     FeatureMatrix W_pda = (Feature(1) - Feature(lambda)) * W;
     W_pda.diagonal()    = W.diagonal();
 
-    FeatureMatrix const WpB = W_pda + B; // symmetric
+    return W_pda + B; // symmetric
+  }
+
+  ProjectionPursuit::Result PDA::solve_eigen(GroupPartition::Scatter const& scatter) const {
+    FeatureMatrix const& B  = scatter.bgss;
+    FeatureMatrix const WpB = penalized_total(scatter);
 
     Eigen::GeneralizedSelfAdjointEigenSolver<FeatureMatrix> ges;
     ges.compute(B, WpB);
 
     if (ges.info() != Eigen::Success) {
-      return nan_result(x);
+      return nan_result(B.cols());
     }
 
     // largest eigenvalue → best 1D projection
@@ -60,12 +119,122 @@ namespace ppforest2::pp {
     // Solver may report Success but produce NaN eigenvectors when B is
     // positive-semidefinite (singular covariance from small bootstrap samples).
     if (max_eigen_vec.hasNaN() || std::isnan(max_eigen_val)) {
-      return nan_result(x);
+      return nan_result(B.cols());
     }
 
     return ProjectionPursuit::Result{ppforest2::pp::normalize(max_eigen_vec), max_eigen_val};
   }
 
+  std::optional<ProjectionPursuit::Result> PDA::solve_two_group(GroupPartition::Scatter const& scatter) const {
+    // With two groups B = u uᵀ for some u ∝ m₁ − m₂, so the generalized
+    // problem B v = λ (W_pda + B) v has a single nonzero eigenvalue
+    //   λ = uᵀ (W_pda + B)⁻¹ u,   v ∝ (W_pda + B)⁻¹ u ∝ W_pda⁻¹ u.
+    // u is read off B's largest diagonal entry.
+    FeatureMatrix const& B = scatter.bgss;
+
+    Eigen::Index k     = 0;
+    Feature const b_kk = B.diagonal().maxCoeff(&k);
+
+    if (!(b_kk > 0)) {
+      return std::nullopt;
+    }
+
+    FeatureVector const u = B.col(k) / std::sqrt(b_kk);
+
+    // A failed factorization (W_pda + B singular in float, typical of
+    // tiny bootstrap nodes with duplicated rows) is left to the
+    // eigensolver, which decides on its own whether the node is degenerate.
+    Eigen::LLT<FeatureMatrix> const llt(penalized_total(scatter));
+
+    if (llt.info() != Eigen::Success) {
+      return std::nullopt;
+    }
+
+    FeatureVector const w = llt.solve(u);
+    Feature const index   = u.dot(w);
+
+    if (w.hasNaN() || !(index > 0) || std::isinf(index)) {
+      return std::nullopt;
+    }
+
+    // Scale as the eigensolver does (vᵀ (W_pda + B) v = 1); wᵀ (W_pda + B) w = index.
+    return ProjectionPursuit::Result{ppforest2::pp::normalize(w / std::sqrt(index)), index};
+  }
+
+  std::optional<ProjectionPursuit::Result>
+  PDA::solve_dual(Eigen::Ref<FeatureMatrix const> const& x, GroupPartition const& y_part) const {
+    // B = Zᵦᵀ Zᵦ and W = Zᵥᵀ Zᵥ, with Zᵥ the within-centered rows and Zᵦ
+    // the rows √n_g (m_g − m). Scaling columns by D = diag(W) turns the
+    // PDA penalty into a ridge,
+    //   W_pda = D^½ ((1 − λ) Ŵ + λ I) D^½,   Ŵ = D^-½ W D^-½,
+    // and a ridge leaves the row span of Ẑ = [Zᵥ; Zᵦ] D^-½ invariant.
+    // Every eigenvector with a nonzero eigenvalue lies in that span, so
+    // the problem is solved exactly in an orthonormal basis Q of it.
+    Eigen::Index const q        = x.cols();
+    Eigen::Index const n        = y_part.total_size();
+    auto const n_groups         = static_cast<Eigen::Index>(y_part.groups.size());
+    Eigen::Index const n_factor = n + n_groups;
+
+    if (n_factor > q) {
+      return std::nullopt;
+    }
+
+    Eigen::MatrixXd Z(n_factor, q);
+    Eigen::MatrixXd group_means(n_groups, q);
+    Eigen::VectorXd group_sizes(n_groups);
+    Eigen::Index row = 0;
+    Eigen::Index g   = 0;
+
+    for (GroupId const group : y_part.groups) {
+      Eigen::MatrixXd const rows = y_part.group(x, group).cast<double>();
+
+      group_means.row(g)             = rows.colwise().mean();
+      group_sizes(g)                 = static_cast<double>(rows.rows());
+      Z.middleRows(row, rows.rows()) = rows.rowwise() - group_means.row(g);
+      row += rows.rows();
+      ++g;
+    }
+
+    Eigen::RowVectorXd const global_mean = (group_sizes.transpose() * group_means) / static_cast<double>(n);
+    Z.bottomRows(n_groups) = group_sizes.cwiseSqrt().asDiagonal() * (group_means.rowwise() - global_mean);
+
+    Eigen::RowVectorXd const d = Z.topRows(n).colwise().squaredNorm();
+
+    // A constant column leaves D singular; the primal path handles it.
+    if (!(d.array() > 0).all()) {
+      return std::nullopt;
+    }
+
+    Eigen::RowVectorXd const d_inv_sqrt = d.cwiseSqrt().cwiseInverse();
+    Z                                   = Z * d_inv_sqrt.asDiagonal();
+
+    Eigen::HouseholderQR<Eigen::MatrixXd> const qr(Z.transpose());
+    Eigen::MatrixXd const Q = qr.householderQ() * Eigen::MatrixXd::Identity(q, n_factor);
+    Eigen::MatrixXd const P = Z * Q;
+
+    Eigen::MatrixXd const B_dual = P.bottomRows(n_groups).transpose() * P.bottomRows(n_groups);
+    Eigen::MatrixXd const W_dual = P.topRows(n).transpose() * P.topRows(n);
+    Eigen::MatrixXd const A_dual = B_dual + (1.0 - lambda) * W_dual
+                                 + static_cast<double>(lambda) * Eigen::MatrixXd::Identity(n_factor, n_factor);
+
+    Eigen::GeneralizedSelfAdjointEigenSolver<Eigen::MatrixXd> ges(B_dual, A_dual);
+
+    if (ges.info() != Eigen::Success) {
+      return std::nullopt;
+    }
+
+    Eigen::VectorXd const c = ges.eigenvectors().col(n_factor - 1);
+    double const index      = ges.eigenvalues()(n_factor - 1);
+
+    if (c.hasNaN() || std::isnan(index)) {
+      return std::nullopt;
+    }
+
+    // v = D^-½ Q c; cᵀ A_dual c = 1 is vᵀ (W_pda + B) v = 1, as in `solve_eigen`.
+    FeatureVector const projector = (d_inv_sqrt.transpose().asDiagonal() * (Q * c)).cast<Feature>();
+    return ProjectionPursuit::Result{ppforest2::pp::normalize(projector), static_cast<Feature>(index)};
+  }
+
   ProjectionPursuit::Ptr pda(float lambda) {
     return std::make_shared<PDA>(lambda);
   }
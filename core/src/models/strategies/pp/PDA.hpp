@@ -5,6 +5,9 @@
 #include "stats/GroupPartition.hpp"
 #include "utils/Types.hpp"
 
+#include <cstddef>
+#include <optional>
+
 namespace ppforest2::pp {
   /**
    * @brief Penalized Discriminant Analysis projection pursuit strategy.
@@ -29,19 +32,74 @@ namespace ppforest2::pp {
      */
     void optimize(NodeContext& ctx, stats::RNG& rng) const override;
 
+    /** @brief True when a cache is set and the node is not solved in the dual (weighted nodes never are). */
+    bool reads_scatter_cache(NodeContext const& ctx) const;
+
     /**
      * @brief Direct computation: find optimal projection for given data and partition.
      *
      * This is the core PDA/LDA optimization logic, usable independently of NodeContext.
+     * Nodes with far fewer rows than columns are solved in the dual (`use_dual`).
+     */
+    ProjectionPursuit::Result
+    compute(Eigen::Ref<types::FeatureMatrix const> const& x, stats::GroupPartition const& y_part) const;
+
+    /**
+     * @brief Same as `compute(x, y_part)`, from scatter matrices already computed.
+     *
+     * Two-group partitions take the closed form (`solve_two_group`);
+     * anything else, or a two-group node where the closed form does not
+     * apply, goes through the generalized eigensolver (`solve_eigen`).
+     */
+    ProjectionPursuit::Result compute(stats::GroupPartition::Scatter const& scatter, std::size_t groups) const;
+
+    /** @brief Largest generalized eigenpair of (B, W_pda + B). Valid for any number of groups. */
+    ProjectionPursuit::Result solve_eigen(stats::GroupPartition::Scatter const& scatter) const;
+
+    /**
+     * @brief Closed-form solution for a two-group partition.
+     *
+     * B has rank one, so the best direction is (W_pda + B)⁻¹ u with
+     * B = u uᵀ, found with one Cholesky solve instead of an
+     * eigendecomposition. Scaled and signed like `solve_eigen`. Returns
+     * `std::nullopt` when B is zero or W_pda + B does not factor, leaving
+     * the node (and whether it is degenerate) to the eigensolver.
      */
-    ProjectionPursuit::Result compute(types::FeatureMatrix const& x, stats::GroupPartition const& y_part) const;
+    std::optional<ProjectionPursuit::Result> solve_two_group(stats::GroupPartition::Scatter const& scatter) const;
 
     static ProjectionPursuit::Ptr from_json(nlohmann::json const& j);
 
     PPFOREST2_REGISTER_STRATEGY(ProjectionPursuit, "pda")
     PPFOREST2_REGISTER_PRIMARY_PARAM("pda", "lambda")
 
+    /**
+     * @brief Whether a node of @p rows rows over @p cols selected columns is solved in the dual.
+     *
+     * Used when the node holds at most `cols / dual_ratio` rows and
+     * λ > 0; with λ = 0 the primal problem is singular on such nodes and
+     * the dual would not be equivalent to it.
+     */
+    bool use_dual(Eigen::Index rows, Eigen::Index cols) const;
+
+    /**
+     * @brief Same optimum as `solve_eigen(y_part.scatter(x))`, found in the span of the node's rows.
+     *
+     * Solves an (n + G) × (n + G) problem instead of a q × q one, where
+     * n is the number of rows of @p x and G the number of groups, and
+     * maps the direction back to q dimensions. Returns `std::nullopt`
+     * when n + G exceeds q, a column has no within-group variance, or
+     * the reduced problem fails.
+     */
+    std::optional<ProjectionPursuit::Result>
+    solve_dual(Eigen::Ref<types::FeatureMatrix const> const& x, stats::GroupPartition const& y_part) const;
+
+    /** @brief Minimum ratio of selected columns to node rows for `use_dual`. */
+    static constexpr Eigen::Index dual_ratio = 2;
+
   private:
+    /** @brief W_pda + B, with W_pda = (1 − λ) W off the diagonal and W on it. */
+    types::FeatureMatrix penalized_total(stats::GroupPartition::Scatter const& scatter) const;
+
     /** @brief Penalty parameter for the LDA index (0 = standard LDA). */
     float const lambda;
   };
@@ -3,6 +3,9 @@
 
 #include "models/strategies/pp/ProjectionPursuit.hpp"
 #include "models/strategies/pp/PDA.hpp"
+#include "models/strategies/NodeContext.hpp"
+#include "models/strategies/vars/All.hpp"
+#include "stats/Simulation.hpp"
 #include "utils/Types.hpp"
 #include "utils/Macros.hpp"
 
@@ -539,3 +542,120 @@ TEST(Projector, PDALambdaOneBoundary) {
   ASSERT_COLLINEAR(expected, actual);
   ASSERT_GT(index, 0.0F) << "PDA lambda=1 should still find a valid projector";
 }
+
+TEST(Projector, PDAOptimizeUsesOnlyNodeRows) {
+  // Rows 0-1 (group 0) are outside the node and hold values that would
+  // dominate the scatter matrices if they were read.
+  FeatureMatrix x = MAT(Feature, rows(6), 900, -900, 800, 700, 1, 0, 2, 1, 0, 4, 1, 5);
+
+  GroupIdVector const y     = VEC(GroupId, 0, 0, 1, 1, 2, 2);
+  GroupPartition const node = GroupPartition(y).subset({1, 2});
+  RNG rng(0);
+
+  OutcomeVector ov = y.cast<Outcome>();
+  NodeContext ctx(x, node, ov, 0);
+  ctx.var_selection = vars::All().compute(x);
+
+  PDA const pda(0.5);
+  pda.optimize(ctx, rng);
+
+  FeatureMatrix const local = x.bottomRows(4);
+  auto const expected       = pda.compute(local, GroupPartition(VEC(GroupId, 1, 1, 2, 2)));
+
+  ASSERT_TRUE(ctx.projector.has_value());
+  ASSERT_EQ(expected.projector, *ctx.projector); // NOLINT(bugprone-unchecked-optional-access)
+  ASSERT_EQ(expected.index_value, *ctx.pp_index_value); // NOLINT(bugprone-unchecked-optional-access)
+}
+
+TEST(Projector, PDATwoGroupClosedFormMatchesEigen) {
+  RNG rng(0);
+  auto const data = simulate(60, 6, 2, rng);
+
+  GroupPartition const y(data.y);
+  auto const scatter = y.scatter(data.x);
+
+  for (float const lambda : {0.0F, 0.1F, 0.5F, 1.0F}) {
+    PDA const pda(lambda);
+
+    auto const closed = pda.solve_two_group(scatter);
+    auto const eigen  = pda.solve_eigen(scatter);
+
+    ASSERT_TRUE(closed.has_value()) << "lambda " << lambda;
+    EXPECT_TRUE(closed->projector.isApprox(eigen.projector, 1e-3F)) // NOLINT(bugprone-unchecked-optional-access)
+        << "lambda " << lambda << "\n"
+        << closed->projector.transpose() << "\n" // NOLINT(bugprone-unchecked-optional-access)
+        << eigen.projector.transpose();
+    EXPECT_NEAR(eigen.index_value, closed->index_value, 1e-4F) // NOLINT(bugprone-unchecked-optional-access)
+        << "lambda " << lambda;
+  }
+}
+
+TEST(Projector, PDATwoGroupFallsBackWithoutSeparation) {
+  // Identical group means: B = 0, no closed form.
+  FeatureMatrix const x = MAT(Feature, rows(4), 1, 2, 3, 4, 3, 4, 1, 2);
+  GroupPartition const y(VEC(GroupId, 0, 0, 1, 1));
+
+  PDA const pda(0.0);
+  ASSERT_FALSE(pda.solve_two_group(y.scatter(x)).has_value());
+}
+
+TEST(Projector, PDAMulticlassUsesEigen) {
+  RNG rng(1);
+  auto const data = simulate(90, 4, 3, rng);
+
+  GroupPartition const y(data.y);
+  PDA const pda(0.2F);
+
+  auto const result = pda.compute(data.x, y);
+  auto const eigen  = pda.solve_eigen(y.scatter(data.x));
+
+  ASSERT_EQ(eigen.projector, result.projector);
+  ASSERT_EQ(eigen.index_value, result.index_value);
+}
+
+TEST(Projector, PDADualMatchesPrimalOnWideNodes) {
+  RNG rng(2);
+
+  for (int const groups : {2, 3}) {
+    auto const data = simulate(12, 40, groups, rng);
+    GroupPartition const y(data.y);
+
+    for (float const lambda : {0.1F, 0.5F, 1.0F}) {
+      PDA const pda(lambda);
+      ASSERT_TRUE(pda.use_dual(data.x.rows(), data.x.cols()));
+
+      auto const dual   = pda.solve_dual(data.x, y);
+      auto const primal = pda.solve_eigen(y.scatter(data.x));
+
+      ASSERT_TRUE(dual.has_value()) << groups << " groups, lambda " << lambda;
+
+      // Coefficients this small fall under `normalize`'s sign threshold, so
+      // the two solvers may return opposite signs.
+      FeatureVector const& projector = dual->projector; // NOLINT(bugprone-unchecked-optional-access)
+      EXPECT_TRUE(projector.isApprox(primal.projector, 1e-3F) || projector.isApprox(-primal.projector, 1e-3F))
+          << groups << " groups, lambda " << lambda;
+      EXPECT_NEAR(primal.index_value, dual->index_value, 1e-4F) // NOLINT(bugprone-unchecked-optional-access)
+          << groups << " groups, lambda " << lambda;
+    }
+  }
+}
+
+TEST(Projector, PDADualOnlyWithPenaltyAndWideNodes) {
+  ASSERT_FALSE(PDA(0).use_dual(10, 100));
+  ASSERT_FALSE(PDA(0.5).use_dual(60, 100));
+  ASSERT_TRUE(PDA(0.5).use_dual(50, 100));
+}
+
+TEST(Projector, PDADualFallsBackOnConstantColumn) {
+  RNG rng(3);
+  auto data = simulate(10, 30, 2, rng);
+  data.x.col(4).setConstant(1);
+
+  GroupPartition const y(data.y);
+  PDA const pda(0.5);
+
+  ASSERT_FALSE(pda.solve_dual(data.x, y).has_value());
+  // Same (degenerate) answer as the primal path.
+  ASSERT_TRUE(pda.solve_eigen(y.scatter(data.x)).projector.hasNaN());
+  ASSERT_TRUE(pda.compute(data.x, y).projector.hasNaN());
+}
@@ -30,6 +30,10 @@ namespace ppforest2::stop {
   }
 
   bool MinSize::should_stop(NodeContext const& ctx, stats::RNG& /*rng*/) const {
+    if (ctx.weights != nullptr) {
+      return ctx.y.total_weight(*ctx.weights) < min_size;
+    }
+
     int total = 0;
 
     for (auto const& g : ctx.y.groups) {
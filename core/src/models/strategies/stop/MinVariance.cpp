@@ -40,13 +40,18 @@ namespace ppforest2::stop {
     // cross-platform reproducible.
     Eigen::VectorXd const y = ctx.y.data(*ctx.y_vec).template cast<double>();
 
-    int const count = static_cast<int>(y.size());
+    // Unit weights unless rows carry bootstrap counts; `count` is then the
+    // node's size with duplicates, as if they had been materialized.
+    Eigen::VectorXd const w = ctx.weights != nullptr ? Eigen::VectorXd(ctx.y.data(*ctx.weights).template cast<double>())
+                                                     : Eigen::VectorXd::Ones(y.size());
+
+    auto const count = static_cast<int>(w.sum());
     if (count <= 1) {
       return true;
     }
 
-    double const mean     = y.mean();
-    double const variance = (y.array() - mean).square().sum() / static_cast<double>(count - 1);
+    double const mean     = y.dot(w) / static_cast<double>(count);
+    double const variance = (y.array() - mean).square().matrix().dot(w) / static_cast<double>(count - 1);
 
     return variance < static_cast<double>(threshold);
   }
@@ -89,3 +89,29 @@ TEST(MinVarianceStop, StopsWithSingleObservation) {
   // Single observation → variance undefined → should stop
   EXPECT_TRUE(rule.should_stop(ctx, rng));
 }
+
+TEST(MinVarianceStop, WeightedRowCountsAsItsDraws) {
+  FeatureMatrix x       = MAT(Feature, rows(2), 1, 2);
+  GroupIdVector const y = VEC(GroupId, 0, 0);
+  GroupPartition const gp(y);
+  OutcomeVector ov = VEC(Feature, 5.0, 9.0);
+  RNG rng(0);
+
+  NodeContext ctx(x, gp, ov, 0);
+
+  // A single draw: count 1, too few observations to split.
+  WeightVector single = VEC(int, 1, 0);
+  ctx.weights         = &single;
+  EXPECT_TRUE(MinVariance(0.01f).should_stop(ctx, rng));
+
+  // One row drawn three times: count 3, but the values {5, 5, 5} have variance 0.
+  WeightVector repeated = VEC(int, 3, 0);
+  ctx.weights           = &repeated;
+  EXPECT_TRUE(MinVariance(0.01f).should_stop(ctx, rng));
+
+  // Values {5, 5, 5, 9}: variance 4, where the distinct rows alone give 8.
+  WeightVector weights = VEC(int, 3, 1);
+  ctx.weights          = &weights;
+  EXPECT_FALSE(MinVariance(3.9f).should_stop(ctx, rng));
+  EXPECT_TRUE(MinVariance(4.1f).should_stop(ctx, rng));
+}
@@ -0,0 +1,319 @@
+#include "serialization/Binary.hpp"
+
+#include "models/Forest.hpp"
+#include "models/Tree.hpp"
+#include "utils/Invariant.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+using namespace ppforest2::types;
+
+namespace ppforest2::serialization::binary {
+  namespace {
+    constexpr char magic[8] = {'P', 'P', 'F', '2', 'B', 'I', 'N', '\0'};
+
+    constexpr std::uint32_t kind_tree   = 0;
+    constexpr std::uint32_t kind_forest = 1;
+
+    static_assert(sizeof(Feature) == 4 && sizeof(Outcome) == 4, "binary format stores 32-bit floats");
+    static_assert(sizeof(GroupId) == 4 && sizeof(int) == 4, "binary format stores 32-bit integers");
+
+    // Arrays are written and read with memcpy, so the file is only
+    // little-endian if the host is.
+    bool little_endian() {
+      std::uint16_t const probe = 1;
+      unsigned char first       = 0;
+      std::memcpy(&first, &probe, 1);
+      return first == 1;
+    }
+
+    class Writer {
+    public:
+      explicit Writer(std::ostream& out)
+          : out(out) {}
+
+      template<typename T> void put(T value) { put_array(&value, 1); }
+
+      template<typename T> void put_array(T const* values, std::size_t n) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        out.write(reinterpret_cast<char const*>(values), static_cast<std::streamsize>(n * sizeof(T)));
+        offset += n * sizeof(T);
+      }
+
+      /** @brief Zero-pad to the next 8-byte boundary. */
+      void align() {
+        static constexpr char zeros[8] = {};
+        std::size_t const pad          = (8 - offset % 8) % 8;
+        out.write(zeros, static_cast<std::streamsize>(pad));
+        offset += pad;
+      }
+
+    private:
+      std::ostream& out;
+      std::size_t offset = 0;
+    };
+
+    class Reader {
+    public:
+      Reader(std::byte const* data, std::size_t size)
+          : data(data)
+          , size(size) {}
+
+      template<typename T> T get() {
+        T value;
+        get_array(&value, 1);
+        return value;
+      }
+
+      /** @brief Throw unless @p n values of type `T` remain. Checked before any allocation. */
+      template<typename T> void require(std::size_t n) const {
+        if (offset > size || n > (size - offset) / sizeof(T)) {
+          throw std::runtime_error("binary model: truncated data");
+        }
+      }
+
+      template<typename T> void get_array(T* values, std::size_t n) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        require<T>(n);
+        std::memcpy(values, data + offset, n * sizeof(T));
+        offset += n * sizeof(T);
+      }
+
+      template<typename T> void get_vector(std::vector<T>& values, std::size_t n) {
+        require<T>(n);
+        values.resize(n);
+        get_array(values.data(), n);
+      }
+
+      /** @brief View the next @p n values in place; the buffer must outlive the result. */
+      template<typename T> utils::ConstArray<T> borrow_array(std::size_t n) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        require<T>(n);
+
+        // Sections start on 8-byte boundaries and every element is 4 bytes,
+        // so this only fails for a buffer that is itself misaligned.
+        if (reinterpret_cast<std::uintptr_t>(data + offset) % alignof(T) != 0) {
+          throw std::runtime_error("binary model: misaligned array");
+        }
+
+        auto const* values = reinterpret_cast<T const*>(data + offset);
+        offset += n * sizeof(T);
+        return utils::ConstArray<T>::borrow(values, n);
+      }
+
+      void align() { offset += (8 - offset % 8) % 8; }
+
+    private:
+      std::byte const* data;
+      std::size_t size;
+      std::size_t offset = 0;
+    };
+
+    /** @brief Record which model kind was written; the trees go through `CompiledForest::compile`. */
+    struct KindVisitor : public Model::Visitor {
+      std::uint32_t kind = kind_tree;
+
+      void visit(Tree const&) override { kind = kind_tree; }
+      void visit(Forest const&) override { kind = kind_forest; }
+    };
+
+    /** @brief Child references must point forward (pre-order) and stay in range. */
+    void validate(CompiledTree const& tree, CompiledForest const& forest) {
+      int const n_branches = tree.branch_count();
+      int const n_leaves   = static_cast<int>(tree.leaves.size());
+
+      auto const valid_ref = [&](int ref, int parent) {
+        // `ref >= -n_leaves` is `leaf_index(ref) < n_leaves` without negating INT_MIN.
+        return ref >= 0 ? ref > parent && ref < n_branches : ref >= -n_leaves;
+      };
+
+      if (!valid_ref(tree.root, -1) || n_leaves == 0) {
+        throw std::runtime_error("binary model: invalid tree root");
+      }
+
+      for (int b = 0; b < n_branches; ++b) {
+        auto const i = static_cast<std::size_t>(b);
+
+        if (!valid_ref(tree.lower[i], b) || !valid_ref(tree.upper[i], b)) {
+          throw std::runtime_error("binary model: invalid child reference");
+        }
+      }
+
+      if (forest.mode == Mode::Classification) {
+        for (Outcome const leaf : tree.leaves) {
+          if (forest.group_column(static_cast<GroupId>(leaf)) < 0) {
+            throw std::runtime_error("binary model: leaf label has no group column");
+          }
+        }
+      }
+    }
+  }
+
+  bool has_extension(std::string const& path) {
+    std::string const ext = extension;
+    return path.size() >= ext.size() && path.compare(path.size() - ext.size(), ext.size(), ext) == 0;
+  }
+
+  void write(std::ostream& out, Model const& model, nlohmann::json const& export_json) {
+    invariant(little_endian(), "binary model format requires a little-endian host");
+
+    KindVisitor kind;
+    model.accept(kind);
+    CompiledForest const forest = CompiledForest::compile(model);
+
+    // The node graph is what the flat arrays replace; keep only the
+    // model block's scalar fields (e.g. `degenerate`).
+    nlohmann::json meta = export_json;
+
+    if (meta.contains("model")) {
+      nlohmann::json scalars = nlohmann::json::object();
+
+      for (auto const& [key, value] : meta["model"].items()) {
+        if (!value.is_structured()) {
+          scalars[key] = value;
+        }
+      }
+
+      meta["model"] = std::move(scalars);
+    }
+
+    std::string const meta_text = meta.dump();
+
+    Writer writer(out);
+    writer.put_array(magic, sizeof(magic));
+    writer.put<std::uint32_t>(version);
+    writer.put<std::uint32_t>(forest.mode == Mode::Regression ? 1 : 0);
+    writer.put<std::uint32_t>(kind.kind);
+    writer.put<std::uint32_t>(static_cast<std::uint32_t>(forest.trees.size()));
+    writer.put<std::uint32_t>(static_cast<std::uint32_t>(forest.groups.size()));
+    writer.put<std::uint32_t>(0);
+    writer.put<std::uint64_t>(meta_text.size());
+
+    writer.put_array(meta_text.data(), meta_text.size());
+    writer.align();
+
+    writer.put_array(forest.groups.data(), forest.groups.size());
+    writer.align();
+
+    for (CompiledTree const& tree : forest.trees) {
+      auto const n_branches = static_cast<std::size_t>(tree.branch_count());
+
+      writer.put<std::uint32_t>(static_cast<std::uint32_t>(n_branches));
+      writer.put<std::uint32_t>(static_cast<std::uint32_t>(tree.leaves.size()));
+      writer.put<std::int32_t>(tree.root);
+      writer.put<std::uint32_t>(static_cast<std::uint32_t>(tree.n_vars()));
+
+      writer.put_array(tree.dense_coefficients.data(), tree.dense_coefficients.size());
+      writer.put_array(tree.cutpoints.data(), n_branches);
+      writer.put_array(tree.lower.data(), n_branches);
+      writer.put_array(tree.upper.data(), n_branches);
+      writer.put_array(tree.leaves.data(), tree.leaves.size());
+      writer.align();
+    }
+
+    invariant(out.good(), "binary model: write failed");
+  }
+
+  BinaryExport decode(std::byte const* data, std::size_t size) {
+    // One copy into 8-byte aligned storage, which the trees then borrow from.
+    auto buffer = std::make_shared<std::vector<std::uint64_t>>((size + 7) / 8);
+
+    if (size > 0) {
+      std::memcpy(buffer->data(), data, size);
+    }
+
+    auto const* bytes = reinterpret_cast<std::byte const*>(buffer->data());
+    return decode(std::move(buffer), bytes, size);
+  }
+
+  BinaryExport decode(std::shared_ptr<void const> storage, std::byte const* data, std::size_t size) {
+    invariant(little_endian(), "binary model format requires a little-endian host");
+
+    Reader reader(data, size);
+
+    char file_magic[sizeof(magic)];
+    reader.get_array(file_magic, sizeof(file_magic));
+
+    if (std::memcmp(file_magic, magic, sizeof(magic)) != 0) {
+      throw std::runtime_error("binary model: not a ppforest2 binary model");
+    }
+
+    auto const file_version = reader.get<std::uint32_t>();
+
+    if (file_version != version) {
+      throw std::runtime_error(
+          "binary model: unsupported version " + std::to_string(file_version) + " (expected " +
+          std::to_string(version) + ")"
+      );
+    }
+
+    auto const mode     = reader.get<std::uint32_t>();
+    auto const kind     = reader.get<std::uint32_t>();
+    auto const n_trees  = reader.get<std::uint32_t>();
+    auto const n_groups = reader.get<std::uint32_t>();
+    reader.get<std::uint32_t>();
+    auto const meta_size = reader.get<std::uint64_t>();
+
+    if (mode > 1 || kind > kind_forest) {
+      throw std::runtime_error("binary model: invalid header");
+    }
+
+    BinaryExport result;
+    result.storage    = std::move(storage);
+    result.model.mode = mode == 1 ? Mode::Regression : Mode::Classification;
+
+    reader.require<char>(meta_size);
+    std::string meta_text(static_cast<std::size_t>(meta_size), '\0');
+    reader.get_array(meta_text.data(), meta_text.size());
+    reader.align();
+
+    try {
+      result.meta = nlohmann::json::parse(meta_text);
+    } catch (nlohmann::json::parse_error const& e) {
+      throw std::runtime_error(std::string("binary model: invalid metadata: ") + e.what());
+    }
+
+    reader.get_vector(result.model.groups, n_groups);
+    reader.align();
+
+    if (!std::is_sorted(result.model.groups.begin(), result.model.groups.end())) {
+      throw std::runtime_error("binary model: group labels are not sorted");
+    }
+
+    // Every tree needs at least its 16-byte block header.
+    reader.require<std::uint64_t>(2 * static_cast<std::size_t>(n_trees));
+    result.model.trees.resize(n_trees);
+
+    for (CompiledTree& tree : result.model.trees) {
+      auto const n_branches = reader.get<std::uint32_t>();
+      auto const n_leaves   = reader.get<std::uint32_t>();
+      tree.root             = reader.get<std::int32_t>();
+      auto const n_vars     = reader.get<std::uint32_t>();
+
+      if (n_vars > static_cast<std::uint32_t>(std::numeric_limits<int>::max())) {
+        throw std::runtime_error("binary model: invalid tree header");
+      }
+
+      tree.vars    = static_cast<int>(n_vars);
+      tree.storage = result.storage;
+
+      tree.dense_coefficients = reader.borrow_array<Feature>(static_cast<std::size_t>(n_vars) * n_branches);
+
+      tree.cutpoints = reader.borrow_array<Feature>(n_branches);
+      tree.lower     = reader.borrow_array<int>(n_branches);
+      tree.upper     = reader.borrow_array<int>(n_branches);
+      tree.leaves    = reader.borrow_array<Outcome>(n_leaves);
+      reader.align();
+
+      validate(tree, result.model);
+    }
+
+    return result;
+  }
+}
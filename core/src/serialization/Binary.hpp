@@ -0,0 +1,105 @@
+#pragma once
+
+#include "models/CompiledForest.hpp"
+#include "models/Model.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+
+/**
+ * @brief Versioned binary model format for fast, parse-free loading.
+ *
+ * The JSON export stores every node as a nested object, so loading a large
+ * forest means building a full DOM and then recursing through it. The
+ * binary format stores what inference needs as flat arrays, one block per
+ * tree, in the layout of `CompiledTree`:
+ *
+ *   header      magic "PPF2BIN\0", version, mode, model kind, n_trees,
+ *               n_groups, metadata size
+ *   metadata    compact JSON: the export (`config`, `meta`, metrics, ...)
+ *               without the node graph
+ *   groups      int32 × n_groups (classification vote columns)
+ *   per tree    n_branches, n_leaves, root, n_vars, then projectors
+ *               (float32 × n_vars × n_branches, column-major), cutpoints
+ *               (float32), lower / upper (int32), leaves (float32)
+ *
+ * All values are little-endian and every section starts on an 8-byte
+ * boundary, so the arrays can be used where they lie. Reading (`decode`)
+ * copies nothing per tree: each `CompiledTree` array borrows its values
+ * straight from the buffer, which is normally a read-only memory mapping
+ * of the file kept alive by the result (see `io::binary::read_file`).
+ * Only the metadata JSON and the group labels are parsed out.
+ *
+ * The result is an inference-only `CompiledForest` — single trees load as
+ * a one-tree forest with the same predictions and proportions — plus the
+ * export metadata. Training-only state (bootstrap samples, per-node groups
+ * and index values) is not stored; use JSON to round-trip a full model.
+ *
+ * @code
+ *   std::ofstream out("model.ppf2", std::ios::binary);
+ *   binary::write(out, model, export_json);
+ *
+ *   auto loaded = io::binary::read_file("model.ppf2");
+ *   OutcomeVector preds = loaded.model.predict(x);
+ * @endcode
+ */
+namespace ppforest2::serialization::binary {
+  /** @brief File extension that selects the binary format in the CLI. */
+  inline constexpr char const* extension = ".ppf2";
+
+  /** @brief Current format version; readers reject other versions. */
+  inline constexpr std::uint32_t version = 1;
+
+  /** @brief Whether @p path ends with `binary::extension`. */
+  bool has_extension(std::string const& path);
+
+  /** @brief A decoded binary model. */
+  struct BinaryExport {
+    /** @brief Flattened trees, aggregation mode and group columns. */
+    CompiledForest model;
+    /** @brief Export JSON without the node graph (`model` keeps only its scalar fields). */
+    nlohmann::json meta;
+    /**
+     * @brief Buffer the trees' arrays point into (e.g. the mapped file).
+     *
+     * Every `CompiledTree` shares it too, so `model` (or a copy of it)
+     * stays valid after this export is gone.
+     */
+    std::shared_ptr<void const> storage;
+  };
+
+  /**
+   * @brief Serialize @p model and its export metadata.
+   *
+   * @param out          Binary output stream.
+   * @param model        Trained tree or forest.
+   * @param export_json  Full JSON export (`Export::to_json()` plus any extra
+   *                     keys); its `model` block is reduced to scalar fields.
+   */
+  void write(std::ostream& out, Model const& model, nlohmann::json const& export_json);
+
+  /**
+   * @brief Decode a binary model in place.
+   *
+   * The trees borrow their arrays from @p data, which must be 8-byte
+   * aligned and stay valid as long as @p storage is alive; the result
+   * holds on to @p storage.
+   *
+   * Throws `std::runtime_error` on a bad magic, unsupported version or
+   * truncated buffer.
+   */
+  BinaryExport decode(std::shared_ptr<void const> storage, std::byte const* data, std::size_t size);
+
+  /**
+   * @brief Decode a binary model from a transient buffer.
+   *
+   * Copies @p data once into storage owned by the result, then decodes
+   * it in place. Errors as in the overload above.
+   */
+  BinaryExport decode(std::byte const* data, std::size_t size);
+}
@@ -0,0 +1,190 @@
+/**
+ * @file Binary.test.cpp
+ * @brief Tests for the binary model format.
+ *
+ * Round-trips trained models through `binary::write` / `binary::decode`
+ * and checks that the decoded `CompiledForest` predicts exactly like the
+ * node graph it was written from.
+ */
+#include <gtest/gtest.h>
+
+#include "serialization/Binary.hpp"
+#include "serialization/Json.hpp"
+#include "models/Forest.hpp"
+#include "models/Tree.hpp"
+#include "models/TrainingSpec.hpp"
+
+#include "stats/Simulation.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ppforest2;
+using namespace ppforest2::stats;
+using namespace ppforest2::types;
+using json = nlohmann::json;
+
+namespace {
+  std::string encode(Model const& model, json const& export_json) {
+    std::ostringstream out(std::ios::binary);
+    serialization::binary::write(out, model, export_json);
+    return out.str();
+  }
+
+  serialization::binary::BinaryExport decode(std::string const& bytes) {
+    return serialization::binary::decode(reinterpret_cast<std::byte const*>(bytes.data()), bytes.size());
+  }
+
+  json export_json(Model const& model) {
+    return json{{"model_type", "forest"}, {"model", serialization::to_json(model)}, {"extra", 42}};
+  }
+
+  Forest::Ptr train_forest(DataPacket& data) {
+    return Forest::train(
+        TrainingSpec::builder(Mode::Classification).size(10).threads(1).vars(vars::uniform(2)).build(), data.x, data.y
+    );
+  }
+}
+
+TEST(BinaryModel, ForestRoundTripPredictions) {
+  RNG rng(0);
+  auto data   = simulate(90, 4, 3, rng);
+  auto forest = train_forest(data);
+
+  auto const loaded = decode(encode(*forest, export_json(*forest)));
+
+  ASSERT_EQ(Mode::Classification, loaded.model.mode);
+  ASSERT_EQ(forest->trees.size(), loaded.model.trees.size());
+  ASSERT_EQ((std::vector<GroupId>{0, 1, 2}), loaded.model.groups);
+
+  OutcomeVector const expected = forest->predict(data.x);
+  OutcomeVector const actual   = loaded.model.predict(data.x);
+  ASSERT_EQ(expected, actual);
+
+  FeatureMatrix const expected_props = forest->predict(data.x, Proportions{});
+  FeatureMatrix const actual_props   = loaded.model.predict(data.x, Proportions{});
+  ASSERT_EQ(expected_props, actual_props);
+}
+
+TEST(BinaryModel, TreesBorrowTheBuffer) {
+  RNG rng(2);
+  auto data   = simulate(90, 4, 3, rng);
+  auto forest = train_forest(data);
+
+  std::string const bytes = encode(*forest, export_json(*forest));
+  auto buffer             = std::make_shared<std::vector<std::uint64_t>>((bytes.size() + 7) / 8);
+  std::memcpy(buffer->data(), bytes.data(), bytes.size());
+
+  auto const* begin = reinterpret_cast<std::byte const*>(buffer->data());
+  auto const* end   = begin + bytes.size();
+
+  CompiledForest const model = serialization::binary::decode(buffer, begin, bytes.size()).model;
+  buffer.reset();
+
+  for (CompiledTree const& tree : model.trees) {
+    auto const* cutpoints = reinterpret_cast<std::byte const*>(tree.cutpoints.data());
+
+    ASSERT_TRUE(tree.leaves.borrowed());
+    ASSERT_TRUE(cutpoints >= begin && cutpoints < end);
+  }
+
+  // The trees keep the buffer alive after the export is gone.
+  ASSERT_EQ(forest->predict(data.x), model.predict(data.x));
+}
+
+TEST(BinaryModel, MetadataDropsNodeGraph) {
+  RNG rng(1);
+  auto data   = simulate(60, 3, 2, rng);
+  auto forest = train_forest(data);
+
+  auto const loaded = decode(encode(*forest, export_json(*forest)));
+
+  ASSERT_EQ("forest", loaded.meta.at("model_type"));
+  ASSERT_EQ(42, loaded.meta.at("extra"));
+  ASSERT_FALSE(loaded.meta.at("model").contains("trees"));
+}
+
+TEST(BinaryModel, SingleTreeLoadsAsOneTreeForest) {
+  RNG rng(2);
+  auto data = simulate(90, 4, 3, rng);
+  auto tree = Tree::train(TrainingSpec::builder(Mode::Classification).build(), data.x, data.y);
+
+  auto const loaded = decode(encode(*tree, export_json(*tree)));
+
+  ASSERT_EQ(1u, loaded.model.trees.size());
+
+  OutcomeVector const expected = tree->predict(data.x);
+  OutcomeVector const actual   = loaded.model.predict(data.x);
+  ASSERT_EQ(expected, actual);
+
+  FeatureMatrix const expected_props = tree->predict(data.x, Proportions{});
+  FeatureMatrix const actual_props   = loaded.model.predict(data.x, Proportions{});
+  ASSERT_EQ(expected_props, actual_props);
+}
+
+TEST(BinaryModel, RegressionForestRoundTrip) {
+  RNG rng(3);
+  auto data = simulate_regression(80, 3, rng);
+
+  auto spec = TrainingSpec::builder(Mode::Regression)
+                  .grouping(grouping::by_cutpoint())
+                  .leaf(leaf::mean_response())
+                  .stop(stop::any({stop::min_size(5), stop::min_variance(0.001F)}))
+                  .size(5)
+                  .threads(1)
+                  .build();
+
+  auto forest       = Forest::train(spec, data.x, data.y);
+  auto const loaded = decode(encode(*forest, export_json(*forest)));
+
+  ASSERT_EQ(Mode::Regression, loaded.model.mode);
+  ASSERT_TRUE(loaded.model.groups.empty());
+
+  OutcomeVector const expected = forest->predict(data.x);
+  OutcomeVector const actual   = loaded.model.predict(data.x);
+  ASSERT_EQ(expected, actual);
+}
+
+TEST(BinaryModel, RejectsBadMagic) {
+  RNG rng(4);
+  auto data   = simulate(60, 3, 2, rng);
+  auto forest = train_forest(data);
+
+  std::string bytes = encode(*forest, export_json(*forest));
+  bytes[0]          = 'X';
+
+  ASSERT_THROW(decode(bytes), std::runtime_error);
+}
+
+TEST(BinaryModel, RejectsOtherVersion) {
+  RNG rng(5);
+  auto data   = simulate(60, 3, 2, rng);
+  auto forest = train_forest(data);
+
+  std::string bytes = encode(*forest, export_json(*forest));
+  bytes[8]          = static_cast<char>(serialization::binary::version + 1);
+
+  ASSERT_THROW(decode(bytes), std::runtime_error);
+}
+
+TEST(BinaryModel, RejectsTruncatedData) {
+  RNG rng(6);
+  auto data   = simulate(60, 3, 2, rng);
+  auto forest = train_forest(data);
+
+  std::string const bytes = encode(*forest, export_json(*forest));
+
+  for (std::size_t size : {std::size_t{0}, std::size_t{12}, bytes.size() / 2, bytes.size() - 1}) {
+    ASSERT_THROW(decode(bytes.substr(0, size)), std::runtime_error) << "size " << size;
+  }
+}
+
+TEST(BinaryModel, HasExtension) {
+  ASSERT_TRUE(serialization::binary::has_extension("model.ppf2"));
+  ASSERT_FALSE(serialization::binary::has_extension("model.json"));
+  ASSERT_FALSE(serialization::binary::has_extension("ppf2"));
+}
@@ -111,7 +111,7 @@ namespace ppforest2::serialization {
 
       result["groups"] = named_groups;
     } else {
-      result["groups"] = node.groups;
+      result["groups"] = std::vector<GroupId>(node.groups.begin(), node.groups.end());
     }
   }
 
@@ -165,9 +165,50 @@ namespace ppforest2::serialization {
     };
   }
 
+  namespace {
+    /** @brief A bag's sample: its indices, or only its stream when the forest draws samples again. */
+    void sample_to_json(BaggedTree const& tree, json& result) {
+      if (tree.bootstrap) {
+        result["stream"] = tree.stream;
+      } else {
+        result["sample_indices"] = tree.sample_indices;
+      }
+    }
+
+    /** @brief Forest-level fields: the shared bootstrap of compact bags, when there is one. */
+    json forest_to_json(Forest const& forest, std::vector<json> trees_json) {
+      json result = json{
+          {"trees", std::move(trees_json)},
+          {"degenerate", forest.degenerate},
+      };
+
+      if (!forest.trees.empty() && forest.trees.front()->bootstrap) {
+        result["bootstrap"] = forest.trees.front()->bootstrap->to_json();
+      }
+
+      return result;
+    }
+
+    /** @brief Wrap @p inner with the sample recorded in @p tree_json. */
+    BaggedTree::Ptr bag_from_json(json const& tree_json, std::unique_ptr<Tree> inner, Bootstrap::Ptr const& bootstrap) {
+      if (bootstrap && tree_json.contains("stream")) {
+        return std::make_unique<BaggedTree>(std::move(inner), bootstrap, tree_json["stream"].get<std::uint64_t>());
+      }
+
+      auto sample_indices = tree_json.contains("sample_indices") ? tree_json["sample_indices"].get<std::vector<int>>()
+                                                                 : std::vector<int>{};
+
+      return std::make_unique<BaggedTree>(std::move(inner), std::move(sample_indices));
+    }
+
+    Bootstrap::Ptr bootstrap_from_json(json const& j) {
+      return j.contains("bootstrap") ? Bootstrap::from_json(j["bootstrap"]) : nullptr;
+    }
+  }
+
   json to_json(BaggedTree const& tree) {
-    json result              = to_json(*tree.model);
-    result["sample_indices"] = tree.sample_indices;
+    json result = to_json(*tree.model);
+    sample_to_json(tree, result);
     return result;
   }
 
@@ -179,10 +220,7 @@ namespace ppforest2::serialization {
       trees_json.push_back(to_json(*tree));
     }
 
-    return json{
-        {"trees", trees_json},
-        {"degenerate", forest.degenerate},
-    };
+    return forest_to_json(forest, std::move(trees_json));
   }
 
   json to_json(ConfusionMatrix const& cm) {
@@ -262,8 +300,8 @@ namespace ppforest2::serialization {
   }
 
   json to_json(BaggedTree const& tree, GroupNames const& group_names) {
-    json result              = to_json(*tree.model, group_names);
-    result["sample_indices"] = tree.sample_indices;
+    json result = to_json(*tree.model, group_names);
+    sample_to_json(tree, result);
     return result;
   }
 
@@ -275,10 +313,7 @@ namespace ppforest2::serialization {
       trees_json.push_back(to_json(*tree, group_names));
     }
 
-    return json{
-        {"trees", trees_json},
-        {"degenerate", forest.degenerate},
-    };
+    return forest_to_json(forest, std::move(trees_json));
   }
 
   json to_json(ConfusionMatrix const& cm, GroupNames const& group_names) {
@@ -437,14 +472,13 @@ namespace ppforest2::serialization {
     auto forest        = std::make_unique<ClassificationForest>(placeholder_classification_spec());
     forest->degenerate = j.value("degenerate", false);
 
-    for (auto const& tree_json : j.at("trees")) {
-      auto sample_indices = tree_json.contains("sample_indices") ? tree_json["sample_indices"].get<std::vector<int>>()
-                                                                 : std::vector<int>{};
+    Bootstrap::Ptr const bootstrap = bootstrap_from_json(j);
 
+    for (auto const& tree_json : j.at("trees")) {
       std::unique_ptr<Tree> inner_tree =
           std::make_unique<ClassificationTree>(node_from_json(tree_json.at("root")), placeholder_classification_spec());
 
-      forest->add_tree(std::make_unique<BaggedTree>(std::move(inner_tree), std::move(sample_indices)));
+      forest->add_tree(bag_from_json(tree_json, std::move(inner_tree), bootstrap));
     }
 
     return forest;
@@ -635,10 +669,9 @@ namespace nlohmann {
 
     forest->degenerate = mj.value("degenerate", false);
 
-    for (auto const& tree_json : mj.at("trees")) {
-      auto sample_indices = tree_json.contains("sample_indices") ? tree_json["sample_indices"].get<std::vector<int>>()
-                                                                 : std::vector<int>{};
+    Bootstrap::Ptr const bootstrap = bootstrap_from_json(mj);
 
+    for (auto const& tree_json : mj.at("trees")) {
       auto root = is_regression ? node_from_json(tree_json.at("root")) : node_from_json(tree_json.at("root"), groups);
 
       // The bag wrapper is mode-agnostic (`BaggedTree` = `Bagged<Tree>`).
@@ -649,7 +682,7 @@ namespace nlohmann {
               ? static_cast<std::unique_ptr<Tree>>(std::make_unique<RegressionTree>(std::move(root), spec))
               : static_cast<std::unique_ptr<Tree>>(std::make_unique<ClassificationTree>(std::move(root), spec));
 
-      forest->add_tree(std::make_unique<BaggedTree>(std::move(inner), std::move(sample_indices)));
+      forest->add_tree(bag_from_json(tree_json, std::move(inner), bootstrap));
     }
 
     return {
@@ -13,6 +13,7 @@
 #include "models/ClassificationForest.hpp"
 #include "models/RegressionTree.hpp"
 #include "models/RegressionForest.hpp"
+#include "stats/Simulation.hpp"
 #include "utils/Invariant.hpp"
 #include "utils/Macros.hpp"
 
@@ -254,6 +255,26 @@ TEST(JsonStructure, ForestSampleIndicesRoundTrip) {
   }
 }
 
+TEST(JsonStructure, CompactForestKeepsStreams) {
+  RNG rng(0);
+  auto data = simulate(60, 3, 2, rng);
+
+  auto const forest = Forest::train(
+      TrainingSpec::builder(types::Mode::Classification).size(4).seed(7).compact_samples(true).build(), data.x, data.y
+  );
+
+  json const j = to_json(*forest);
+  ASSERT_TRUE(j.contains("bootstrap"));
+
+  auto const restored = from_json<Forest::Ptr>(j);
+
+  for (size_t i = 0; i < forest->trees.size(); ++i) {
+    EXPECT_FALSE(j["trees"][i].contains("sample_indices"));
+    EXPECT_EQ(forest->trees[i]->stream, restored->trees[i]->stream);
+    EXPECT_EQ(forest->trees[i]->sample(), restored->trees[i]->sample());
+  }
+}
+
 TEST(JsonStructure, VariableImportanceRoundTrip) {
   VariableImportance vi;
   vi.scale       = types::FeatureVector::Ones(4);
@@ -57,4 +57,39 @@ namespace ppforest2::stats {
   float ConfusionMatrix::error() const {
     return 1.0f - static_cast<float>(values.trace()) / static_cast<float>(values.sum());
   }
+
+  void ConfusionMatrixAccumulator::add(GroupIdVector const& predictions, GroupIdVector const& actual) {
+    if (predictions.rows() != actual.rows()) {
+      throw std::invalid_argument("cannot compute confusion matrix if predictions and observations have different sizes"
+      );
+    }
+
+    for (int i = 0; i < predictions.rows(); i++) {
+      counts[{actual(i), predictions(i)}]++;
+    }
+  }
+
+  ConfusionMatrix ConfusionMatrixAccumulator::matrix() const {
+    ConfusionMatrix cm;
+
+    // Rows and columns are indexed by the actual labels, as in the
+    // vector constructor.
+    for (auto const& [pair, count] : counts) {
+      cm.label_index.emplace(pair.first, 0);
+    }
+
+    int i = 0;
+
+    for (auto& [label, index] : cm.label_index) {
+      index = i++;
+    }
+
+    cm.values = Matrix<int>::Zero(static_cast<int>(cm.label_index.size()), static_cast<int>(cm.label_index.size()));
+
+    for (auto const& [pair, count] : counts) {
+      cm.values(cm.label_index.at(pair.first), cm.label_index.at(pair.second)) += count;
+    }
+
+    return cm;
+  }
 }
@@ -7,6 +7,7 @@
 #include "utils/Types.hpp"
 
 #include <map>
+#include <utility>
 
 namespace ppforest2::stats {
   /**
@@ -58,4 +59,33 @@ namespace ppforest2::stats {
      */
     float error() const;
   };
+
+  /**
+   * @brief Builds a `ConfusionMatrix` from predictions that arrive in chunks.
+   *
+   * Counts (actual, predicted) pairs as each chunk is added, so memory
+   * depends on the number of groups, not the number of rows. `matrix()`
+   * equals a `ConfusionMatrix` built from the concatenated vectors.
+   *
+   * @code
+   *   ConfusionMatrixAccumulator acc;
+   *   while (reader.next(chunk, 10000)) {
+   *     acc.add(model.predict(chunk.x).cast<GroupId>(), chunk.y.cast<GroupId>());
+   *   }
+   *   ConfusionMatrix cm = acc.matrix();
+   * @endcode
+   */
+  struct ConfusionMatrixAccumulator {
+    /** @brief Number of rows per (actual, predicted) label pair. */
+    std::map<std::pair<int, int>, int> counts;
+
+    /**
+     * @brief Count one chunk of predictions against its actual labels.
+     * @throws std::invalid_argument If predictions and actual have different sizes.
+     */
+    void add(types::GroupIdVector const& predictions, types::GroupIdVector const& actual);
+
+    /** @brief The confusion matrix over every chunk added so far. */
+    ConfusionMatrix matrix() const;
+  };
 }
@@ -140,6 +140,29 @@ TEST(ConfusionMatrix, NonConsecutiveLabels) {
   ASSERT_NEAR(3.0 / 6.0, result.error(), 0.001);
 }
 
+/* Accumulating in chunks gives the same matrix as the full vectors. */
+TEST(ConfusionMatrix, AccumulatorMatchesFullVectors) {
+  GroupIdVector actual      = VEC(GroupId, 1, 1, 3, 3, 5, 5);
+  GroupIdVector predictions = VEC(GroupId, 1, 3, 3, 5, 5, 1);
+
+  ConfusionMatrixAccumulator acc;
+  acc.add(predictions.head(2), actual.head(2));
+  acc.add(predictions.segment(2, 3), actual.segment(2, 3));
+  acc.add(predictions.tail(1), actual.tail(1));
+
+  ConfusionMatrix const expected = ConfusionMatrix(predictions, actual);
+  ConfusionMatrix const result   = acc.matrix();
+
+  ASSERT_EQ(expected.label_index, result.label_index);
+  ASSERT_EQ(expected.values, result.values);
+  ASSERT_NEAR(expected.error(), result.error(), 1e-6);
+}
+
+TEST(ConfusionMatrix, AccumulatorRejectsMismatchedChunk) {
+  ConfusionMatrixAccumulator acc;
+  ASSERT_THROW(acc.add(VEC(GroupId, 0, 1), VEC(GroupId, 0)), std::invalid_argument);
+}
+
 // ---------------------------------------------------------------------------
 // Overall error rate — error()
 // ---------------------------------------------------------------------------
@@ -2,8 +2,11 @@
 
 #include "utils/Invariant.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <iterator>
 #include <stdexcept>
+#include <utility>
 
 using namespace ppforest2::types;
 
@@ -48,34 +51,55 @@ namespace ppforest2::stats {
   }
 
   GroupPartition::BlockMap GroupPartition::init_blocks(GroupVector const& y) {
-    std::map<Group, Block> blocks;
+    BlockMap blocks;
 
     for (int i = 0; i < y.rows(); i++) {
-      if (blocks.count(y(i)) == 0) {
-        Group curr   = y(i);
-        blocks[curr] = Block{.start = i};
-
-        if (i != 0) {
-          Group prev        = y(i - 1);
-          blocks[curr].prev = prev;
-          blocks[prev].next = curr;
-          blocks[prev].end  = i - 1;
-          blocks[prev].size = i - blocks[prev].start;
-        }
-      } else if (y(i - 1) != y(i)) {
+      if (i != 0 && y(i - 1) == y(i)) {
+        continue;
+      }
+
+      if (blocks.count(y(i)) != 0) {
         throw std::invalid_argument("GroupPartition: data is not organized in contiguous groups");
       }
+
+      blocks[y(i)] = Block{i, i, 0};
     }
 
-    Group const last     = y(y.rows() - 1);
-    blocks.at(last).end  = y.rows() - 1;
-    blocks.at(last).size = y.rows() - blocks.at(last).start;
+    // Close each block at the row before the next block starts.
+    for (int i = 0; i < y.rows(); i++) {
+      Block& block = blocks[y(i)];
+      block.end    = i;
+      block.size   = i - block.start + 1;
+    }
 
     return blocks;
   }
 
+  GroupPartition::GroupSet GroupPartition::init_groups(BlockMap const& blocks) {
+    GroupSet groups;
+    groups.reserve(blocks.size());
+
+    for (auto const& [g, block] : blocks) {
+      groups.insert(g);
+    }
+
+    return groups;
+  }
+
+  GroupPartition::GroupSet GroupPartition::init_groups(GroupMap const& supergroups) {
+    utils::ScratchVector<Group> values;
+    values.reserve(supergroups.size());
+
+    for (auto const& [g, sg] : supergroups) {
+      values.push_back(sg);
+    }
+
+    return GroupSet(values.begin(), values.end());
+  }
+
   GroupPartition::GroupMap GroupPartition::init_supergroups(GroupSet const& groups) {
     GroupMap sg;
+    sg.reserve(groups.size());
 
     for (Group const& g : groups) {
       sg[g] = g;
@@ -84,11 +108,19 @@ namespace ppforest2::stats {
     return sg;
   }
 
+  GroupPartition::GroupInvMap GroupPartition::init_subgroups(GroupMap const& supergroups) {
+    utils::ScratchVector<std::pair<Group, Group>> pairs;
+    pairs.reserve(supergroups.size());
+
+    for (auto const& [g, sg] : supergroups) {
+      pairs.emplace_back(sg, g);
+    }
+
+    return GroupInvMap(std::move(pairs));
+  }
+
   GroupPartition::GroupPartition(GroupVector const& y)
-      : groups(unique(y))
-      , Blocks(init_blocks(y))
-      , supergroups(init_supergroups(groups))
-      , subgroups(utils::invert(supergroups)) {}
+      : GroupPartition(init_blocks(y)) {}
 
   GroupPartition::GroupPartition(types::OutcomeVector const& y)
       : GroupPartition(validate_and_cast_to_ids(y)) {}
@@ -98,29 +130,29 @@ namespace ppforest2::stats {
     return is_contiguous(y_int);
   }
 
-  GroupPartition::GroupPartition(BlockMap const& Blocks_)
-      : groups(utils::keys(Blocks_))
-      , Blocks(Blocks_)
+  GroupPartition::GroupPartition(BlockMap Blocks_)
+      : groups(init_groups(Blocks_))
       , supergroups(init_supergroups(groups))
-      , subgroups(utils::invert(supergroups)) {}
+      , subgroups(init_subgroups(supergroups))
+      , Blocks(std::move(Blocks_)) {}
 
-  GroupPartition::GroupPartition(BlockMap const& Blocks_, GroupSet const& groups_)
+  GroupPartition::GroupPartition(BlockMap Blocks_, GroupSet const& groups_)
       : groups(groups_)
-      , Blocks(Blocks_)
       , supergroups(init_supergroups(groups_))
-      , subgroups(utils::invert(supergroups)) {}
+      , subgroups(init_subgroups(supergroups))
+      , Blocks(std::move(Blocks_)) {}
 
-  GroupPartition::GroupPartition(BlockMap const& Blocks_, GroupMap const& supergroups_)
-      : groups(utils::values(supergroups_))
-      , Blocks(Blocks_)
+  GroupPartition::GroupPartition(BlockMap Blocks_, GroupMap const& supergroups_)
+      : groups(init_groups(supergroups_))
       , supergroups(supergroups_)
-      , subgroups(utils::invert(supergroups)) {}
+      , subgroups(init_subgroups(supergroups))
+      , Blocks(std::move(Blocks_)) {}
 
-  GroupPartition::GroupPartition(BlockMap const& Blocks_, GroupSet const& groups_, GroupMap const& supergroups_)
+  GroupPartition::GroupPartition(BlockMap Blocks_, GroupSet const& groups_, GroupMap const& supergroups_)
       : groups(groups_)
-      , Blocks(Blocks_)
       , supergroups(supergroups_)
-      , subgroups(utils::invert(supergroups)) {}
+      , subgroups(init_subgroups(supergroups))
+      , Blocks(std::move(Blocks_)) {}
 
   int GroupPartition::group_start(Group const& group) const {
     return Blocks.at(group).start;
@@ -142,6 +174,56 @@ namespace ppforest2::stats {
     return total;
   }
 
+  int GroupPartition::group_weight(Group const& g, WeightVector const& weights) const {
+    return group(weights, g).sum();
+  }
+
+  int GroupPartition::total_weight(WeightVector const& weights) const {
+    int total = 0;
+    for (auto const& kv : Blocks) {
+      total += weights.segment(kv.second.start, kv.second.size).sum();
+    }
+    return total;
+  }
+
+  GroupPartition::Rows GroupPartition::group_rows(Group const& group) const {
+    Rows indices;
+
+    for (auto const& g : subgroups.at(group)) {
+      for (int i = group_start(g); i <= group_end(g); ++i) {
+        indices.push_back(i);
+      }
+    }
+
+    return indices;
+  }
+
+  GroupPartition::Rows GroupPartition::row_indices() const {
+    Rows indices;
+    indices.reserve(static_cast<std::size_t>(total_size()));
+
+    for (auto const& [g, block] : Blocks) {
+      for (int i = block.start; i <= block.end; ++i) {
+        indices.push_back(i);
+      }
+    }
+
+    return indices;
+  }
+
+  GroupPartition GroupPartition::compact() const {
+    BlockMap compact_blocks;
+    compact_blocks.reserve(Blocks.size());
+    int start = 0;
+
+    for (auto const& [g, block] : Blocks) {
+      compact_blocks[g] = Block{start, start + block.size - 1, block.size};
+      start += block.size;
+    }
+
+    return GroupPartition(std::move(compact_blocks), groups, supergroups);
+  }
+
   FeatureVector GroupPartition::mean(FeatureMatrix const& x) const {
     return data(x).colwise().mean();
   }
@@ -150,9 +232,7 @@ namespace ppforest2::stats {
     FeatureVector const global_mean = mean(x);
     FeatureMatrix result            = FeatureMatrix::Zero(x.cols(), x.cols());
 
-    GroupSet const groups = utils::values(supergroups);
-
-    for (Group const& g : groups) {
+    for (auto const& [g, subs] : subgroups) {
       auto group_data = group(x, g);
       auto group_mean = group_data.colwise().mean().transpose();
       auto centered   = group_mean - global_mean;
@@ -166,9 +246,7 @@ namespace ppforest2::stats {
   FeatureMatrix GroupPartition::wgss(FeatureMatrix const& x) const {
     FeatureMatrix result = FeatureMatrix::Zero(x.cols(), x.cols());
 
-    GroupSet const groups = utils::values(supergroups);
-
-    for (Group const& g : groups) {
+    for (auto const& [g, subs] : subgroups) {
       auto group_data = group(x, g);
       auto centered   = group_data.rowwise() - group_data.colwise().mean();
 
@@ -178,23 +256,219 @@ namespace ppforest2::stats {
     return result;
   }
 
-  GroupPartition GroupPartition::subset(GroupSet const& groups) const {
-    BlockMap subset_blocks;
-    std::optional<Group> prev;
+  template<typename BlockMoments>
+  GroupPartition::Scatter GroupPartition::merge_blocks(Eigen::Index p, BlockMoments&& block_moments) const {
+    // Accumulate in double so the result does not depend, at the last
+    // bits, on block order or alignment — PDA amplifies such differences
+    // on ill-conditioned nodes.
+    using Accumulator = Eigen::MatrixXd;
+    using AccVector   = Eigen::VectorXd;
+
+    struct BlockStats {
+      AccVector mean;
+      double size;
+    };
+
+    struct GroupStats {
+      std::vector<BlockStats> blocks;
+      AccVector mean;
+      double size;
+    };
+
+    Accumulator between = Accumulator::Zero(p, p);
+    Accumulator within  = Accumulator::Zero(p, p);
+
+    std::vector<GroupStats> group_stats;
+    group_stats.reserve(subgroups.size());
+
+    AccVector total_sum = AccVector::Zero(p);
+    double total_size   = 0;
+
+    // Single pass over the blocks: each block's moments are taken once.
+    for (auto const& [g, subs] : subgroups) {
+      GroupStats acc{{}, AccVector::Zero(p), 0};
+
+      for (Group const sub : subs) {
+        Block const& block   = Blocks.at(sub);
+        auto size            = static_cast<double>(block.size);
+        AccVector block_mean = block_moments(block, within, size);
+
+        acc.mean += size * block_mean;
+        acc.size += size;
+        acc.blocks.push_back({std::move(block_mean), size});
+      }
 
-    for (auto const& g : groups) {
-      Block Block = {.start = Blocks.at(g).start, .end = Blocks.at(g).end, .size = Blocks.at(g).size};
+      total_sum += acc.mean;
+      total_size += acc.size;
+      acc.mean /= acc.size;
+
+      group_stats.push_back(std::move(acc));
+    }
+
+    AccVector const global_mean = total_sum / total_size;
+
+    // Merge: block means around their group mean (within), group means
+    // around the global mean (between).
+    for (GroupStats const& acc : group_stats) {
+      if (acc.blocks.size() > 1) {
+        for (BlockStats const& block : acc.blocks) {
+          within.selfadjointView<Eigen::Lower>().rankUpdate(block.mean - acc.mean, block.size);
+        }
+      }
+
+      between.selfadjointView<Eigen::Lower>().rankUpdate(acc.mean - global_mean, acc.size);
+    }
+
+    Accumulator const b = between.selfadjointView<Eigen::Lower>();
+    Accumulator const w = within.selfadjointView<Eigen::Lower>();
+    return {b.cast<Feature>(), w.cast<Feature>()};
+  }
+
+  GroupPartition::Scatter GroupPartition::scatter(Eigen::Ref<FeatureMatrix const> const& x) const {
+    Eigen::Index const p = x.cols();
+
+    struct GroupStats {
+      FeatureVector mean;
+      int size;
+    };
+
+    // Column sums of a block's rows, read in place once and added row by
+    // row to both the total and the block's group: the orders the means
+    // over `data(x)` and `group(x, g)` add them in, since blocks and each
+    // group's subgroups are both kept in label order. Kept scalar on
+    // purpose: a vectorized column sum reassociates the additions, and PDA
+    // turns those last bits into different projectors on the golden forests.
+    auto const add_block = [&](FeatureVector& total, FeatureVector& group, Block const& block) {
+      for (Eigen::Index j = 0; j < p; ++j) {
+        auto const column = x.col(j).segment(block.start, block.size);
+
+        for (int i = 0; i < block.size; ++i) {
+          total(j) += column(i);
+          group(j) += column(i);
+        }
+      }
+    };
+
+    std::vector<GroupStats> group_stats;
+    group_stats.reserve(subgroups.size());
+
+    // Position in `group_stats` of each block's group, in `Blocks` order.
+    std::vector<std::size_t> block_group(Blocks.size(), subgroups.size());
+
+    for (auto const& [g, subs] : subgroups) {
+      int size = 0;
+
+      for (Group const sub : subs) {
+        auto const block = Blocks.find(sub);
+        invariant(block != Blocks.end(), "GroupPartition::scatter: subgroup without a block");
+
+        block_group[static_cast<std::size_t>(std::distance(Blocks.begin(), block))] = group_stats.size();
+        size += block->second.size;
+      }
+
+      group_stats.push_back({FeatureVector::Zero(p), size});
+    }
+
+    FeatureVector total_sum = FeatureVector::Zero(p);
+    int total_size          = 0;
+    auto group              = block_group.begin();
+
+    for (auto const& [g, block] : Blocks) {
+      invariant(block.start >= 0 && block.end < x.rows(), "GroupPartition::scatter: block out of bounds");
+      invariant(block.size == block.end - block.start + 1, "GroupPartition::scatter: block size mismatch");
+      invariant(*group < group_stats.size(), "GroupPartition::scatter: block outside every group");
+
+      add_block(total_sum, group_stats[*group++].mean, block);
+      total_size += block.size;
+    }
 
-      if (prev) {
-        Block.prev                   = *prev;
-        subset_blocks.at(*prev).next = g;
+    FeatureVector const global_mean = total_sum / static_cast<Feature>(total_size);
+
+    for (GroupStats& stats : group_stats) {
+      stats.mean /= static_cast<Feature>(stats.size);
+    }
+
+    // Float, as `bgss` and `wgss` accumulate: this is the default PDA
+    // path and its results are pinned by the golden files. The weighted
+    // and cached overloads, which have no float baseline, go through
+    // `merge_blocks` in double.
+    FeatureMatrix between = FeatureMatrix::Zero(p, p);
+    FeatureMatrix within  = FeatureMatrix::Zero(p, p);
+
+    // Rows are centered into this buffer a chunk at a time, so W's rank
+    // updates read a bounded p × chunk block instead of evaluating a
+    // centered copy of each whole block.
+    Eigen::Index constexpr chunk = 256;
+    FeatureMatrix centered(std::min<Eigen::Index>(chunk, x.rows()), p);
+
+    auto stats = group_stats.begin();
+
+    for (auto const& [g, subs] : subgroups) {
+      // Upper triangle: entry (i, j), i > j, of the mirrored result is then
+      // (n_g shift_i) shift_j, as `bgss`'s scaled outer product rounds it.
+      FeatureVector const shift = stats->mean - global_mean;
+      between.selfadjointView<Eigen::Upper>().rankUpdate(shift, static_cast<Feature>(stats->size));
+
+      for (Group const sub : subs) {
+        Block const& block = Blocks.at(sub);
+
+        for (Eigen::Index offset = 0; offset < block.size; offset += chunk) {
+          Eigen::Index const rows = std::min<Eigen::Index>(chunk, block.size - offset);
+
+          centered.topRows(rows) = x.middleRows(block.start + offset, rows).rowwise() - stats->mean.transpose();
+          within.selfadjointView<Eigen::Lower>().rankUpdate(centered.topRows(rows).transpose());
+        }
       }
 
-      subset_blocks[g] = Block;
-      prev             = g;
+      ++stats;
+    }
+
+    return {between.selfadjointView<Eigen::Upper>(), within.selfadjointView<Eigen::Lower>()};
+  }
+
+  GroupPartition::Scatter
+  GroupPartition::scatter(Eigen::Ref<FeatureMatrix const> const& x, WeightVector const& weights) const {
+    return merge_blocks(x.cols(), [&](Block const& block, Eigen::MatrixXd& within, double& size) {
+      invariant(block.start >= 0 && block.end < x.rows(), "GroupPartition::scatter: block out of bounds");
+      invariant(block.end < weights.size(), "GroupPartition::scatter: weights shorter than the block");
+
+      Eigen::VectorXd const w = weights.segment(block.start, block.size).cast<double>();
+      size                    = w.sum();
+
+      Eigen::MatrixXd centered   = x.middleRows(block.start, block.size).cast<double>();
+      Eigen::VectorXd block_mean = (centered.transpose() * w) / size;
+
+      // Σ wᵢ cᵢ cᵢᵀ as one rank update of the rows scaled by √wᵢ.
+      centered.rowwise() -= block_mean.transpose();
+      centered = w.cwiseSqrt().asDiagonal() * centered;
+      within.selfadjointView<Eigen::Lower>().rankUpdate(centered.transpose());
+      return block_mean;
+    });
+  }
+
+  GroupPartition::Scatter GroupPartition::scatter(ScatterCache& cache, std::vector<int> const& cols) const {
+    Eigen::MatrixXd cross;
+
+    auto const q = static_cast<Eigen::Index>(cols.size());
+
+    return merge_blocks(q, [&](Block const& block, Eigen::MatrixXd& within, double& size) {
+      Eigen::VectorXd block_mean;
+      size = cache.moments(block.start, block.size, cols, block_mean, cross);
+
+      within.triangularView<Eigen::Lower>() += cross;
+      return block_mean;
+    });
+  }
+
+  GroupPartition GroupPartition::subset(GroupSet const& groups) const {
+    BlockMap subset_blocks;
+    subset_blocks.reserve(groups.size());
+
+    for (auto const& g : groups) {
+      subset_blocks[g] = Blocks.at(g);
     }
 
-    return GroupPartition(subset_blocks, groups);
+    return GroupPartition(std::move(subset_blocks), groups);
   }
 
   std::pair<GroupPartition, GroupPartition> GroupPartition::split(SplitSizes const& left_sizes) const {
@@ -207,15 +481,15 @@ namespace ppforest2::stats {
       invariant(left_count >= 0 && left_count <= block.size, "GroupPartition::split: left_count out of range");
 
       if (left_count > 0) {
-        l_blocks.emplace(g, Block{block.start, block.start + left_count - 1, left_count});
+        l_blocks[g] = Block{block.start, block.start + left_count - 1, left_count};
       }
 
       if (left_count < block.size) {
-        r_blocks.emplace(g, Block{block.start + left_count, block.end, block.size - left_count});
+        r_blocks[g] = Block{block.start + left_count, block.end, block.size - left_count};
       }
     }
 
-    return {GroupPartition(l_blocks), GroupPartition(r_blocks)};
+    return {GroupPartition(std::move(l_blocks)), GroupPartition(std::move(r_blocks))};
   }
 
   GroupPartition GroupPartition::two_groups(int start0, int end0, int start1, int end1) {
@@ -227,10 +501,10 @@ namespace ppforest2::stats {
     int size1 = end1 - start1 + 1;
 
     BlockMap blocks;
-    blocks[0] = Block{start0, end0, size0, 1, std::nullopt};
-    blocks[1] = Block{start1, end1, size1, std::nullopt, 0};
+    blocks[0] = Block{start0, end0, size0};
+    blocks[1] = Block{start1, end1, size1};
 
-    return GroupPartition(blocks);
+    return GroupPartition(std::move(blocks));
   }
 
   GroupPartition GroupPartition::single_group(int start, int end) {
@@ -239,9 +513,9 @@ namespace ppforest2::stats {
     int size = end - start + 1;
 
     BlockMap blocks;
-    blocks[0] = Block{start, end, size, std::nullopt, std::nullopt};
+    blocks[0] = Block{start, end, size};
 
-    return GroupPartition(blocks);
+    return GroupPartition(std::move(blocks));
   }
 
   GroupPartition GroupPartition::remap(GroupMap const& mapping) const {
@@ -250,6 +524,7 @@ namespace ppforest2::stats {
 
   GroupPartition GroupPartition::collapse() const {
     GroupMap mapping;
+    mapping.reserve(groups.size());
     for (auto const& g : groups) {
       mapping[g] = 0;
     }
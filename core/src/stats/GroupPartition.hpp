@@ -1,14 +1,13 @@
 #pragma once
 
 
+#include "stats/ScatterCache.hpp"
 #include "stats/Stats.hpp"
 #include "utils/Types.hpp"
-#include "utils/Map.hpp"
+#include "utils/Flat.hpp"
 #include "utils/Invariant.hpp"
+#include "utils/Scratch.hpp"
 
-#include <map>
-#include <optional>
-#include <set>
 #include <vector>
 #include <Eigen/Dense>
 
@@ -24,6 +23,15 @@ namespace ppforest2::stats {
    * Groups can be hierarchically merged via remap(), which assigns
    * supergroup labels while tracking the original subgroups.
    *
+   * Blocks and group bookkeeping live in sorted flat vectors
+   * (`utils::FlatSet` / `utils::FlatMap` / `utils::FlatSetMap`) rather
+   * than node-based trees: a node's partition is five contiguous arrays,
+   * so copying one into a builder step or deriving a child via subset() /
+   * remap() costs the same few small allocations regardless of the number
+   * of groups. Those arrays, and the row index lists the partition hands
+   * out, are allocated from the current `utils::ScratchArena` region when
+   * one is open (the tree builder opens one per node), else from the heap.
+   *
    * @code
    *   // y must be sorted so equal values are contiguous.
    *   GroupPartition y_part(y);
@@ -41,12 +49,18 @@ namespace ppforest2::stats {
    */
   class GroupPartition {
     using Group       = types::GroupId;
-    using GroupSet    = std::set<types::GroupId>;
-    using GroupMap    = std::map<types::GroupId, types::GroupId>;
-    using GroupInvMap = std::map<types::GroupId, GroupSet>;
     using GroupVector = types::GroupIdVector;
 
   public:
+    template<typename T> using Allocator = utils::ScratchAllocator<T>;
+
+    using GroupSet    = utils::FlatSet<types::GroupId, Allocator<types::GroupId>>;
+    using GroupMap    = utils::FlatMap<types::GroupId, types::GroupId, Allocator<std::pair<Group, Group>>>;
+    using GroupInvMap = utils::FlatSetMap<types::GroupId, types::GroupId, Allocator<types::GroupId>>;
+
+    /** @brief Row indices, in the current scratch region. */
+    using Rows = utils::ScratchVector<int>;
+
     /** @brief Check whether all equal values in @p y form a single contiguous block. */
     static bool is_contiguous(GroupVector const& y);
 
@@ -113,6 +127,11 @@ namespace ppforest2::stats {
      */
     int total_size() const;
 
+    /** @brief Sum of @p weights over the rows of @p group (or supergroup). */
+    int group_weight(Group const& group, types::WeightVector const& weights) const;
+    /** @brief Sum of @p weights over all rows of the partition: its size with duplicates counted. */
+    int total_weight(types::WeightVector const& weights) const;
+
     /**
        * @brief Extract rows belonging to a group (or supergroup).
        *
@@ -125,20 +144,18 @@ namespace ppforest2::stats {
        * @return       Block expression over the rows of @p group.
        */
     template<typename Derived> auto group(Eigen::MatrixBase<Derived> const& x, Group const& group) const {
-      std::vector<int> indices;
+      Rows indices = group_rows(group);
 
-      auto const& subs = this->subgroups.at(group);
-
-      for (auto const& g : subs) {
-        for (int i = group_start(g); i <= group_end(g); ++i) {
-          invariant(i >= 0 && i < x.rows(), "GroupPartition::group: index out of bounds");
-          indices.push_back(i);
-        }
+      for (int const i : indices) {
+        invariant(i >= 0 && i < x.rows(), "GroupPartition::group: index out of bounds");
       }
 
       return x(indices, Eigen::all);
     }
 
+    /** @brief Row indices of @p group (or supergroup), block by block in label order. */
+    Rows group_rows(Group const& group) const;
+
     /**
        * @brief Extract all rows across all groups.
        *
@@ -146,17 +163,34 @@ namespace ppforest2::stats {
        * @return   Sub-matrix with all grouped rows.
        */
     template<typename Derived> auto data(Eigen::MatrixBase<Derived> const& x) const {
-      std::vector<int> indices;
+      return x(row_indices(), Eigen::all);
+    }
 
-      for (auto const& kv : Blocks) {
-        auto const& g = kv.first;
-        for (int i = group_start(g); i <= group_end(g); ++i) {
-          indices.push_back(i);
-        }
-      }
+    /**
+     * @brief Row indices covered by the partition, block by block in label order.
+     *
+     * `x(row_indices(), cols)` gathers a node-local working set whose rows
+     * are addressed by `compact()`.
+     */
+    Rows row_indices() const;
 
-      return x(indices, Eigen::all);
-    }
+    /**
+     * @brief Same groups and supergroups, with blocks renumbered back to back from row 0.
+     *
+     * Blocks keep their label order and sizes, so row `k` of
+     * `x(row_indices(), cols)` belongs to the same group under `compact()`
+     * as row `row_indices()[k]` of `x` does under this partition. Lets a
+     * strategy work on the O(node rows) working set instead of the full
+     * training matrix; group-wise statistics see the same values in the
+     * same order and therefore produce identical results.
+     */
+    GroupPartition compact() const;
+
+    /** @brief Between- and within-group sum of squares matrices (p × p each). */
+    struct Scatter {
+      types::FeatureMatrix bgss;
+      types::FeatureMatrix wgss;
+    };
 
     /** @brief Overall mean of all grouped rows (p). */
     types::FeatureVector mean(types::FeatureMatrix const& x) const;
@@ -165,6 +199,42 @@ namespace ppforest2::stats {
     /** @brief Within-group sum of squares matrix (p × p). */
     types::FeatureMatrix wgss(types::FeatureMatrix const& x) const;
 
+    /**
+     * @brief BGSS and WGSS together, in two passes over the rows, without gathering them.
+     *
+     * Each block is read in place twice. The first pass takes the column
+     * sums behind the global and group means, added in the order `mean`
+     * and `group` use (O(n p)). The second accumulates
+     *
+     *   W = Σ_g Σ_{i∈g} (x_i − m_g)(x_i − m_g)ᵀ
+     *
+     * as symmetric rank updates over chunks of centered rows (O(n p²)).
+     * B = Σ_g n_g (m_g − m)(m_g − m)ᵀ needs only the means: one rank
+     * update per group (O(G p²)). W cannot join the first pass: centering
+     * on running means rounds differently from `wgss`. Equal to `bgss` and
+     * `wgss` up to float rounding.
+     */
+    Scatter scatter(Eigen::Ref<types::FeatureMatrix const> const& x) const;
+
+    /**
+     * @brief `scatter(x)` with row `i` counted `weights(i)` times.
+     *
+     * Equal, up to rounding, to `scatter` of the matrix with every row
+     * repeated that many times; blocks are still read in place.
+     */
+    Scatter scatter(Eigen::Ref<types::FeatureMatrix const> const& x, types::WeightVector const& weights) const;
+
+    /**
+     * @brief `scatter(x(:, cols))` from block moments held in @p cache.
+     *
+     * Each block's mean and centered cross-product come from the cache
+     * (computed from rows only the first time a column pair is asked for)
+     * and are merged by `merge_blocks`. The result is q × q in
+     * the order of @p cols. Only valid while the partition's blocks are
+     * row ranges of the matrix the cache was built on.
+     */
+    Scatter scatter(ScatterCache& cache, std::vector<int> const& cols) const;
+
     /**
        * @brief Create a partition containing only the given groups.
        *
@@ -173,7 +243,7 @@ namespace ppforest2::stats {
        */
     GroupPartition subset(GroupSet const& groups) const;
 
-    using SplitSizes = std::map<types::GroupId, int>;
+    using SplitSizes = utils::FlatMap<types::GroupId, int, Allocator<std::pair<Group, int>>>;
 
     /**
        * @brief Split each group's block into left and right children.
@@ -218,22 +288,38 @@ namespace ppforest2::stats {
       int start;
       int end;
       int size;
-      std::optional<types::GroupId> next;
-      std::optional<types::GroupId> prev;
     };
 
-    using BlockMap = std::map<types::GroupId, Block>;
+    using BlockMap = utils::FlatMap<types::GroupId, Block, Allocator<std::pair<Group, Block>>>;
     BlockMap const Blocks;
 
+    /**
+     * @brief Merge step of the cached `scatter` overload.
+     *
+     *   W_g = Σ_b W_b + n_b (m_b − m_g)(m_b − m_g)ᵀ
+     *   B   = Σ_g n_g (m_g − m)(m_g − m)ᵀ
+     *
+     * accumulated in double and rounded to float once.
+     *
+     * @p block_moments(block, within, size) adds the block's centered
+     * cross-product to `within` (lower triangle) and returns its mean;
+     * weighted overloads also replace `size` (the block's row count) by
+     * the block's total weight.
+     */
+    template<typename BlockMoments> Scatter merge_blocks(Eigen::Index p, BlockMoments&& block_moments) const;
+
     static BlockMap init_blocks(GroupVector const& y);
+    static GroupSet init_groups(BlockMap const& blocks);
+    static GroupSet init_groups(GroupMap const& supergroups);
     static GroupMap init_supergroups(GroupSet const& groups);
+    static GroupInvMap init_subgroups(GroupMap const& supergroups);
 
-    explicit GroupPartition(BlockMap const& Blocks);
+    explicit GroupPartition(BlockMap Blocks);
 
-    GroupPartition(BlockMap const& Blocks, GroupSet const& groups);
+    GroupPartition(BlockMap Blocks, GroupSet const& groups);
 
-    GroupPartition(BlockMap const& Blocks, GroupMap const& supergroups);
+    GroupPartition(BlockMap Blocks, GroupMap const& supergroups);
 
-    GroupPartition(BlockMap const& Blocks, GroupSet const& groups, GroupMap const& supergroups);
+    GroupPartition(BlockMap Blocks, GroupSet const& groups, GroupMap const& supergroups);
   };
 }
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include "stats/GroupPartition.hpp"
+#include "stats/Simulation.hpp"
 #include "utils/Types.hpp"
 
 #include "utils/Macros.hpp"
@@ -89,6 +90,43 @@ TEST(GroupPartition, Remap) {
   EXPECT_EQ_DATA(remapped.data(x), x);
 }
 
+TEST(GroupPartition, RowIndices) {
+  GroupPartition const y      = GroupPartition(VEC(GroupId, 1, 1, 2, 2, 2, 3, 3));
+  GroupPartition const subset = y.subset({1, 3});
+
+  EXPECT_EQ((GroupPartition::Rows{0, 1, 2, 3, 4, 5, 6}), y.row_indices());
+  EXPECT_EQ((GroupPartition::Rows{0, 1, 5, 6}), subset.row_indices());
+}
+
+TEST(GroupPartition, CompactMatchesNodeRows) {
+  FeatureMatrix x = MAT(Feature, rows(7), 1, 2, 2, 1, 4, 4, 2, 1, 9, 2, 6, 9, 7, 7, 7, 3, 3, 3, 3, 5, 5);
+
+  GroupPartition const y       = GroupPartition(VEC(GroupId, 1, 1, 2, 2, 2, 3, 3)).subset({1, 3});
+  GroupPartition const compact = y.compact();
+  FeatureMatrix const local    = x(y.row_indices(), Eigen::all);
+
+  EXPECT_EQ(y.groups, compact.groups);
+  EXPECT_EQ(0, compact.group_start(1));
+  EXPECT_EQ(1, compact.group_end(1));
+  EXPECT_EQ(2, compact.group_start(3));
+  EXPECT_EQ(3, compact.group_end(3));
+
+  EXPECT_EQ_DATA(compact.group(local, 3), y.group(x, 3));
+  EXPECT_EQ(y.bgss(x), compact.bgss(local));
+  EXPECT_EQ(y.wgss(x), compact.wgss(local));
+}
+
+TEST(GroupPartition, CompactKeepsSupergroups) {
+  GroupPartition const y        = GroupPartition(VEC(GroupId, 0, 0, 1, 2, 2)).subset({0, 2});
+  GroupPartition const remapped = y.remap({{0, 1}, {2, 1}});
+
+  GroupPartition const compact = remapped.compact();
+
+  EXPECT_EQ(remapped.supergroups, compact.supergroups);
+  EXPECT_EQ(remapped.subgroups, compact.subgroups);
+  EXPECT_EQ(4, compact.total_size());
+}
+
 TEST(GroupPartition, BetweenGroupsSumOfSquaresSingleGroup) {
   FeatureMatrix x = MAT(Feature, rows(3), 1.0, 2.0, 6.0, 2.0, 3.0, 7.0, 3.0, 4.0, 8.0);
 
@@ -514,3 +552,77 @@ TEST(GroupPartitionSplit, InvalidLeftCountThrows) {
   EXPECT_THROW(y.split({{0, 3}}), std::exception);
   EXPECT_THROW(y.split({{0, -1}}), std::exception);
 }
+
+TEST(GroupPartitionScatter, MatchesBgssWgss) {
+  FeatureMatrix x = MAT(Feature, rows(6), 1, 2, 2, 1, 4, 4, 2, 1, 1, 2, 6, 6, 3, 3, 3, 3, 5, 5);
+
+  GroupPartition const y(VEC(GroupId, 1, 1, 2, 2, 3, 3));
+  auto const [B, W] = y.scatter(x);
+
+  EXPECT_EQ_DATA(B, y.bgss(x));
+  EXPECT_EQ_DATA(W, y.wgss(x));
+  EXPECT_EQ(B, B.transpose());
+  EXPECT_EQ(W, W.transpose());
+}
+
+TEST(GroupPartitionScatter, BlocksLongerThanAChunkMatchBgssWgss) {
+  RNG rng(0);
+  auto const data = simulate(1200, 4, 2, rng);
+
+  GroupPartition const y(data.y);
+  auto const [B, W] = y.scatter(data.x);
+
+  EXPECT_TRUE(B.isApprox(y.bgss(data.x), 1e-4F)) << B << "\n\n" << y.bgss(data.x);
+  EXPECT_TRUE(W.isApprox(y.wgss(data.x), 1e-4F)) << W << "\n\n" << y.wgss(data.x);
+}
+
+TEST(GroupPartitionScatter, SupergroupSpanningBlocksMatchesTwoPass) {
+  FeatureMatrix x = MAT(Feature, rows(7), 1, 2, 3, 1, 4, 4, 2, 8, 1, 9, 6, 2, 3, 3, 5, 3, 5, 1, 7, 0, 2);
+
+  GroupPartition const y        = GroupPartition(VEC(GroupId, 0, 0, 1, 1, 1, 2, 2));
+  GroupPartition const remapped = y.remap({{0, 0}, {1, 1}, {2, 0}});
+
+  auto const [B, W] = remapped.scatter(x);
+
+  // Reference: the textbook two-pass formulas over gathered group rows.
+  FeatureVector const global_mean = x.colwise().mean().transpose();
+  FeatureMatrix expected_B        = FeatureMatrix::Zero(3, 3);
+  FeatureMatrix expected_W        = FeatureMatrix::Zero(3, 3);
+
+  for (GroupId g : {0, 1}) {
+    FeatureMatrix const rows       = remapped.group(x, g);
+    FeatureVector const group_mean = rows.colwise().mean().transpose();
+    FeatureMatrix const centered   = rows.rowwise() - group_mean.transpose();
+
+    expected_B += rows.rows() * (group_mean - global_mean) * (group_mean - global_mean).transpose();
+    expected_W += centered.transpose() * centered;
+  }
+
+  EXPECT_TRUE(B.isApprox(expected_B, 1e-5F)) << B << "\n\n" << expected_B;
+  EXPECT_TRUE(W.isApprox(expected_W, 1e-5F)) << W << "\n\n" << expected_W;
+}
+
+TEST(GroupPartitionScatter, WeightedMatchesExpandedRows) {
+  FeatureMatrix const x      = MAT(Feature, rows(6), 1, 2, 2, 1, 4, 4, 2, 1, 1, 2, 6, 6, 3, 3, 3, 3, 5, 5);
+  WeightVector const weights = VEC(int, 2, 1, 3, 1, 1, 2);
+
+  // Row i repeated weights(i) times: what an unweighted bootstrap would copy.
+  std::vector<int> repeated;
+  for (int i = 0; i < x.rows(); ++i) {
+    repeated.insert(repeated.end(), static_cast<std::size_t>(weights(i)), i);
+  }
+
+  FeatureMatrix const expanded_x = x(repeated, Eigen::all);
+
+  GroupPartition const y(VEC(GroupId, 1, 1, 2, 2, 3, 3));
+  GroupPartition const expanded_y(VEC(GroupId, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3));
+
+  EXPECT_EQ(3, y.group_weight(1, weights));
+  EXPECT_EQ(10, y.total_weight(weights));
+
+  auto const [B, W]                   = y.scatter(x, weights);
+  auto const [expected_B, expected_W] = expanded_y.scatter(expanded_x);
+
+  EXPECT_TRUE(B.isApprox(expected_B, 1e-5F)) << B << "\n\n" << expected_B;
+  EXPECT_TRUE(W.isApprox(expected_W, 1e-5F)) << W << "\n\n" << expected_W;
+}
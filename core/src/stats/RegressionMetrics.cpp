@@ -76,4 +76,35 @@ namespace ppforest2::stats {
       : mse(stats::mse(predictions, actual))
       , mae(stats::mae(predictions, actual))
       , r_squared(stats::r_squared(predictions, actual)) {}
+
+  void RegressionMetricsAccumulator::add(OutcomeVector const& predictions, OutcomeVector const& actual) {
+    if (predictions.size() != actual.size()) {
+      throw std::invalid_argument("Predictions and actual vectors must have the same size.");
+    }
+
+    for (int i = 0; i < predictions.size(); ++i) {
+      double const y    = static_cast<double>(actual(i));
+      double const diff = static_cast<double>(predictions(i)) - y;
+
+      sum_squared += diff * diff;
+      sum_absolute += std::abs(diff);
+
+      ++n;
+      double const delta = y - mean_actual;
+      mean_actual += delta / static_cast<double>(n);
+      ss_total += delta * (y - mean_actual);
+    }
+  }
+
+  RegressionMetrics RegressionMetricsAccumulator::metrics() const {
+    if (n == 0) {
+      throw std::invalid_argument("Vectors must not be empty.");
+    }
+
+    RegressionMetrics result;
+    result.mse       = sum_squared / static_cast<double>(n);
+    result.mae       = sum_absolute / static_cast<double>(n);
+    result.r_squared = ss_total == 0.0 ? 0.0 : 1.0 - sum_squared / ss_total;
+    return result;
+  }
 }
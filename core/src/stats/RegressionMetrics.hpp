@@ -46,4 +46,33 @@ namespace ppforest2::stats {
    * @brief Compute R-squared between predictions and actual values.
    */
   double r_squared(types::OutcomeVector const& predictions, types::OutcomeVector const& actual);
+
+  /**
+   * @brief Builds `RegressionMetrics` from predictions that arrive in chunks.
+   *
+   * Keeps running sums of squared and absolute errors, plus a running mean
+   * and sum of squared deviations of the response (Welford), so R² needs no
+   * second pass. Results match `RegressionMetrics` on the concatenated
+   * vectors up to floating-point summation order.
+   */
+  struct RegressionMetricsAccumulator {
+    /**
+     * @brief Add one chunk of predictions and actual values.
+     * @throws std::invalid_argument If sizes differ.
+     */
+    void add(types::OutcomeVector const& predictions, types::OutcomeVector const& actual);
+
+    /**
+     * @brief Metrics over every chunk added so far.
+     * @throws std::invalid_argument If no rows were added.
+     */
+    RegressionMetrics metrics() const;
+
+  private:
+    long long n         = 0;
+    double sum_squared  = 0.0;
+    double sum_absolute = 0.0;
+    double mean_actual  = 0.0;
+    double ss_total     = 0.0;
+  };
 }
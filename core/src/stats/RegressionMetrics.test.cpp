@@ -119,3 +119,31 @@ TEST_F(RegressionMetricsTest, NegativeValues) {
   // (0.5^2 + 0.5^2 + 0.5^2) / 3 = 0.75/3 = 0.25
   EXPECT_NEAR(result, 0.25, 1e-6);
 }
+
+TEST_F(RegressionMetricsTest, AccumulatorMatchesFullVectors) {
+  RegressionMetricsAccumulator acc;
+  acc.add(predictions.head(2), actual.head(2));
+  acc.add(predictions.tail(3), actual.tail(3));
+
+  RegressionMetrics const expected(predictions, actual);
+  RegressionMetrics const result = acc.metrics();
+
+  EXPECT_NEAR(expected.mse, result.mse, 1e-9);
+  EXPECT_NEAR(expected.mae, result.mae, 1e-9);
+  EXPECT_NEAR(expected.r_squared, result.r_squared, 1e-9);
+}
+
+TEST_F(RegressionMetricsTest, AccumulatorConstantActualValues) {
+  OutcomeVector constant_actual(3);
+  constant_actual << 5.0F, 5.0F, 5.0F;
+
+  RegressionMetricsAccumulator acc;
+  acc.add(predictions.head(3), constant_actual);
+
+  EXPECT_NEAR(acc.metrics().r_squared, 0.0, 1e-6);
+}
+
+TEST_F(RegressionMetricsTest, AccumulatorThrowsWhenEmpty) {
+  RegressionMetricsAccumulator acc;
+  EXPECT_THROW(acc.metrics(), std::invalid_argument);
+}
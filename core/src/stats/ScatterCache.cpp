@@ -0,0 +1,176 @@
+#include "stats/ScatterCache.hpp"
+
+#include "utils/Invariant.hpp"
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+using namespace ppforest2::types;
+
+namespace ppforest2::stats {
+  bool ScatterCache::fits(std::size_t blocks, Eigen::Index cols) {
+    auto const p = static_cast<std::size_t>(cols);
+    return p == 0 || blocks <= max_entries / (p * p);
+  }
+
+  ScatterCache::ScatterCache(FeatureMatrix const& x, WeightVector const* weights, std::vector<int> const* source_rows)
+      : x(x)
+      , weights(weights)
+      , source_rows(source_rows) {}
+
+  ScatterCache::Entry& ScatterCache::entry(int start, int size) {
+    std::lock_guard<std::mutex> const lock(mutex);
+    return blocks.try_emplace({start, size}).first->second;
+  }
+
+  double ScatterCache::moments(
+      int start, int size, std::vector<int> const& cols, Eigen::VectorXd& mean, Eigen::MatrixXd& cross
+  ) {
+    Eigen::Index const n_rows = source_rows != nullptr ? static_cast<Eigen::Index>(source_rows->size()) : x.rows();
+    invariant(start >= 0 && size > 0 && start + size <= n_rows, "ScatterCache::moments: block out of bounds");
+
+    Eigen::Index const p       = x.cols();
+    Eigen::Index const n_tiles = (p + tile_width - 1) / tile_width;
+
+    auto const tile_size = [&](Eigen::Index t) { return std::min(tile_width, p - t * tile_width); };
+
+    // Tiles the request touches, ascending.
+    std::vector<Eigen::Index> tiles;
+
+    for (int const c : cols) {
+      tiles.push_back(c / tile_width);
+    }
+
+    std::sort(tiles.begin(), tiles.end());
+    tiles.erase(std::unique(tiles.begin(), tiles.end()), tiles.end());
+
+    Entry& block = entry(start, size);
+
+    // Snapshot of what is missing, taken under the entry's lock. A tile's
+    // mean is published with the first pair that involves it, so a missing
+    // mean always comes with a missing diagonal pair.
+    std::vector<std::pair<Eigen::Index, Eigen::Index>> missing;
+    Eigen::Matrix<bool, Eigen::Dynamic, 1> mean_known;
+    Eigen::VectorXd means;
+    double weight;
+
+    {
+      std::lock_guard<std::mutex> const lock(block.mutex);
+
+      if (!block.initialized) {
+        block.weight      = weights != nullptr ? weights->segment(start, size).sum() : size;
+        block.mean        = Eigen::VectorXd::Zero(p);
+        block.cross       = Eigen::MatrixXd::Zero(p, p);
+        block.mean_known  = Eigen::Matrix<bool, Eigen::Dynamic, 1>::Constant(n_tiles, false);
+        block.cross_known = Eigen::Matrix<bool, Eigen::Dynamic, Eigen::Dynamic>::Constant(n_tiles, n_tiles, false);
+        block.initialized = true;
+      }
+
+      for (std::size_t j = 0; j < tiles.size(); ++j) {
+        for (std::size_t i = j; i < tiles.size(); ++i) {
+          if (!block.cross_known(tiles[i], tiles[j])) {
+            missing.emplace_back(tiles[i], tiles[j]);
+          }
+        }
+      }
+
+      if (missing.empty()) {
+        mean  = block.mean(cols);
+        cross = block.cross(cols, cols);
+        return block.weight;
+      }
+
+      mean_known = block.mean_known;
+      means      = block.mean;
+      weight     = block.weight;
+    }
+
+    // Everything below reads only `x` and local state, so other tasks keep
+    // using the cache meanwhile. A mapped block's rows are gathered tile by
+    // tile into block-local working sets.
+    std::vector<int> block_rows;
+
+    if (source_rows != nullptr) {
+      auto const first = source_rows->begin() + start;
+      block_rows.assign(first, first + size);
+    }
+
+    Eigen::VectorXd w;
+    Eigen::VectorXd root_w;
+
+    if (weights != nullptr) {
+      w      = weights->segment(start, size).cast<double>();
+      root_w = w.array().sqrt();
+    }
+
+    // Centered (and, when weighted, sqrt-weighted) rows of each tile in a
+    // missing pair. Every tile is centered whole, so its product with
+    // another tile has the same shape, hence the same rounding, whichever
+    // columns were requested and whichever node asked first.
+    std::map<Eigen::Index, Eigen::MatrixXd> centered;
+
+    for (auto const& [a, b] : missing) {
+      for (Eigen::Index const t : {a, b}) {
+        if (centered.count(t) != 0) {
+          continue;
+        }
+
+        auto const columns    = Eigen::seqN(t * tile_width, tile_size(t));
+        Eigen::MatrixXd& tile = centered[t];
+
+        if (source_rows != nullptr) {
+          tile = x(block_rows, columns).cast<double>();
+        } else {
+          tile = x.middleRows(start, size)(Eigen::all, columns).cast<double>();
+        }
+
+        if (!mean_known(t)) {
+          for (Eigen::Index k = 0; k < tile.cols(); ++k) {
+            means(t * tile_width + k) = w.size() > 0 ? tile.col(k).dot(w) / weight : tile.col(k).mean();
+          }
+        }
+
+        tile.rowwise() -= means.segment(t * tile_width, tile.cols()).transpose();
+
+        if (w.size() > 0) {
+          tile.array().colwise() *= root_w.array();
+        }
+      }
+    }
+
+    std::vector<Eigen::MatrixXd> products;
+    products.reserve(missing.size());
+
+    for (auto const& [a, b] : missing) {
+      products.emplace_back(centered[a].transpose() * centered[b]);
+    }
+
+    // Publish. A pair another task published meanwhile holds the same
+    // values, so it is left as is.
+    std::lock_guard<std::mutex> const lock(block.mutex);
+
+    for (std::size_t k = 0; k < missing.size(); ++k) {
+      auto const [a, b] = missing[k];
+
+      for (Eigen::Index const t : {a, b}) {
+        if (!block.mean_known(t)) {
+          block.mean.segment(t * tile_width, tile_size(t)) = means.segment(t * tile_width, tile_size(t));
+          block.mean_known(t)                             = true;
+        }
+      }
+
+      if (!block.cross_known(a, b)) {
+        block.cross.block(a * tile_width, b * tile_width, tile_size(a), tile_size(b)) = products[k];
+        block.cross.block(b * tile_width, a * tile_width, tile_size(b), tile_size(a)) = products[k].transpose();
+        block.cross_known(a, b)                                                       = true;
+        block.cross_known(b, a)                                                       = true;
+      }
+    }
+
+    mean  = block.mean(cols);
+    cross = block.cross(cols, cols);
+
+    return block.weight;
+  }
+}
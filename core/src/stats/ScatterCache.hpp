@@ -0,0 +1,102 @@
+#pragma once
+
+#include "utils/Types.hpp"
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include <Eigen/Dense>
+
+namespace ppforest2::stats {
+  /**
+   * @brief Per-block moments of one feature matrix, computed on demand and reused.
+   *
+   * Under label grouping a node's partition is a subset (or a merge) of
+   * the root's label blocks, over the same rows of the same matrix, so a
+   * block's mean and centered cross-products never change below the root.
+   * The cache keeps them per block (keyed by row range) and per tile of
+   * `tile_width` columns: a node asks for the moments over its selected
+   * columns, and only tile pairs no earlier node touched are computed, each
+   * as one product of two centered row blocks. With `vars::all` everything
+   * is computed at the root; with a random subset each tile pair is read
+   * from rows at most once per block and tree.
+   *
+   * `GroupPartition::scatter(ScatterCache&, cols)` merges these block
+   * moments into B and W in double, so PDA sees the statistics
+   * `scatter(x)` computes from rows up to rounding.
+   *
+   * The matrix must not change while the cache is in use; strategies that
+   * move rows (`ByCutpoint`) must not share one.
+   *
+   * With row weights (count-weighted bootstrap) every moment counts row
+   * `i` `weights(i)` times. With a row map, row `i` of a block is row
+   * `source_rows[i]` of the matrix, and a block's rows are gathered only
+   * when one of its moments is missing.
+   *
+   * One cache serves a whole tree, including subtrees grown as parallel
+   * tasks. `moments` locks only to look up an entry and to publish into
+   * it; missing tiles are computed outside both locks, so two tasks may
+   * compute the same tile pair, and publish the same values.
+   */
+  class ScatterCache {
+  public:
+    /** @brief Upper bound on cached cross-product entries (blocks × p × p), about 16 MB of doubles. */
+    static constexpr std::size_t max_entries = std::size_t{1} << 21;
+
+    /** @brief Columns per tile: the unit in which cross-products are computed and cached. */
+    static constexpr Eigen::Index tile_width = 4;
+
+    /** @brief Whether @p blocks blocks over @p cols columns stay within `max_entries`. */
+    static bool fits(std::size_t blocks, Eigen::Index cols);
+
+    /**
+     * @brief Cache over @p x, counting row `i` `(*weights)(i)` times when @p weights is set.
+     *
+     * @param source_rows  Row of @p x each block row reads, or null for `x`'s own rows.
+     */
+    explicit ScatterCache(
+        types::FeatureMatrix const& x,
+        types::WeightVector const* weights  = nullptr,
+        std::vector<int> const* source_rows = nullptr
+    );
+
+    /**
+     * @brief Mean (q) and centered cross-product (q × q) of rows `[start, start + size)` over @p cols.
+     *
+     * Values are in double, as `GroupPartition::scatter` accumulates them.
+     * Each mean is one column mean and each cross-product entry comes from
+     * the product of its two whole tiles, a product of the same shape
+     * whichever columns were asked for. So a value does not depend on the
+     * requests that came before it: caches over the same matrix agree bit
+     * for bit whatever order their nodes were visited in.
+     *
+     * @return The block's total weight (its row count when unweighted).
+     */
+    double moments(int start, int size, std::vector<int> const& cols, Eigen::VectorXd& mean, Eigen::MatrixXd& cross);
+
+  private:
+    struct Entry {
+      /** @brief Guards the fields below; held only to read or publish, never while computing. */
+      std::mutex mutex;
+      bool initialized = false;
+      double weight    = 0;
+      Eigen::VectorXd mean;
+      Eigen::MatrixXd cross;
+      /** @brief Which tiles' means / which tile pairs' cross-products have been computed. */
+      Eigen::Matrix<bool, Eigen::Dynamic, 1> mean_known;
+      Eigen::Matrix<bool, Eigen::Dynamic, Eigen::Dynamic> cross_known;
+    };
+
+    /** @brief Entry of block `[start, start + size)`, created (empty) on first use. */
+    Entry& entry(int start, int size);
+
+    types::FeatureMatrix const& x;
+    types::WeightVector const* weights;
+    std::vector<int> const* source_rows;
+    /** @brief Guards `blocks` itself; entries are stable in the map and guard their own contents. */
+    std::mutex mutex;
+    std::map<std::pair<int, int>, Entry> blocks;
+  };
+}
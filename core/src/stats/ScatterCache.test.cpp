@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+
+#include "stats/GroupPartition.hpp"
+#include "stats/ScatterCache.hpp"
+#include "stats/Simulation.hpp"
+#include "utils/Types.hpp"
+
+#include <vector>
+
+using namespace ppforest2;
+using namespace ppforest2::stats;
+using namespace ppforest2::types;
+
+namespace {
+  void expect_same_scatter(GroupPartition::Scatter const& expected, GroupPartition::Scatter const& actual) {
+    EXPECT_TRUE(actual.bgss.isApprox(expected.bgss, 1e-5F)) << actual.bgss << "\n\n" << expected.bgss;
+    EXPECT_TRUE(actual.wgss.isApprox(expected.wgss, 1e-5F)) << actual.wgss << "\n\n" << expected.wgss;
+  }
+}
+
+TEST(ScatterCache, AllColumnsMatchesScatter) {
+  RNG rng(0);
+  auto const data = simulate(60, 4, 3, rng);
+
+  GroupPartition const y(data.y);
+  ScatterCache cache(data.x);
+
+  expect_same_scatter(y.scatter(data.x), y.scatter(cache, {0, 1, 2, 3}));
+}
+
+TEST(ScatterCache, ColumnSubsetMatchesGatheredScatter) {
+  RNG rng(1);
+  auto const data = simulate(60, 5, 3, rng);
+
+  GroupPartition const y(data.y);
+  ScatterCache cache(data.x);
+
+  std::vector<int> const cols = {3, 0, 4};
+  FeatureMatrix const x_cols  = data.x(Eigen::all, cols);
+
+  expect_same_scatter(y.scatter(x_cols), y.scatter(cache, cols));
+}
+
+TEST(ScatterCache, SubsetAndRemapMatchNodeLocalScatter) {
+  RNG rng(2);
+  auto const data = simulate(80, 4, 4, rng);
+
+  GroupPartition const y(data.y);
+  ScatterCache cache(data.x);
+
+  // Warm the cache with an overlapping column set, as a parent node would.
+  y.scatter(cache, {0, 1});
+
+  GroupPartition const child  = y.subset({1, 3});
+  GroupPartition const binary = y.remap({{0, 0}, {1, 1}, {2, 0}, {3, 1}});
+
+  std::vector<int> const cols = {1, 2, 3};
+
+  for (GroupPartition const* part : {&child, &binary}) {
+    FeatureMatrix const reduced_x = data.x(part->row_indices(), cols);
+    expect_same_scatter(part->compact().scatter(reduced_x), part->scatter(cache, cols));
+  }
+}
+
+TEST(ScatterCache, ReusesKnownPairs) {
+  RNG rng(3);
+  auto data = simulate(40, 6, 2, rng);
+
+  GroupPartition const y(data.y);
+  ScatterCache cache(data.x);
+
+  auto const first = y.scatter(cache, {0, 1});
+
+  // Pairs already computed are not read from rows again.
+  data.x.col(0).setZero();
+  data.x.col(1).setZero();
+
+  auto const again = y.scatter(cache, {0, 1});
+  ASSERT_EQ(first.bgss, again.bgss);
+  ASSERT_EQ(first.wgss, again.wgss);
+
+  // A column in a new tile is read from the current rows.
+  ASSERT_LE(ScatterCache::tile_width, 4);
+
+  auto const wider = y.scatter(cache, {0, 1, 4});
+  ASSERT_EQ(first.wgss(0, 0), wider.wgss(0, 0));
+  ASSERT_NEAR(0, wider.wgss(0, 2), 1e-4);
+}
+
+TEST(ScatterCache, MomentsDoNotDependOnRequestHistory) {
+  RNG rng(5);
+  auto const data = simulate(70, 6, 2, rng);
+
+  std::vector<int> const all = {0, 1, 2, 3, 4, 5};
+
+  // One cache computes every pair in a single request, the other reaches
+  // the same pairs through overlapping subsets in another column order.
+  ScatterCache at_once(data.x);
+  ScatterCache piecemeal(data.x);
+
+  Eigen::VectorXd expected_mean;
+  Eigen::VectorXd actual_mean;
+  Eigen::MatrixXd expected_cross;
+  Eigen::MatrixXd actual_cross;
+
+  for (auto const& cols : std::vector<std::vector<int>>{{4, 1}, {1, 5, 2}, {3, 0, 4}, {2, 0}, {5, 3, 1, 0}}) {
+    piecemeal.moments(0, 35, cols, actual_mean, actual_cross);
+  }
+
+  at_once.moments(0, 35, all, expected_mean, expected_cross);
+  piecemeal.moments(0, 35, all, actual_mean, actual_cross);
+
+  ASSERT_EQ(expected_mean, actual_mean);
+  ASSERT_EQ(expected_cross, actual_cross);
+}
+
+TEST(ScatterCache, Fits) {
+  ASSERT_TRUE(ScatterCache::fits(3, 10));
+  ASSERT_TRUE(ScatterCache::fits(1000, 0));
+  ASSERT_FALSE(ScatterCache::fits(100, 1000));
+}
+
+TEST(ScatterCache, WeightedMatchesExpandedRows) {
+  RNG rng(4);
+  auto const data = simulate(45, 4, 3, rng);
+
+  WeightVector weights(data.x.rows());
+  std::vector<int> repeated;
+
+  for (int i = 0; i < data.x.rows(); ++i) {
+    weights(i) = 1 + i % 3;
+    repeated.insert(repeated.end(), static_cast<std::size_t>(weights(i)), i);
+  }
+
+  FeatureMatrix const expanded_x    = data.x(repeated, Eigen::all);
+  OutcomeVector const expanded_y    = data.y(repeated);
+  std::vector<int> const cols       = {2, 0, 3};
+  FeatureMatrix const expanded_cols = expanded_x(Eigen::all, cols);
+
+  GroupPartition const y(data.y);
+  ScatterCache cache(data.x, &weights);
+
+  expect_same_scatter(GroupPartition(expanded_y).scatter(expanded_cols), y.scatter(cache, cols));
+}
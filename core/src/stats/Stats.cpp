@@ -9,11 +9,16 @@
 using namespace ppforest2::types;
 
 namespace ppforest2::stats {
-  void sort(FeatureMatrix& x, GroupIdVector& y) {
-    std::vector<int> indices(x.rows());
+  std::vector<int> sort_order(GroupIdVector const& y) {
+    std::vector<int> indices(static_cast<std::size_t>(y.size()));
     std::iota(indices.begin(), indices.end(), 0);
 
     std::stable_sort(indices.begin(), indices.end(), [&y](int idx1, int idx2) { return y(idx1) < y(idx2); });
+    return indices;
+  }
+
+  void sort(FeatureMatrix& x, GroupIdVector& y) {
+    std::vector<int> const indices = sort_order(y);
 
     x = x(indices, Eigen::all).eval();
     y = y(indices, Eigen::all).eval();
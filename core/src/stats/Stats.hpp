@@ -5,6 +5,7 @@
 #include <cmath>
 #include <set>
 #include <stdexcept>
+#include <vector>
 #include <pcg_random.hpp>
 
 /**
@@ -27,6 +28,13 @@ namespace ppforest2::stats {
    */
   void sort(types::FeatureMatrix& x, types::GroupIdVector& y);
 
+  /**
+   * @brief Row order that stably sorts @p y (the permutation `sort` applies).
+   *
+   * For callers that reorder a `FeatureView` instead of copying the rows.
+   */
+  std::vector<int> sort_order(types::GroupIdVector const& y);
+
   /**
    * @brief Unique group labels in a response vector.
    *
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+namespace ppforest2::utils {
+  /**
+   * @brief Read-only contiguous array that owns its values or borrows them.
+   *
+   * An owning array keeps a `std::vector`, exactly like the member it
+   * replaces. A borrowed array (`borrow`) is a pointer and a length into
+   * memory someone else keeps alive — e.g. a memory-mapped model file —
+   * so loading does not copy the values at all. Whoever borrows is
+   * responsible for the lifetime: `CompiledTree` holds the owner next to
+   * its arrays.
+   *
+   * Copies of an owning array own a copy of the values; copies of a
+   * borrowed array borrow the same memory.
+   */
+  template<typename T> class ConstArray {
+  public:
+    using value_type     = T;
+    using size_type      = std::size_t;
+    using const_iterator = T const*;
+    using iterator       = const_iterator;
+
+    ConstArray() = default;
+
+    ConstArray(std::vector<T> values) // NOLINT(google-explicit-constructor)
+        : owned(std::move(values))
+        , first(owned.data())
+        , count(owned.size()) {}
+
+    ConstArray(std::initializer_list<T> values)
+        : ConstArray(std::vector<T>(values)) {}
+
+    ConstArray(ConstArray const& other)
+        : owned(other.owned)
+        , first(other.borrowed() ? other.first : owned.data())
+        , count(other.count) {}
+
+    ConstArray(ConstArray&& other) noexcept
+        : owned(std::move(other.owned))
+        , first(other.first)
+        , count(other.count) {
+      other.first = nullptr;
+      other.count = 0;
+    }
+
+    ConstArray& operator=(ConstArray other) noexcept {
+      swap(other);
+      return *this;
+    }
+
+    /** @brief View @p n values at @p values without copying them. */
+    static ConstArray borrow(T const* values, size_type n) {
+      ConstArray array;
+      array.first = values;
+      array.count = n;
+      return array;
+    }
+
+    /** @brief Whether the values live outside this array. */
+    bool borrowed() const { return count > 0 && first != owned.data(); }
+
+    T const* data() const { return first; }
+    size_type size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    const_iterator begin() const { return first; }
+    const_iterator end() const { return first + count; }
+
+    T const& operator[](size_type i) const { return first[i]; }
+    T const& front() const { return first[0]; }
+    T const& back() const { return first[count - 1]; }
+
+    void swap(ConstArray& other) noexcept {
+      // Swapping vectors keeps their buffers, so owning pointers stay valid.
+      owned.swap(other.owned);
+      std::swap(first, other.first);
+      std::swap(count, other.count);
+    }
+
+    friend bool operator==(ConstArray const& a, ConstArray const& b) {
+      return std::equal(a.begin(), a.end(), b.begin(), b.end());
+    }
+
+    friend bool operator==(ConstArray const& a, std::vector<T> const& b) {
+      return std::equal(a.begin(), a.end(), b.begin(), b.end());
+    }
+
+    friend bool operator==(std::vector<T> const& a, ConstArray const& b) { return b == a; }
+
+    friend bool operator!=(ConstArray const& a, ConstArray const& b) { return !(a == b); }
+
+  private:
+    std::vector<T> owned;
+    T const* first  = nullptr;
+    size_type count = 0;
+  };
+}
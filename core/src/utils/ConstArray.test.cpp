@@ -0,0 +1,39 @@
+#include <gtest/gtest.h>
+
+#include "utils/ConstArray.hpp"
+
+#include <vector>
+
+using namespace ppforest2::utils;
+
+TEST(ConstArray, OwnsMovedVector) {
+  std::vector<int> values = {1, 2, 3};
+  int const* const data   = values.data();
+
+  ConstArray<int> const array(std::move(values));
+
+  ASSERT_EQ(data, array.data());
+  ASSERT_FALSE(array.borrowed());
+  ASSERT_EQ((std::vector<int>{1, 2, 3}), array);
+}
+
+TEST(ConstArray, CopiesOfOwnedArraysOwnTheirValues) {
+  ConstArray<int> const array = {4, 5};
+  ConstArray<int> const copy  = array;
+
+  ASSERT_NE(array.data(), copy.data());
+  ASSERT_FALSE(copy.borrowed());
+  ASSERT_EQ(array, copy);
+}
+
+TEST(ConstArray, BorrowedArraysShareMemory) {
+  int const values[] = {7, 8, 9};
+
+  ConstArray<int> const array = ConstArray<int>::borrow(values, 3);
+  ConstArray<int> const copy  = array;
+
+  ASSERT_TRUE(array.borrowed());
+  ASSERT_EQ(values, array.data());
+  ASSERT_EQ(values, copy.data());
+  ASSERT_EQ(9, copy.back());
+}
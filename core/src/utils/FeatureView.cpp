@@ -0,0 +1,82 @@
+#include "utils/FeatureView.hpp"
+
+#include "utils/Invariant.hpp"
+
+namespace ppforest2::types {
+  FeatureView::FeatureView(FeatureMatrix const& x)
+      : FeatureView(x.data(), x.rows(), x.cols()) {
+    source = &x;
+  }
+
+  FeatureView::FeatureView(Feature const* data, Eigen::Index rows, Eigen::Index cols)
+      : floats(data)
+      , n(rows)
+      , p(cols)
+      , n_source(rows) {}
+
+  FeatureView::FeatureView(double const* data, Eigen::Index rows, Eigen::Index cols)
+      : doubles(data)
+      , n(rows)
+      , p(cols)
+      , n_source(rows) {}
+
+  FeatureView FeatureView::reordered(std::vector<int> order) const {
+    // Compose with an existing order so the stored indices always point
+    // into the underlying data.
+    for (int& i : order) {
+      invariant(i >= 0 && i < n, "FeatureView::reordered: row index out of range");
+      i = static_cast<int>(source_row(i));
+    }
+
+    FeatureView view = *this;
+    view.n           = static_cast<Eigen::Index>(order.size());
+    view.order       = std::make_shared<std::vector<int> const>(std::move(order));
+    return view;
+  }
+
+  FeatureMatrix FeatureView::gather(std::vector<int> const& indices) const {
+    auto const m = static_cast<Eigen::Index>(indices.size());
+    FeatureMatrix result(m, p);
+
+    visit([&](auto const& data) {
+      for (Eigen::Index j = 0; j < p; ++j) {
+        for (Eigen::Index i = 0; i < m; ++i) {
+          result(i, j) = static_cast<Feature>(data(source_row(indices[static_cast<std::size_t>(i)]), j));
+        }
+      }
+    });
+
+    return result;
+  }
+
+  void FeatureView::transpose_rows(Eigen::Index start, Eigen::Index m, FeatureMatrix& block) const {
+    block.resize(p, m);
+
+    visit([&](auto const& data) {
+      if (!order) {
+        block = data.middleRows(start, m).transpose().template cast<Feature>();
+        return;
+      }
+
+      for (Eigen::Index i = 0; i < m; ++i) {
+        block.col(i) = data.row(source_row(start + i)).transpose().template cast<Feature>();
+      }
+    });
+  }
+
+  FeatureMatrix FeatureView::to_matrix() const {
+    if (order) {
+      std::vector<int> all(static_cast<std::size_t>(n));
+
+      for (Eigen::Index i = 0; i < n; ++i) {
+        all[static_cast<std::size_t>(i)] = static_cast<int>(i);
+      }
+
+      return gather(all);
+    }
+
+    FeatureMatrix result;
+    visit([&](auto const& data) { result = data.template cast<Feature>(); });
+    return result;
+  }
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "utils/Types.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace ppforest2::types {
+  /**
+   * @brief Read-only view of a caller-owned, column-major n × p feature matrix.
+   *
+   * Forest training and batch prediction only read feature rows in
+   * pieces: each bootstrap bag gathers its sampled rows, and
+   * `CompiledForest` transposes `CompiledTree::block_rows` rows at a time.
+   * A view lets callers hand over their own memory, in `float` or in
+   * `double` (as R stores it), and have each piece converted to `Feature`
+   * as it is read. A large double input therefore never needs a full
+   * float copy next to it.
+   *
+   * A view can also present its rows in another order without moving
+   * them (`reordered`), which is how the bindings sort training rows by
+   * label.
+   *
+   * Converts implicitly from `FeatureMatrix`, so existing callers keep
+   * working. The view does not own the data; it must outlive every use.
+   *
+   * @code
+   *   Eigen::MatrixXd const x = ...;
+   *   auto forest = Forest::train(spec, FeatureView(x.data(), x.rows(), x.cols()), y);
+   * @endcode
+   */
+  class FeatureView {
+  public:
+    FeatureView(FeatureMatrix const& x); // NOLINT(google-explicit-constructor)
+    FeatureView(Feature const* data, Eigen::Index rows, Eigen::Index cols);
+    FeatureView(double const* data, Eigen::Index rows, Eigen::Index cols);
+
+    Eigen::Index rows() const { return n; }
+    Eigen::Index cols() const { return p; }
+
+    /**
+     * @brief The same data with row `i` of the result being row `order[i]` of this view.
+     *
+     * Only the index vector is stored; @p order must be a permutation (or
+     * selection) of `[0, rows())`.
+     */
+    FeatureView reordered(std::vector<int> order) const;
+
+    /** @brief Rows @p indices (in that order) as a `Feature` matrix. */
+    FeatureMatrix gather(std::vector<int> const& indices) const;
+
+    /** @brief Rows `[start, start + m)`, transposed into @p block (p × m). */
+    void transpose_rows(Eigen::Index start, Eigen::Index m, FeatureMatrix& block) const;
+
+    /** @brief The whole view as an owned `Feature` matrix. */
+    FeatureMatrix to_matrix() const;
+
+    /**
+     * @brief The caller's matrix, when the view wraps a `FeatureMatrix` in its own order; null otherwise.
+     *
+     * Lets a reader that indexes rows itself use the caller's storage as is.
+     */
+    FeatureMatrix const* matrix() const { return order ? nullptr : source; }
+
+  private:
+    FeatureMatrix const* source = nullptr;
+    Feature const* floats       = nullptr;
+    double const* doubles       = nullptr;
+    Eigen::Index n              = 0;
+    Eigen::Index p              = 0;
+    /** @brief Row count of the underlying data (differs from `n` for a selection). */
+    Eigen::Index n_source = 0;
+    /** @brief Row order, or null for the data's own order. Shared so copies stay cheap. */
+    std::shared_ptr<std::vector<int> const> order;
+
+    Eigen::Index source_row(Eigen::Index i) const {
+      return order ? (*order)[static_cast<std::size_t>(i)] : i;
+    }
+
+    /** @brief Call @p f with an Eigen map over the underlying data in its stored precision. */
+    template<typename F> void visit(F&& f) const {
+      if (doubles != nullptr) {
+        f(Eigen::Map<Matrix<double> const>(doubles, n_source, p));
+      } else {
+        f(Eigen::Map<FeatureMatrix const>(floats, n_source, p));
+      }
+    }
+  };
+}
@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+
+#include "models/ClassificationForest.hpp"
+#include "models/CompiledForest.hpp"
+#include "models/Forest.hpp"
+#include "models/RegressionForest.hpp"
+#include "models/Tree.hpp"
+#include "models/TrainingSpec.hpp"
+#include "stats/Simulation.hpp"
+#include "stats/Stats.hpp"
+#include "utils/FeatureView.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+using namespace ppforest2;
+using namespace ppforest2::stats;
+using namespace ppforest2::types;
+
+namespace {
+  FeatureMatrix sample_matrix() {
+    FeatureMatrix x(4, 3);
+    x << 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12;
+    return x;
+  }
+}
+
+TEST(FeatureView, FloatViewMatchesMatrix) {
+  FeatureMatrix const x = sample_matrix();
+  FeatureView const view(x);
+
+  ASSERT_EQ(4, view.rows());
+  ASSERT_EQ(3, view.cols());
+  ASSERT_EQ(x, view.to_matrix());
+}
+
+TEST(FeatureView, DoubleViewConvertsOnRead) {
+  Matrix<double> const x = sample_matrix().cast<double>();
+  FeatureView const view(x.data(), x.rows(), x.cols());
+
+  ASSERT_EQ(sample_matrix(), view.to_matrix());
+
+  FeatureMatrix expected(2, 3);
+  expected << 10, 11, 12, 4, 5, 6;
+  ASSERT_EQ(expected, view.gather({3, 1}));
+}
+
+TEST(FeatureView, TransposeRows) {
+  Matrix<double> const x = sample_matrix().cast<double>();
+  FeatureView const view(x.data(), x.rows(), x.cols());
+
+  FeatureMatrix block;
+  view.transpose_rows(1, 2, block);
+
+  FeatureMatrix const expected = sample_matrix().middleRows(1, 2).transpose();
+  ASSERT_EQ(expected, block);
+}
+
+TEST(FeatureView, ReorderedComposes) {
+  FeatureMatrix const x = sample_matrix();
+  FeatureView const view(x);
+
+  FeatureView const reversed = view.reordered({3, 2, 1, 0});
+  FeatureView const twice    = reversed.reordered({3, 2, 1, 0});
+
+  ASSERT_EQ(x.colwise().reverse(), reversed.to_matrix());
+  ASSERT_EQ(x, twice.to_matrix());
+
+  FeatureMatrix block;
+  reversed.transpose_rows(0, 2, block);
+  ASSERT_EQ(x.colwise().reverse().topRows(2).transpose(), block);
+
+  FeatureView const selected = view.reordered({2, 2});
+  ASSERT_EQ(2, selected.rows());
+  ASSERT_EQ(x.row(2), selected.gather({1}));
+}
+
+TEST(FeatureView, ForestFromDoubleViewMatchesFloatMatrix) {
+  RNG rng(0);
+  auto data = simulate(90, 4, 3, rng);
+
+  auto const spec = TrainingSpec::builder(Mode::Classification).size(6).threads(1).vars(vars::uniform(2)).build();
+
+  Matrix<double> const x_double = data.x.cast<double>();
+  FeatureView const view(x_double.data(), x_double.rows(), x_double.cols());
+
+  auto const expected = Forest::train(spec, data.x, data.y);
+  auto const actual   = Forest::train(spec, view, data.y);
+
+  ASSERT_EQ(*expected, *actual);
+
+  CompiledForest const compiled = CompiledForest::compile(*expected);
+  ASSERT_EQ(expected->predict(data.x), compiled.predict(view));
+  ASSERT_EQ(expected->predict(data.x, Proportions{}), compiled.predict(view, Proportions{}));
+}
+
+TEST(FeatureView, SortedViewMatchesSortedCopy) {
+  RNG rng(1);
+  auto data = simulate(60, 3, 2, rng);
+
+  // Interleave the groups so the rows need sorting.
+  std::vector<int> shuffle;
+  for (int i = 0; i < 30; ++i) {
+    shuffle.push_back(i);
+    shuffle.push_back(59 - i);
+  }
+
+  FeatureMatrix const x_shuffled = data.x(shuffle, Eigen::all);
+  GroupIdVector const y_shuffled = data.y(shuffle).cast<GroupId>();
+  FeatureView const view         = FeatureView(x_shuffled).reordered(sort_order(y_shuffled));
+
+  FeatureMatrix x = x_shuffled;
+  GroupIdVector y = y_shuffled;
+  sort(x, y);
+  OutcomeVector const y_sorted = y.cast<Outcome>();
+
+  auto const spec     = TrainingSpec::builder(Mode::Classification).size(4).threads(1).build();
+  auto const expected = Forest::train(spec, x, y_sorted);
+  auto const actual   = Forest::train(spec, view, y_sorted);
+
+  ASSERT_EQ(x, view.to_matrix());
+  ASSERT_EQ(*expected, *actual);
+}
+
+TEST(FeatureView, RegressionForestFromDoubleView) {
+  RNG rng(2);
+  auto data = simulate_regression(80, 3, rng);
+
+  auto const spec = TrainingSpec::builder(Mode::Regression)
+                        .grouping(grouping::by_cutpoint())
+                        .leaf(leaf::mean_response())
+                        .stop(stop::any({stop::min_size(5), stop::min_variance(0.001F)}))
+                        .size(4)
+                        .threads(1)
+                        .build();
+
+  Matrix<double> const x_double = data.x.cast<double>();
+  FeatureView const view(x_double.data(), x_double.rows(), x_double.cols());
+
+  auto const expected = Forest::train(spec, data.x, data.y);
+  auto const actual   = Forest::train(spec, view, data.y);
+
+  ASSERT_EQ(*expected, *actual);
+}
+
+TEST(FeatureView, SingleTreeReadsMatrixInPlace) {
+  RNG rng(3);
+  auto data = simulate_regression(60, 3, rng);
+
+  std::vector<int> order(static_cast<std::size_t>(data.y.size()));
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return data.y(a) < data.y(b); });
+
+  FeatureMatrix const x = data.x(order, Eigen::all);
+  OutcomeVector y_view  = data.y(order);
+  OutcomeVector y_moved = y_view;
+  FeatureMatrix x_moved = x;
+
+  auto const spec = TrainingSpec::builder(Mode::Regression)
+                        .grouping(grouping::by_cutpoint())
+                        .leaf(leaf::mean_response())
+                        .stop(stop::min_size(5))
+                        .build();
+
+  // The tree permutes a row map instead of the caller's rows.
+  auto const actual   = Model::train(spec, FeatureView(x), y_view);
+  auto const expected = Tree::train(spec, x_moved, y_moved);
+
+  ASSERT_EQ(FeatureMatrix(data.x(order, Eigen::all)), x);
+  ASSERT_EQ(*expected, dynamic_cast<Tree const&>(*actual));
+}
@@ -0,0 +1,336 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <set>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/** @brief Sorted-vector containers for small key sets. */
+namespace ppforest2::utils {
+  /**
+   * @brief Ordered set backed by a sorted, duplicate-free `std::vector`.
+   *
+   * Iterates in ascending order like `std::set`, but keeps its elements in
+   * one contiguous allocation: copying is a single `memcpy`-sized copy and
+   * lookups are a binary search over cache-resident data. Insertion is
+   * linear, so it is meant for the handful-to-dozens of labels a node
+   * carries, typically built once in ascending order (which appends).
+   *
+   * Converts implicitly from `std::set` so existing call sites and
+   * comparisons keep working. @p Allocator places the storage (see
+   * `ScratchAllocator`).
+   */
+  template<typename T, typename Allocator = std::allocator<T>> class FlatSet {
+  public:
+    using value_type     = T;
+    using size_type      = std::size_t;
+    using const_iterator = typename std::vector<T, Allocator>::const_iterator;
+    using iterator       = const_iterator;
+
+    FlatSet() = default;
+
+    FlatSet(std::initializer_list<T> values)
+        : FlatSet(values.begin(), values.end()) {}
+
+    template<typename It>
+    FlatSet(It first, It last)
+        : items(first, last) {
+      std::sort(items.begin(), items.end());
+      items.erase(std::unique(items.begin(), items.end()), items.end());
+    }
+
+    FlatSet(std::set<T> const& values)
+        : items(values.begin(), values.end()) {}
+
+    const_iterator begin() const { return items.begin(); }
+    const_iterator end() const { return items.end(); }
+
+    size_type size() const { return items.size(); }
+    bool empty() const { return items.empty(); }
+
+    void reserve(size_type n) { items.reserve(n); }
+
+    const_iterator find(T const& value) const {
+      auto const it = std::lower_bound(items.begin(), items.end(), value);
+      return it != items.end() && *it == value ? it : items.end();
+    }
+
+    size_type count(T const& value) const { return find(value) != items.end() ? 1 : 0; }
+
+    /** @brief Insert @p value if absent. Appending the largest element is O(1). */
+    std::pair<const_iterator, bool> insert(T const& value) {
+      if (items.empty() || items.back() < value) {
+        items.push_back(value);
+        return {std::prev(items.end()), true};
+      }
+
+      auto const it = std::lower_bound(items.begin(), items.end(), value);
+
+      if (*it == value) {
+        return {it, false};
+      }
+
+      return {items.insert(it, value), true};
+    }
+
+    /** @brief Hinted insert (hint ignored), so `std::inserter` works. */
+    const_iterator insert(const_iterator /*hint*/, T const& value) { return insert(value).first; }
+
+    friend bool operator==(FlatSet const& a, FlatSet const& b) { return a.items == b.items; }
+    friend bool operator!=(FlatSet const& a, FlatSet const& b) { return !(a == b); }
+
+  private:
+    std::vector<T, Allocator> items;
+  };
+
+  /**
+   * @brief Ordered map backed by a `std::vector` of pairs sorted by key.
+   *
+   * Same trade-off as `FlatSet`: contiguous storage, binary-search lookup,
+   * linear insertion (O(1) when keys arrive in ascending order). Iteration
+   * yields `std::pair<K, V>` in key order, so structured bindings work as
+   * with `std::map`. Keys must not be modified through iterators.
+   */
+  template<typename K, typename V, typename Allocator = std::allocator<std::pair<K, V>>> class FlatMap {
+  public:
+    using key_type       = K;
+    using mapped_type    = V;
+    using value_type     = std::pair<K, V>;
+    using size_type      = std::size_t;
+    using iterator       = typename std::vector<value_type, Allocator>::iterator;
+    using const_iterator = typename std::vector<value_type, Allocator>::const_iterator;
+
+    FlatMap() = default;
+
+    /** @brief Build from key/value pairs; on duplicate keys the first one wins, as with `std::map`. */
+    FlatMap(std::initializer_list<value_type> entries)
+        : items(entries.begin(), entries.end()) {
+      std::stable_sort(items.begin(), items.end(), by_key);
+      items.erase(
+          std::unique(
+              items.begin(), items.end(), [](value_type const& a, value_type const& b) { return a.first == b.first; }
+          ),
+          items.end()
+      );
+    }
+
+    FlatMap(std::map<K, V> const& entries)
+        : items(entries.begin(), entries.end()) {}
+
+    iterator begin() { return items.begin(); }
+    iterator end() { return items.end(); }
+    const_iterator begin() const { return items.begin(); }
+    const_iterator end() const { return items.end(); }
+
+    size_type size() const { return items.size(); }
+    bool empty() const { return items.empty(); }
+
+    void reserve(size_type n) { items.reserve(n); }
+
+    const_iterator find(K const& key) const {
+      auto const it = lower_bound(key);
+      return it != items.end() && it->first == key ? it : items.end();
+    }
+
+    size_type count(K const& key) const { return find(key) != items.end() ? 1 : 0; }
+
+    /** @brief Value for @p key; throws `std::out_of_range` if absent, like `std::map::at`. */
+    V const& at(K const& key) const {
+      auto const it = find(key);
+
+      if (it == items.end()) {
+        throw std::out_of_range("FlatMap::at: key not found");
+      }
+
+      return it->second;
+    }
+
+    /** @brief Value for @p key, value-initialized on first access. */
+    V& operator[](K const& key) {
+      if (items.empty() || items.back().first < key) {
+        items.emplace_back(key, V());
+        return items.back().second;
+      }
+
+      auto it = std::lower_bound(items.begin(), items.end(), key, key_less);
+
+      if (it->first != key) {
+        it = items.insert(it, value_type(key, V()));
+      }
+
+      return it->second;
+    }
+
+    friend bool operator==(FlatMap const& a, FlatMap const& b) { return a.items == b.items; }
+    friend bool operator!=(FlatMap const& a, FlatMap const& b) { return !(a == b); }
+
+  private:
+    std::vector<value_type, Allocator> items;
+
+    static bool by_key(value_type const& a, value_type const& b) { return a.first < b.first; }
+    static bool key_less(value_type const& a, K const& key) { return a.first < key; }
+
+    const_iterator lower_bound(K const& key) const {
+      return std::lower_bound(items.begin(), items.end(), key, key_less);
+    }
+  };
+
+  /**
+   * @brief Ordered map from keys to sorted value sets, held in two arrays.
+   *
+   * Where `FlatMap<K, FlatSet<V>>` allocates one vector per key, this keeps
+   * every key's values back to back in a single `values` array and records,
+   * per key, where its run ends. Copying it is two allocations whatever the
+   * number of keys. `at` and iteration yield a `ValueSet` view of a key's
+   * run, in ascending order.
+   */
+  template<typename K, typename V, typename Allocator = std::allocator<V>> class FlatSetMap {
+    template<typename T> using Vector = std::vector<T, typename std::allocator_traits<Allocator>::template rebind_alloc<T>>;
+
+  public:
+    /** @brief Read-only view of one key's values (ascending, duplicate-free). */
+    class ValueSet {
+    public:
+      using value_type     = V;
+      using size_type      = std::size_t;
+      using const_iterator = V const*;
+      using iterator       = const_iterator;
+
+      ValueSet(V const* first, V const* last)
+          : first(first)
+          , last(last) {}
+
+      const_iterator begin() const { return first; }
+      const_iterator end() const { return last; }
+
+      size_type size() const { return static_cast<size_type>(last - first); }
+      bool empty() const { return first == last; }
+
+      size_type count(V const& value) const { return std::binary_search(first, last, value) ? 1 : 0; }
+
+      friend bool operator==(ValueSet const& a, ValueSet const& b) {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end());
+      }
+
+      friend bool operator!=(ValueSet const& a, ValueSet const& b) { return !(a == b); }
+
+      /** @brief Element-wise comparison with any ordered range, e.g. a `std::set`. */
+      template<typename Range> friend bool operator==(ValueSet const& a, Range const& b) {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end());
+      }
+
+      template<typename Range> friend bool operator==(Range const& a, ValueSet const& b) { return b == a; }
+      template<typename Range> friend bool operator!=(ValueSet const& a, Range const& b) { return !(a == b); }
+      template<typename Range> friend bool operator!=(Range const& a, ValueSet const& b) { return !(b == a); }
+
+    private:
+      V const* first;
+      V const* last;
+    };
+
+    using key_type   = K;
+    using value_type = std::pair<K, ValueSet>;
+    using size_type  = std::size_t;
+
+    /** @brief Yields `std::pair<K, ValueSet>` by value, so structured bindings work as with `std::map`. */
+    class const_iterator {
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type        = FlatSetMap::value_type;
+      using difference_type   = std::ptrdiff_t;
+      using pointer           = void;
+      using reference         = value_type;
+
+      const_iterator(FlatSetMap const* map, std::size_t index)
+          : map(map)
+          , index(index) {}
+
+      value_type operator*() const { return {map->ends[index].first, map->run(index)}; }
+
+      const_iterator& operator++() {
+        ++index;
+        return *this;
+      }
+
+      const_iterator operator++(int) {
+        const_iterator const before = *this;
+        ++index;
+        return before;
+      }
+
+      friend bool operator==(const_iterator const& a, const_iterator const& b) { return a.index == b.index; }
+      friend bool operator!=(const_iterator const& a, const_iterator const& b) { return !(a == b); }
+
+    private:
+      FlatSetMap const* map;
+      std::size_t index;
+    };
+
+    using iterator = const_iterator;
+
+    FlatSetMap() = default;
+
+    /** @brief Build from `(key, value)` pairs in any order; duplicate pairs are kept once. */
+    explicit FlatSetMap(Vector<std::pair<K, V>> pairs) {
+      std::sort(pairs.begin(), pairs.end());
+      pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+      values.reserve(pairs.size());
+
+      for (auto const& [key, value] : pairs) {
+        if (ends.empty() || ends.back().first != key) {
+          ends.emplace_back(key, values.size());
+        }
+
+        values.push_back(value);
+        ends.back().second = values.size();
+      }
+    }
+
+    const_iterator begin() const { return {this, 0}; }
+    const_iterator end() const { return {this, ends.size()}; }
+
+    size_type size() const { return ends.size(); }
+    bool empty() const { return ends.empty(); }
+
+    size_type count(K const& key) const { return position(key) != ends.size() ? 1 : 0; }
+
+    /** @brief Values of @p key; throws `std::out_of_range` if absent, like `std::map::at`. */
+    ValueSet at(K const& key) const {
+      std::size_t const i = position(key);
+
+      if (i == ends.size()) {
+        throw std::out_of_range("FlatSetMap::at: key not found");
+      }
+
+      return run(i);
+    }
+
+    friend bool operator==(FlatSetMap const& a, FlatSetMap const& b) { return a.ends == b.ends && a.values == b.values; }
+    friend bool operator!=(FlatSetMap const& a, FlatSetMap const& b) { return !(a == b); }
+
+  private:
+    /** @brief Each key with the end of its run in `values`, by key. */
+    Vector<std::pair<K, std::size_t>> ends;
+    Vector<V> values;
+
+    std::size_t position(K const& key) const {
+      auto const it = std::lower_bound(ends.begin(), ends.end(), key, [](auto const& entry, K const& k) {
+        return entry.first < k;
+      });
+
+      return it != ends.end() && it->first == key ? static_cast<std::size_t>(it - ends.begin()) : ends.size();
+    }
+
+    ValueSet run(std::size_t i) const {
+      std::size_t const start = i == 0 ? 0 : ends[i - 1].second;
+      return {values.data() + start, values.data() + ends[i].second};
+    }
+  };
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include "utils/Flat.hpp"
+
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+using namespace ppforest2::utils;
+
+TEST(FlatSet, SortsAndDeduplicates) {
+  FlatSet<int> const set = {3, 1, 2, 3, 1};
+
+  ASSERT_EQ((std::vector<int>{1, 2, 3}), std::vector<int>(set.begin(), set.end()));
+  ASSERT_EQ(3U, set.size());
+}
+
+TEST(FlatSet, InsertKeepsOrder) {
+  FlatSet<int> set;
+
+  ASSERT_TRUE(set.insert(2).second);
+  ASSERT_TRUE(set.insert(5).second);
+  ASSERT_TRUE(set.insert(0).second);
+  ASSERT_FALSE(set.insert(2).second);
+
+  ASSERT_EQ((std::vector<int>{0, 2, 5}), std::vector<int>(set.begin(), set.end()));
+  ASSERT_EQ(1U, set.count(5));
+  ASSERT_EQ(0U, set.count(3));
+}
+
+TEST(FlatSet, EqualsStdSet) {
+  FlatSet<int> const set = {1, 3};
+
+  ASSERT_EQ(set, (std::set<int>{1, 3}));
+  ASSERT_NE(set, (std::set<int>{1, 2}));
+}
+
+TEST(FlatMap, SubscriptInsertsInKeyOrder) {
+  FlatMap<int, int> map;
+
+  map[4] = 40;
+  map[1] = 10;
+  map[2] = 20;
+  map[4] += 1;
+
+  std::vector<int> keys;
+  for (auto const& [key, value] : map) {
+    keys.push_back(key);
+  }
+
+  ASSERT_EQ((std::vector<int>{1, 2, 4}), keys);
+  ASSERT_EQ(41, map.at(4));
+  ASSERT_EQ(10, map.at(1));
+}
+
+TEST(FlatMap, InitializerListFirstDuplicateWins) {
+  FlatMap<int, int> const map = {{2, 1}, {0, 5}, {2, 7}};
+
+  ASSERT_EQ(2U, map.size());
+  ASSERT_EQ(1, map.at(2));
+  ASSERT_EQ(map, (std::map<int, int>{{0, 5}, {2, 1}}));
+}
+
+TEST(FlatMap, AtThrowsOnMissingKey) {
+  FlatMap<int, int> const map = {{0, 1}};
+
+  ASSERT_THROW(map.at(1), std::out_of_range);
+}
+
+TEST(FlatSetMap, GroupsValuesByKey) {
+  FlatSetMap<int, int> const map({{1, 4}, {0, 2}, {1, 3}, {0, 2}, {5, 0}});
+
+  std::vector<int> keys;
+  std::vector<std::vector<int>> runs;
+  for (auto const& [key, values] : map) {
+    keys.push_back(key);
+    runs.emplace_back(values.begin(), values.end());
+  }
+
+  ASSERT_EQ((std::vector<int>{0, 1, 5}), keys);
+  ASSERT_EQ((std::vector<std::vector<int>>{{2}, {3, 4}, {0}}), runs);
+  ASSERT_EQ(map.at(1), (std::set<int>{3, 4}));
+  ASSERT_EQ(1U, map.at(1).count(4));
+  ASSERT_EQ(0U, map.count(2));
+}
+
+TEST(FlatSetMap, EqualityComparesRuns) {
+  FlatSetMap<int, int> const a({{0, 1}, {0, 2}, {1, 3}});
+  FlatSetMap<int, int> const b({{1, 3}, {0, 2}, {0, 1}});
+  FlatSetMap<int, int> const c({{0, 1}, {1, 2}, {1, 3}});
+
+  ASSERT_EQ(a, b);
+  ASSERT_NE(a, c);
+}
+
+TEST(FlatSetMap, AtThrowsOnMissingKey) {
+  FlatSetMap<int, int> const map({{0, 1}});
+
+  ASSERT_THROW(map.at(1), std::out_of_range);
+}
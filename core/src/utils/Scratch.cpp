@@ -0,0 +1,84 @@
+#include "utils/Scratch.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace ppforest2::utils {
+  namespace {
+    thread_local ScratchArena* active_scratch = nullptr;
+  }
+
+  void* ScratchArena::allocate(std::size_t bytes, std::size_t alignment) {
+    auto const address    = reinterpret_cast<std::uintptr_t>(cursor);
+    std::size_t const pad = (alignment - address % alignment) % alignment;
+
+    if (cursor == nullptr || pad + bytes > remaining) {
+      std::size_t const needed = bytes + alignment;
+
+      // Reuse the next free chunk that is large enough; chunks too small
+      // for this request stay free for later ones. Otherwise add a chunk
+      // (oversized requests get a dedicated one).
+      std::size_t next = cursor == nullptr ? active : active + 1;
+
+      while (next < chunks.size() && chunks[next].size < needed) {
+        ++next;
+      }
+
+      if (next == chunks.size()) {
+        std::size_t const size = std::max(chunk_bytes, needed);
+        chunks.push_back({std::unique_ptr<std::byte[]>(new std::byte[size]), size});
+      } else if (next != active + 1 && cursor != nullptr) {
+        // Keep the free chunks contiguous after the active one.
+        std::swap(chunks[active + 1], chunks[next]);
+        next = active + 1;
+      }
+
+      active    = next;
+      cursor    = chunks[active].data.get();
+      remaining = chunks[active].size;
+
+      return allocate(bytes, alignment);
+    }
+
+    std::byte* const result = cursor + pad;
+
+    cursor = result + bytes;
+    remaining -= pad + bytes;
+    in_use += bytes;
+
+    return result;
+  }
+
+  void ScratchArena::reset() {
+    active    = 0;
+    cursor    = nullptr;
+    remaining = 0;
+    in_use    = 0;
+  }
+
+  std::size_t ScratchArena::capacity() const {
+    std::size_t total = 0;
+
+    for (Chunk const& chunk : chunks) {
+      total += chunk.size;
+    }
+
+    return total;
+  }
+
+  ScratchArena* ScratchArena::current() {
+    return active_scratch;
+  }
+
+  ScratchArena::Scope::Scope(ScratchArena& arena)
+      : Scope(&arena) {}
+
+  ScratchArena::Scope::Scope(ScratchArena* arena)
+      : previous(active_scratch) {
+    active_scratch = arena;
+  }
+
+  ScratchArena::Scope::~Scope() {
+    active_scratch = previous;
+  }
+}
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+#include <Eigen/Dense>
+
+namespace ppforest2::utils {
+  /**
+   * @brief Bump region for short-lived training scratch, released all at once.
+   *
+   * Growing a tree allocates the same kinds of buffers at every node: row
+   * index lists, the node's reduced matrix, the partitions it hands to
+   * its children. With a region open (`Scope`), containers that use
+   * `ScratchAllocator` carve that storage out of a few large chunks;
+   * freeing is a no-op, and `reset` rewinds the whole region for the next
+   * node while keeping its chunks, so a tree's growth settles into a fixed
+   * working set instead of a `malloc` / `free` pair per buffer.
+   *
+   * Regions are thread-confined, like `NodeArena`. Whoever opens a scope
+   * must make sure nothing allocated in it is used after `reset` or after
+   * the region is destroyed.
+   */
+  class ScratchArena {
+  public:
+    /** @brief Bytes per chunk. */
+    static constexpr std::size_t chunk_bytes = 64 * 1024;
+
+    ScratchArena() = default;
+
+    ScratchArena(ScratchArena const&)            = delete;
+    ScratchArena& operator=(ScratchArena const&) = delete;
+
+    /**
+     * @brief Reserve @p bytes aligned to @p alignment.
+     *
+     * Requests larger than a chunk get a chunk of their own.
+     */
+    void* allocate(std::size_t bytes, std::size_t alignment);
+
+    /** @brief Release everything allocated so far, keeping the chunks for reuse. */
+    void reset();
+
+    /** @brief Bytes handed out since the last `reset` (excluding alignment padding). */
+    std::size_t bytes_in_use() const { return in_use; }
+
+    /** @brief Total size of the chunks the region holds. */
+    std::size_t capacity() const;
+
+    /** @brief Region the calling thread's scratch containers allocate from, or null. */
+    static ScratchArena* current();
+
+    /**
+     * @brief Route scratch allocations on this thread to a region.
+     *
+     * Scopes nest: destruction restores the previously active region.
+     */
+    class Scope {
+    public:
+      explicit Scope(ScratchArena& arena);
+      /** @brief Route to @p arena, or to the heap when null (hiding any enclosing scope). */
+      explicit Scope(ScratchArena* arena);
+      ~Scope();
+
+      Scope(Scope const&)            = delete;
+      Scope& operator=(Scope const&) = delete;
+
+    private:
+      ScratchArena* previous;
+    };
+
+  private:
+    struct Chunk {
+      std::unique_ptr<std::byte[]> data;
+      std::size_t size;
+    };
+
+    std::vector<Chunk> chunks;
+    /** @brief Chunk the cursor is in; the ones after it are free. */
+    std::size_t active   = 0;
+    std::byte* cursor     = nullptr;
+    std::size_t remaining = 0;
+    std::size_t in_use    = 0;
+  };
+
+  /**
+   * @brief Standard allocator over the region open when the container was created.
+   *
+   * Captures `ScratchArena::current()` at construction and allocates from
+   * it, or from the heap when no region was open. A container copy takes
+   * the region open where the copy is made, not the source's, so copying
+   * a partition out of a node's region into a longer-lived one (a child
+   * step) is how it survives the node's `reset`. Moves keep the source's
+   * region.
+   */
+  template<typename T> class ScratchAllocator {
+  public:
+    using value_type                             = T;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+    using is_always_equal                        = std::false_type;
+
+    ScratchAllocator() noexcept
+        : arena(ScratchArena::current()) {}
+
+    template<typename U>
+    ScratchAllocator(ScratchAllocator<U> const& other) noexcept // NOLINT(google-explicit-constructor)
+        : arena(other.arena) {}
+
+    T* allocate(std::size_t n) {
+      if (arena != nullptr) {
+        return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+      }
+
+      return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* items, std::size_t n) noexcept {
+      if (arena == nullptr) {
+        std::allocator<T>().deallocate(items, n);
+      }
+    }
+
+    ScratchAllocator select_on_container_copy_construction() const { return ScratchAllocator(); }
+
+    template<typename U> friend bool operator==(ScratchAllocator const& a, ScratchAllocator<U> const& b) {
+      return a.arena == b.arena;
+    }
+
+    template<typename U> friend bool operator!=(ScratchAllocator const& a, ScratchAllocator<U> const& b) {
+      return !(a == b);
+    }
+
+  private:
+    template<typename U> friend class ScratchAllocator;
+
+    ScratchArena* arena;
+  };
+
+  /** @brief `std::vector` whose storage comes from the current scratch region. */
+  template<typename T> using ScratchVector = std::vector<T, ScratchAllocator<T>>;
+
+  /**
+   * @brief Dense matrix whose storage comes from the current scratch region.
+   *
+   * For the working sets a node rebuilds every time (its rows over the
+   * selected columns, their projection). The storage is aligned as an
+   * Eigen matrix's is, so computations over `matrix()` take the same
+   * vectorized paths. Outside a region it owns an ordinary heap matrix.
+   */
+  template<typename Scalar> class ScratchMatrix {
+  public:
+    using Matrix = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+    using View   = Eigen::Map<Matrix, Eigen::AlignedMax>;
+
+    /** @brief Evaluate @p values into scratch storage. */
+    template<typename Derived>
+    explicit ScratchMatrix(Eigen::DenseBase<Derived> const& values)
+        : view(allocate(values.rows(), values.cols()), values.rows(), values.cols()) {
+      view.noalias() = values.derived();
+    }
+
+    ScratchMatrix(ScratchMatrix const&)            = delete;
+    ScratchMatrix& operator=(ScratchMatrix const&) = delete;
+
+    View& matrix() { return view; }
+    View const& matrix() const { return view; }
+
+  private:
+    /** @brief Backing storage when no region was open. */
+    Matrix heap;
+    View view;
+
+    Scalar* allocate(Eigen::Index rows, Eigen::Index cols) {
+      if (ScratchArena* const arena = ScratchArena::current()) {
+        std::size_t const alignment = EIGEN_MAX_ALIGN_BYTES > alignof(Scalar) ? EIGEN_MAX_ALIGN_BYTES : alignof(Scalar);
+        return static_cast<Scalar*>(arena->allocate(static_cast<std::size_t>(rows * cols) * sizeof(Scalar), alignment));
+      }
+
+      heap.resize(rows, cols);
+      return heap.data();
+    }
+  };
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include "utils/Scratch.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using namespace ppforest2::utils;
+
+TEST(ScratchArena, AllocationsAreAligned) {
+  ScratchArena arena;
+
+  for (std::size_t alignment : {1U, 8U, 16U, 64U}) {
+    void* const ptr = arena.allocate(3, alignment);
+    ASSERT_EQ(0U, reinterpret_cast<std::uintptr_t>(ptr) % alignment) << "alignment " << alignment;
+  }
+
+  ASSERT_EQ(12U, arena.bytes_in_use());
+}
+
+TEST(ScratchArena, ResetReusesChunks) {
+  ScratchArena arena;
+
+  void* const first = arena.allocate(64, 16);
+  arena.allocate(ScratchArena::chunk_bytes * 2, 16);
+  std::size_t const capacity = arena.capacity();
+
+  arena.reset();
+
+  ASSERT_EQ(0U, arena.bytes_in_use());
+  ASSERT_EQ(first, arena.allocate(64, 16));
+  arena.allocate(ScratchArena::chunk_bytes * 2, 16);
+  ASSERT_EQ(capacity, arena.capacity());
+}
+
+TEST(ScratchArena, ScopeRoutesScratchVectors) {
+  ScratchArena arena;
+
+  ASSERT_EQ(nullptr, ScratchArena::current());
+
+  {
+    ScratchArena::Scope const scope(arena);
+    ASSERT_EQ(&arena, ScratchArena::current());
+
+    ScratchVector<int> values(100, 7);
+    ASSERT_GE(arena.bytes_in_use(), 100 * sizeof(int));
+  }
+
+  ASSERT_EQ(nullptr, ScratchArena::current());
+}
+
+TEST(ScratchArena, CopiesAllocateInTheCopyingScope) {
+  ScratchArena node;
+  ScratchArena outer;
+
+  ScratchArena::Scope const outer_scope(outer);
+  std::size_t const before = outer.bytes_in_use();
+
+  ScratchVector<int> copy;
+
+  {
+    ScratchArena::Scope const node_scope(node);
+    ScratchVector<int> const values = {1, 2, 3};
+    ASSERT_EQ(3 * sizeof(int), node.bytes_in_use());
+
+    {
+      ScratchArena::Scope const back(outer);
+      copy = ScratchVector<int>(values);
+    }
+  }
+
+  node.reset();
+
+  ASSERT_EQ((std::vector<int>{1, 2, 3}), std::vector<int>(copy.begin(), copy.end()));
+  ASSERT_EQ(before + 3 * sizeof(int), outer.bytes_in_use());
+}
+
+TEST(ScratchArena, HeapOutsideScope) {
+  ScratchVector<int> values(10, 1);
+  values.push_back(2);
+
+  ASSERT_EQ(11U, values.size());
+  ASSERT_EQ(ScratchAllocator<int>(), values.get_allocator());
+}
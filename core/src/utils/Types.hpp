@@ -40,6 +40,9 @@ namespace ppforest2::types {
   /** @brief Dynamic-size column vector of predictions. */
   using OutcomeVector = Eigen::Matrix<Outcome, Eigen::Dynamic, 1>;
 
+  /** @brief Dynamic-size column vector of per-row multiplicities (count-weighted bootstrap). */
+  using WeightVector = Eigen::Matrix<int, Eigen::Dynamic, 1>;
+
   /** @brief Generic dynamic-size matrix. */
   template<typename T> using Matrix = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>;
 